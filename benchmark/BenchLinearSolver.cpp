@@ -0,0 +1,153 @@
+/**
+ * @file BenchLinearSolver.cpp
+ * @brief Benchmark of the linear problem backends of the weight update.
+ *
+ * Solves the linear problems of the weight update of random models on the test
+ * datasets and on synthetic datasets, with the OR-Tools GLOP solver and with
+ * the in-house SimplexSolver, and prints the mean resolution time of each
+ * backend and the largest gap between the objective values they reach. The
+ * approximate SubgradientSolver is timed too, with its largest relative excess
+ * over the optimal objective.
+ *
+ * It also compares, on the full (not reduced) problem, the resolution time of
+ * GLOP with the equality rows of LinearSolver and with the former encoding of
+ * each equation as a pair of inequality rows.
+ *
+ * The build profile (build type, ARCH, LTO, PGO and PROFILING options) is
+ * printed first, so that the results of several build directories can be
+ * compared.
+ *
+ * Usage, from the build directory: ./BenchLP [n_models]
+ */
+
+#include "ortools/linear_solver/linear_solver.h"
+#include "spdlog/sinks/basic_file_sink.h"
+#include "spdlog/spdlog.h"
+
+#include "../include/config.h"
+#include "../include/learning/LinearSolver.h"
+#include "../include/learning/ProfileInitializer.h"
+#include "../include/learning/SimplexSolver.h"
+#include "../include/learning/SubgradientSolver.h"
+#include "../include/learning/WeightUpdater.h"
+#include "../include/types/AlternativesPerformance.h"
+#include "../include/types/DataGenerator.h"
+#include "../include/types/MRSortModel.h"
+#include "PairedRowsSolver.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+void benchDataset(Config &conf, std::string name, AlternativesPerformance &ap,
+                  int n_models) {
+  using clock = std::chrono::steady_clock;
+  using ms = std::chrono::duration<double, std::milli>;
+  int n_cat = ap.getNumberCats();
+  int n_crit = ap.getNumberCrit();
+  ProfileInitializer profileInitializer = ProfileInitializer(conf, ap);
+  WeightUpdater weightUpdater = WeightUpdater(ap, conf);
+  LinearSolver glop = LinearSolver(ap, conf, 0.000001, "GLOP");
+  SimplexSolver simplex = SimplexSolver(ap, conf);
+  SubgradientSolver subgradient = SubgradientSolver(ap, conf);
+  Config full_conf = conf;
+  full_conf.reduce_lp = false;
+  LinearSolver glop_full = LinearSolver(ap, full_conf, 0.000001, "GLOP");
+
+  double glop_time = 0, simplex_time = 0, max_gap = 0;
+  double subgradient_time = 0, max_excess = 0;
+  double full_time = 0, paired_time = 0;
+  for (int k = 0; k < n_models; k++) {
+    MRSortModel model = MRSortModel(n_cat, n_crit);
+    model.criteria.generateRandomCriteriaWeights();
+    profileInitializer.initializeProfiles(model);
+    model.profiles.changeMode("alt");
+    auto x_matrix = weightUpdater.computeXMatrix(model);
+    auto y_matrix = weightUpdater.computeYMatrix(model);
+
+    const auto start = clock::now();
+    glop.solve(x_matrix, y_matrix);
+    const auto glop_end = clock::now();
+    simplex.solve(x_matrix, y_matrix);
+    const auto simplex_end = clock::now();
+
+    glop_time += ms(glop_end - start).count();
+    simplex_time += ms(simplex_end - glop_end).count();
+    max_gap = std::max(max_gap, std::abs(glop.getSolver()->Objective().Value() -
+                                         simplex.getObjectiveValue()));
+
+    const auto subgradient_start = clock::now();
+    subgradient.solve(x_matrix, y_matrix);
+    subgradient_time += ms(clock::now() - subgradient_start).count();
+    max_excess = std::max(max_excess, (subgradient.getObjectiveValue() -
+                                       simplex.getObjectiveValue()) /
+                                          std::max(simplex.getObjectiveValue(),
+                                                   1.));
+
+    const auto full_start = clock::now();
+    glop_full.solve(x_matrix, y_matrix);
+    const auto full_end = clock::now();
+    PairedRowsSolution paired = solvePairedRows(
+        x_matrix, y_matrix, n_crit, ap.getNumberAlt(), 0.000001);
+    const auto paired_end = clock::now();
+
+    full_time += ms(full_end - full_start).count();
+    paired_time += ms(paired_end - full_end).count();
+    max_gap = std::max(max_gap,
+                       std::abs(glop_full.getSolver()->Objective().Value() -
+                                paired.objective));
+  }
+  std::cout << std::left << std::setw(24) << name << std::right << std::setw(8)
+            << ap.getNumberAlt() << std::setw(6) << n_crit << std::setw(12)
+            << glop_time / n_models << std::setw(12)
+            << simplex_time / n_models << std::setw(12) << max_gap
+            << std::setw(12) << full_time / n_models << std::setw(12)
+            << paired_time / n_models << std::setw(12)
+            << subgradient_time / n_models << std::setw(12) << max_excess
+            << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Config conf;
+  conf.logger = spdlog::basic_logger_mt("bench_logger",
+                                        "../logs/bench_logger.txt");
+  spdlog::set_level(spdlog::level::info);
+  int n_models = argc > 1 ? std::stoi(argv[1]) : 10;
+  DataGenerator dataGenerator = DataGenerator(conf);
+
+#ifdef BUILD_PROFILE
+  std::cout << "Build profile: " << BUILD_PROFILE << std::endl;
+#endif
+  std::cout << std::left << std::setw(24) << "dataset" << std::right
+            << std::setw(8) << "n_alt" << std::setw(6) << "n_crit"
+            << std::setw(12) << "GLOP ms" << std::setw(12) << "SIMPLEX ms"
+            << std::setw(12) << "obj gap" << std::setw(12) << "full ms"
+            << std::setw(12) << "paired ms" << std::setw(12) << "SUBGRAD ms"
+            << std::setw(12) << "excess" << std::endl;
+
+  std::vector<std::string> test_datasets = {"in1dataset.xml", "in3dataset.xml",
+                                            "in4dataset.xml", "in7dataset.xml"};
+  for (std::string &file : test_datasets) {
+    AlternativesPerformance ap = dataGenerator.loadDataset("tests/" + file);
+    benchDataset(conf, file, ap, n_models);
+  }
+
+  // synthetic datasets: (n_crit, n_alt), 3 categories
+  std::vector<std::pair<int, int>> sizes = {
+      {5, 1000}, {5, 10000}, {10, 10000}, {10, 100000}, {15, 10000}};
+  for (std::pair<int, int> &size : sizes) {
+    std::string file = "bench_crit" + std::to_string(size.first) + "_alt" +
+                       std::to_string(size.second) + ".xml";
+    dataGenerator.datasetGenerator(size.first, size.second, 3, file, 1, 0);
+    AlternativesPerformance ap = dataGenerator.loadDataset(file);
+    benchDataset(conf, file, ap, n_models);
+    std::remove((conf.data_dir + file).c_str());
+  }
+  return 0;
+}
@@ -0,0 +1,137 @@
+/**
+ * @file BenchProfileUpdater.cpp
+ * @brief Benchmark of the allocations of the profile update.
+ *
+ * Counts the heap allocations and times the calls of
+ * ProfileUpdater::updateProfiles on random models, on the test datasets and on
+ * synthetic datasets, with the temporaries allocated on the heap and with the
+ * ScratchArena the pipeline gives to each thread. The arena is warmed up by a
+ * first call, as it is over the iterations of the pipeline.
+ *
+ * The allocations are counted by replacing the global operator new.
+ *
+ * Usage, from the build directory: ./BenchProfileUpdate [n_models]
+ */
+
+#include "spdlog/sinks/basic_file_sink.h"
+#include "spdlog/spdlog.h"
+
+#include "../include/config.h"
+#include "../include/learning/ProfileInitializer.h"
+#include "../include/learning/ProfileUpdater.h"
+#include "../include/learning/ScratchArena.h"
+#include "../include/types/AlternativesPerformance.h"
+#include "../include/types/DataGenerator.h"
+#include "../include/types/MRSortModel.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+std::atomic<long> allocations(0);
+}
+
+void *operator new(std::size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete[](void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+void benchDataset(Config &conf, std::string name, AlternativesPerformance &ap,
+                  int n_models) {
+  using clock = std::chrono::steady_clock;
+  using ms = std::chrono::duration<double, std::milli>;
+  int n_cat = ap.getNumberCats();
+  int n_crit = ap.getNumberCrit();
+  ProfileInitializer profileInitializer = ProfileInitializer(conf, ap);
+  ProfileUpdater profileUpdater = ProfileUpdater(conf, ap);
+  ScratchArena arena = ScratchArena();
+
+  long heap_allocations = 0, arena_allocations = 0;
+  double heap_time = 0, arena_time = 0;
+  for (int k = 0; k < n_models; k++) {
+    MRSortModel model = MRSortModel(n_cat, n_crit);
+    model.criteria.generateRandomCriteriaWeights();
+    profileInitializer.initializeProfiles(model);
+    model.profiles.changeMode("alt");
+    // the same model is updated both ways
+    MRSortModel arena_model = model;
+    profileUpdater.updateProfiles(arena_model, arena);
+    arena_model = model;
+
+    long before = allocations.load();
+    const auto start = clock::now();
+    profileUpdater.updateProfiles(model);
+    const auto heap_end = clock::now();
+    long heap_end_count = allocations.load();
+    profileUpdater.updateProfiles(arena_model, arena);
+    const auto arena_end = clock::now();
+
+    heap_allocations += heap_end_count - before;
+    arena_allocations += allocations.load() - heap_end_count;
+    heap_time += ms(heap_end - start).count();
+    arena_time += ms(arena_end - heap_end).count();
+  }
+  std::cout << std::left << std::setw(24) << name << std::right << std::setw(8)
+            << ap.getNumberAlt() << std::setw(6) << n_crit << std::setw(14)
+            << heap_allocations / n_models << std::setw(14)
+            << arena_allocations / n_models << std::setw(12)
+            << heap_time / n_models << std::setw(12) << arena_time / n_models
+            << std::setw(12) << arena.getCapacity() / 1024 << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  Config conf;
+  conf.logger = spdlog::basic_logger_mt("bench_logger",
+                                        "../logs/bench_logger.txt");
+  spdlog::set_level(spdlog::level::info);
+  int n_models = argc > 1 ? std::stoi(argv[1]) : 10;
+  DataGenerator dataGenerator = DataGenerator(conf);
+
+#ifdef BUILD_PROFILE
+  std::cout << "Build profile: " << BUILD_PROFILE << std::endl;
+#endif
+  std::cout << std::left << std::setw(24) << "dataset" << std::right
+            << std::setw(8) << "n_alt" << std::setw(6) << "n_crit"
+            << std::setw(14) << "heap allocs" << std::setw(14)
+            << "arena allocs" << std::setw(12) << "heap ms" << std::setw(12)
+            << "arena ms" << std::setw(12) << "arena KiB" << std::endl;
+
+  std::vector<std::string> test_datasets = {"in1dataset.xml", "in3dataset.xml",
+                                            "in4dataset.xml", "in7dataset.xml"};
+  for (std::string &file : test_datasets) {
+    AlternativesPerformance ap = dataGenerator.loadDataset("tests/" + file);
+    benchDataset(conf, file, ap, n_models);
+  }
+
+  // synthetic datasets: (n_crit, n_alt), 3 categories
+  std::vector<std::pair<int, int>> sizes = {{5, 1000}, {10, 1000}, {5, 5000}};
+  for (std::pair<int, int> &size : sizes) {
+    std::string file = "bench_crit" + std::to_string(size.first) + "_alt" +
+                       std::to_string(size.second) + ".xml";
+    dataGenerator.datasetGenerator(size.first, size.second, 3, file, 1, 0);
+    AlternativesPerformance ap = dataGenerator.loadDataset(file);
+    benchDataset(conf, file, ap, n_models);
+    std::remove((conf.data_dir + file).c_str());
+  }
+  return 0;
+}
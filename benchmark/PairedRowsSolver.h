@@ -0,0 +1,111 @@
+#ifndef PAIREDROWSSOLVER_H
+#define PAIREDROWSSOLVER_H
+
+/**
+ * @file PairedRowsSolver.h
+ * @brief Former encoding of the full linear problem of the weight update.
+ *
+ * Shared by BenchLP and by TestLinearSolver, so that the reference checked by
+ * the tests is the one timed by the benchmark.
+ */
+
+#include "ortools/linear_solver/linear_solver.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/** @struct PairedRowsSolution PairedRowsSolver.h
+ *  @brief Result of solvePairedRows.
+ */
+struct PairedRowsSolution {
+  /** Status returned by GLOP */
+  operations_research::MPSolver::ResultStatus status;
+  /** Objective value */
+  double objective;
+  /** Value of lambda */
+  float lambda;
+  /** Value of the weights, one per criterion */
+  std::vector<float> weights;
+};
+
+/**
+ * solvePairedRows solves the full linear problem of the weight update with
+ * GLOP, each equation being encoded as a pair of opposite inequality rows as
+ * LinearSolver used to.
+ *
+ * @param x_matrix x matrix of the problem
+ * @param y_matrix y matrix of the problem
+ * @param n_crit number of criteria
+ * @param n_alt number of alternatives
+ * @param delta delta of the y rows
+ *
+ * @return status, objective value, lambda and weights
+ */
+inline PairedRowsSolution
+solvePairedRows(std::vector<std::vector<std::vector<bool>>> &x_matrix,
+                std::vector<std::vector<std::vector<bool>>> &y_matrix,
+                int n_crit, int n_alt, float delta) {
+  std::unique_ptr<operations_research::MPSolver> solver(
+      operations_research::MPSolver::CreateSolver("GLOP"));
+  const double infinity = solver->infinity();
+  std::vector<operations_research::MPVariable *> weights, dev, dev_p;
+  for (int i = 0; i < n_crit; i++) {
+    weights.push_back(solver->MakeNumVar(0., 1.0, "w" + std::to_string(i)));
+  }
+  for (int i = 0; i < 2 * n_alt; i++) {
+    dev.push_back(solver->MakeNumVar(0., infinity, "d" + std::to_string(i)));
+    dev_p.push_back(solver->MakeNumVar(0., infinity, "dp" + std::to_string(i)));
+    solver->MutableObjective()->SetCoefficient(dev_p[i], 1);
+  }
+  operations_research::MPVariable *lambda =
+      solver->MakeNumVar(0.5, 1.0, "lambda");
+
+  // rows: sum(w) - lambda - dev_sign * (d - dp) = rhs
+  auto addPair = [&](std::vector<bool> &row, double rhs, double dev_sign,
+                     operations_research::MPVariable *d,
+                     operations_research::MPVariable *dp, bool with_lambda) {
+    for (double sign : {1., -1.}) {
+      auto cst = solver->MakeRowConstraint(-infinity, sign * rhs);
+      for (int crit = 0; crit < row.size(); crit++) {
+        if (row[crit]) {
+          cst->SetCoefficient(weights[crit], sign);
+        }
+      }
+      if (with_lambda) {
+        cst->SetCoefficient(lambda, -sign);
+        cst->SetCoefficient(d, sign * dev_sign);
+        cst->SetCoefficient(dp, -sign * dev_sign);
+      }
+    }
+  };
+  std::vector<bool> all_weights(n_crit, true);
+  addPair(all_weights, 1, 0, nullptr, nullptr, false);
+  for (int h = 0; h < x_matrix.size(); h++) {
+    for (int alt = 0; alt < x_matrix[h].size(); alt++) {
+      if (!x_matrix[h][alt].empty()) {
+        addPair(x_matrix[h][alt], 0, -1, dev[alt], dev_p[alt], true);
+      }
+    }
+  }
+  for (int h = 0; h < y_matrix.size(); h++) {
+    for (int alt = 0; alt < y_matrix[h].size(); alt++) {
+      if (!y_matrix[h][alt].empty()) {
+        addPair(y_matrix[h][alt], -delta, 1, dev[n_alt + alt],
+                dev_p[n_alt + alt], true);
+      }
+    }
+  }
+  solver->MutableObjective()->SetMinimization();
+
+  PairedRowsSolution solution;
+  solution.status = solver->Solve();
+  solution.objective = solver->Objective().Value();
+  solution.lambda = lambda->solution_value();
+  for (auto w_i : weights) {
+    solution.weights.push_back(w_i->solution_value());
+  }
+  return solution;
+}
+
+#endif
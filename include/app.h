@@ -6,7 +6,13 @@
  * @brief app container responsible of handling everything related to fastpl.
  */
 
+#include <memory>
+
 #include "config.h"
+#include "learning/AssignmentKernel.h"
+#include "types/AlternativesPerformance.h"
+#include "types/ColumnarDataset.h"
+#include "types/MRSortModel.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/spdlog.h"
 #include "yaml-cpp/yaml.h"
@@ -45,6 +51,49 @@ public:
    */
   int run();
 
+  /** runBatch learn the datasets of the batch manifest, one model per job
+   *
+   * @return status_code, 1 if a job failed
+   */
+  int runBatch();
+
+  /** runServer answer the learn and predict requests of the clients of the
+   * server socket until one of them asks for a shutdown
+   *
+   * @return status_code
+   */
+  int runServer();
+
+  /** learn run the learning pipeline on the dataset, in island mode if more
+   * than one island is configured
+   *
+   * @param dataset dataset to learn from
+   * @param kernel assignment kernel of the dataset, built with
+   * conf.rank_encoding. Built by the pipeline if null
+   *
+   * @return best model learned
+   */
+  MRSortModel learn(AlternativesPerformance &dataset,
+                    std::shared_ptr<const AssignmentKernel> kernel = nullptr);
+
+  /** openColumnarDataset maps the columnar copy of the dataset
+   * (DATASET.columns) for the out-of-core mode, writing it first from the
+   * dataset if it does not exist
+   *
+   * @return columnar dataset
+   */
+  std::unique_ptr<ColumnarDataset> openColumnarDataset();
+
+  /** saveMetrics save the metrics of the run as JSON next to the model output
+   * (OUTPUT.metrics.json), if requested by the config
+   */
+  void saveMetrics();
+
+  /** saveTrace save the timeline of the run as a Chrome trace next to the
+   * model output (OUTPUT.trace.json), if requested by the config
+   */
+  void saveTrace();
+
   /** initializeLogger initialize the logger based on the yaml config and store
    * it into the app config
    *
@@ -52,6 +101,14 @@ public:
    */
   void initializeLogger(YAML::Node &yml_conf);
 
+  /** readParameters read the learning parameters present in a yaml node
+   * (config file or overrides of a batch job) into a config
+   *
+   * @param yml_conf
+   * @param config config to update
+   */
+  static void readParameters(YAML::Node &yml_conf, Config &config);
+
   /** extractConfig get the config from the yaml file and store it into the
    * config datastructure of the app
    *
@@ -0,0 +1,84 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+/**
+ * @file batch.h
+ * @brief Batch mode: learning of the datasets of a manifest in one process.
+ */
+
+#include "config.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class Batch batch.h
+ * @brief Learning of the datasets listed in a manifest, in one process.
+ *
+ * The manifest is a yaml file of data_dir listing the jobs of the batch: the
+ * dataset to learn, the output of the model and the parameters of the config
+ * overridden for this job, if any.
+ *
+ *     jobs:
+ *       - dataset: tests/in7dataset.xml
+ *         output: models/in7model.xml
+ *         overrides:
+ *           max_iterations: 50
+ *       - dataset: tests/in1dataset.xml
+ *         output: models/in1model.xml
+ *
+ * The jobs are learned by n_jobs threads sharing the logger and the config
+ * read once at startup. Each thread takes the next job not started yet, the
+ * largest datasets first so that a large one is not left alone at the end of
+ * the batch. A job is learned and saved as a single run with its config would
+ * be, with its own metrics and trace, saved next to its model.
+ */
+class Batch {
+public:
+  /** Job of the batch */
+  struct Job {
+    std::string dataset; /*!< Dataset file, in data_dir */
+    std::string output;  /*!< Model output file, in data_dir */
+    Config config;       /*!< Config of the job, overrides applied */
+    std::uintmax_t size; /*!< Estimated size of the job, the size of the
+                            dataset file in bytes */
+  };
+
+  /**
+   * Batch standard constructor, reads the manifest and orders its jobs
+   *
+   * @param config config of the app, each job starts from a copy of it
+   * @param manifest manifest file, in data_dir
+   */
+  Batch(Config &config, std::string manifest);
+
+  /**
+   * getJobs getter of the jobs, in the order they are started
+   *
+   * @return jobs
+   */
+  const std::vector<Job> &getJobs() const;
+
+  /**
+   * run learns the datasets of all the jobs and saves their model
+   *
+   * @return number of jobs that failed
+   */
+  int run();
+
+private:
+  /**
+   * runJob learns the dataset of a job and saves its model
+   *
+   * @param job job to run
+   *
+   * @return status_code of the job
+   */
+  int runJob(Job &job);
+
+  Config &conf;
+  std::vector<Job> jobs;
+};
+
+#endif
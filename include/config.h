@@ -9,6 +9,9 @@
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/spdlog.h"
 
+#include "metrics.h"
+#include "tracer.h"
+
 /**
  * @struct Config app.h
  * @brief High level configuration of the app.
@@ -20,13 +23,90 @@
 struct Config {
   std::shared_ptr<spdlog::logger>
       logger; /*!< Logger pointer when logging is requested. */
+  std::shared_ptr<Metrics> metrics =
+      std::make_shared<Metrics>(); /*!< Metrics of the run, shared by the
+                                      copies of the config */
+  std::shared_ptr<Tracer> tracer =
+      std::make_shared<Tracer>(); /*!< Timeline of the run, shared by the
+                                     copies of the config, enabled by trace */
   std::string data_dir = "../data/"; /*!< Directory where the data is stored */
   std::string log_file = "../logs/app_log.txt";
+  int log_queue_size = 0; /*!< Size of the queue of the asynchronous logger, 0
+                             for a synchronous logger */
   int model_batch_size = 50; /*!< Batch size of model for the learning algo */
   int max_iterations =
       100; /*!< Max iteration before terminating the learning algo */
   int n_profile_update =
       20; /*!< Number of iteration of profile update for one weight update */
+  float target_accuracy =
+      1; /*!< Best model accuracy at which the learning algo stops, 0 to
+            disable */
+  int max_stale_iterations = 0; /*!< Number of iteration without improvement of
+                                   the best score before terminating the
+                                   learning algo, 0 to disable */
+  float time_budget_seconds = 0; /*!< Wall-clock budget of the learning algo
+                                    in seconds, 0 to disable */
+  float min_diversity = 0; /*!< Diversity of the kept models under which the
+                              learning algo stops, 0 to disable */
+  float checkpoint_interval_seconds =
+      0; /*!< Interval between two saves of the best model in the output file
+            during the learning, 0 to disable */
+  bool rank_encoding = false; /*!< Replace the performances of the dataset by
+                                 their rank on each criterion to compute the
+                                 accuracy of the models */
+  bool reduce_lp = true; /*!< Merge the identical rows of the linear problem of
+                            the weight update */
+  std::string lp_solver = "GLOP"; /*!< Backend of the weight update linear
+                                     problem: "SIMPLEX", "SUBGRADIENT" or an
+                                     OR-Tools solver id */
+  std::string lp_dump = ""; /*!< File (in data_dir) the OR-Tools linear
+                               problems are exported to before being solved,
+                               MPS if it ends with .mps and LP otherwise. The
+                               variables and constraints are only named when
+                               set (OR-Tools generates its own names
+                               otherwise), empty to disable */
+  int subgradient_iterations = 1000; /*!< Number of steps of the SUBGRADIENT
+                                        backend of the weight update */
+  int lp_sample_size = 0; /*!< Number of alternatives sampled (stratified per
+                             category) in the linear problem of each weight
+                             update, the best model being polished on the
+                             whole dataset at the end, 0 to disable */
+  float lp_sample_focus = 0; /*!< Share of each sample made of the alternatives
+                                closest to the majority threshold (lowest
+                                absolute concordance margin), in [0, 1] */
+  int out_of_core_sample = 0; /*!< Number of alternatives sampled from the
+                                 columnar copy of the dataset, kept on disk,
+                                 to learn on. The model is then evaluated on
+                                 the whole dataset. 0 to load the dataset in
+                                 memory */
+  int n_threads = 1; /*!< Number of threads updating the models of a
+                        population in parallel */
+  int n_islands = 1; /*!< Number of populations learning in parallel, 1 to
+                        disable the island mode */
+  int migration_interval =
+      5; /*!< Number of iteration between two migrations in island mode */
+  int n_migrants = 2; /*!< Number of models sent to the next island at each
+                         migration */
+  std::string coordinator_socket =
+      "/tmp/fastpl-coordinator.sock"; /*!< Unix domain socket of the
+                                         coordinator in distributed mode */
+  int n_workers = 0; /*!< Number of worker processes the coordinator waits for,
+                        0 when not running as coordinator */
+  bool worker = false; /*!< Run as a worker of a distributed learning */
+  std::string batch = ""; /*!< Manifest (in data_dir) of the datasets to learn
+                             in batch mode, empty when learning a single
+                             dataset */
+  int n_jobs = 1; /*!< Number of datasets of the batch learned in parallel, or
+                     of clients answered in parallel in server mode */
+  bool server = false; /*!< Run as a learning server */
+  std::string server_socket =
+      "/tmp/fastpl-server.sock"; /*!< Unix domain socket of the learning
+                                    server */
+  bool save_metrics = true; /*!< Save the metrics of the run as JSON next to
+                               the model output (OUTPUT.metrics.json) */
+  bool trace = false; /*!< Record the timeline of the phases of each model and
+                         save it as a Chrome trace next to the model output
+                         (OUTPUT.trace.json) */
   std::string dataset = "";
   std::string output = "";
 };
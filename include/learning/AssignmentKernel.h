@@ -0,0 +1,137 @@
+#ifndef ASSIGNMENTKERNEL_H
+#define ASSIGNMENTKERNEL_H
+
+/**
+ * @file AssignmentKernel.h
+ * @brief Assignment of the alternatives of a dataset by a MRSort model.
+ *
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../types/AlternativesPerformance.h"
+#include "../types/MRSortModel.h"
+
+/** @class AssignmentKernel AssignmentKernel.h
+ *  @brief Assignment of the alternatives of a dataset by a MRSort model.
+ *
+ * The kernel holds the performances of the alternatives in a dense matrix
+ * (one row per alternative, in the order of the criteria of the dataset) with
+ * their expected category, so that the assignments of a model and its
+ * accuracy are computed without going through the strings of the
+ * performance tables. It gives the same assignments as
+ * MRSortModel::categoryAssignments.
+ *
+ * The loops are instantiated at compile time for the usual sizes, from
+ * min_crit to max_crit criteria and from min_cat to max_cat categories, so
+ * that they are unrolled and the profiles and weights are kept in registers.
+ * The other sizes run a generic loop.
+ *
+ * MRSort only compares the performances to the profiles, so the kernel can
+ * rank-encode the dataset: the performances on each criterion are replaced by
+ * their position among the distinct values of the criterion (its dictionary),
+ * on 16 bits when every criterion has less than 65535 distinct values and on
+ * 32 bits otherwise. The profiles of the model are encoded the same way before
+ * each assignment, the model itself keeping its float values. The assignments
+ * are unchanged, the matrix read by the loops being half as large.
+ *
+ * The constructor reads the dataset without copying it, unless it is in crit
+ * mode. The kernel is not changed afterwards, so that it can be shared by the
+ * pipelines learning on the same dataset (the islands, the requests of a
+ * LearningServer); it must be rebuilt if the dataset changes.
+ */
+class AssignmentKernel {
+public:
+  static constexpr int min_crit = 4;
+  static constexpr int max_crit = 16;
+  static constexpr int min_cat = 2;
+  static constexpr int max_cat = 5;
+
+  /**
+   * AssignmentKernel standard constructor.
+   *
+   * @param ap dataset to assign
+   * @param rank_encoding rank-encode the performances of the dataset
+   */
+  AssignmentKernel(const AlternativesPerformance &ap,
+                   bool rank_encoding = false);
+
+  ~AssignmentKernel();
+
+  /**
+   * isCompatible tells if the profiles of the model are defined on the
+   * criteria of the dataset, in the same order
+   *
+   * @param model model to check
+   *
+   * @return true if the kernel can assign the dataset with the model
+   */
+  bool isCompatible(MRSortModel &model) const;
+
+  /**
+   * isSpecialized tells if the kernel has a compiled version for these sizes
+   *
+   * @param n_crit number of criteria
+   * @param n_cat number of categories
+   *
+   * @return true if the sizes have a compiled version
+   */
+  static bool isSpecialized(int n_crit, int n_cat);
+
+  /**
+   * getCodeBits getter of the size of the codes of the performances
+   *
+   * @return 16 or 32 if the dataset is rank-encoded, 0 otherwise
+   */
+  int getCodeBits() const;
+
+  /**
+   * assign computes the category of each alternative with the model, the
+   * model must be compatible with the dataset
+   *
+   * @param model model assigning the alternatives
+   *
+   * @return ranks of the categories, in the order of the performance table
+   */
+  std::vector<int> assign(MRSortModel &model) const;
+
+  /**
+   * computeAccuracy computes the share of the alternatives assigned to their
+   * expected category by the model, the model must be compatible with the
+   * dataset
+   *
+   * @param model model to evaluate
+   *
+   * @return accuracy
+   */
+  float computeAccuracy(MRSortModel &model) const;
+
+private:
+  /**
+   * encodeProfiles gives the code of each profile value, such that an
+   * alternative is above a profile on a criterion if and only if its code is
+   * greater than the one of the profile
+   *
+   * @param profiles n_prof x n_crit values of the profiles, row major
+   *
+   * @return codes of the profiles
+   */
+  template <typename T>
+  std::vector<T> encodeProfiles(const std::vector<float> &profiles) const;
+
+  int n_alt;
+  int n_crit;
+  std::vector<std::string> crit_ids;
+  std::vector<int> expected_ranks;
+  // performances of the alternatives, n_alt x n_crit, row major. Only one of
+  // them is filled, depending on the encoding
+  std::vector<float> alternatives;
+  std::vector<std::uint16_t> alternatives_16;
+  std::vector<std::uint32_t> alternatives_32;
+  // sorted distinct values of each criterion, when rank-encoded
+  std::vector<std::vector<float>> dictionaries;
+};
+
+#endif
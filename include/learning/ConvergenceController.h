@@ -0,0 +1,111 @@
+#ifndef CONVERGENCECONTROLLER_H
+#define CONVERGENCECONTROLLER_H
+
+/**
+ * @file ConvergenceController.h
+ * @brief Stopping criteria of the metaheuristic.
+ *
+ */
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../app.h"
+#include "../types/MRSortModel.h"
+
+/** @class ConvergenceController ConvergenceController.h
+ *  @brief Stopping criteria of the metaheuristic.
+ *
+ * The convergence controller is consulted by the HeuristicPipeline at the end
+ * of each iteration to decide whether the learning should go on. Besides the
+ * max_iterations limit handled by the pipeline itself, it stops the learning
+ * when:
+ * - the best score reached the target accuracy,
+ * - the best score did not improve for max_stale_iterations iterations,
+ * - the wall-clock time budget is exhausted,
+ * - the diversity of the kept models fell below min_diversity.
+ *
+ * Every criterion set to 0 in the config is disabled.
+ */
+class ConvergenceController {
+public:
+  /**
+   * ConvergenceController standard constructor.
+   *
+   * @param config app config holding the stopping criteria
+   */
+  ConvergenceController(Config &config);
+
+  ~ConvergenceController();
+
+  /**
+   * start resets the counters and starts the wall-clock timer. Must be called
+   * when the learning starts.
+   */
+  void start();
+
+  /**
+   * update records the state of the population at the end of an iteration
+   * and tells if the learning should stop. The reason of the stop can then be
+   * retrieved with getStopReason.
+   *
+   * @param models population of models, sorted in descending order of score
+   * @param best_score best score encountered since the start
+   *
+   * @return true if the learning should stop
+   */
+  bool update(std::vector<MRSortModel> &models, float best_score);
+
+  /**
+   * isTimeBudgetExhausted checks the wall-clock budget.
+   *
+   * @return true if a time budget is set and exhausted
+   */
+  bool isTimeBudgetExhausted() const;
+
+  /**
+   * getElapsedSeconds time spent since start was called
+   *
+   * @return elapsed seconds
+   */
+  double getElapsedSeconds() const;
+
+  /**
+   * computeDiversity computes the diversity of the n_models first models of
+   * the population as the mean L1 distance between the parameters (weights and
+   * lambda) of each model and the centroid of those parameters.
+   *
+   * @param models population of models
+   * @param n_models number of models (from the first one) to consider
+   *
+   * @return diversity
+   */
+  float computeDiversity(std::vector<MRSortModel> &models, int n_models);
+
+  /**
+   * getStaleIterations getter of the number of iterations since the last
+   * improvement of the best score
+   *
+   * @return stale_iterations
+   */
+  int getStaleIterations() const;
+
+  /**
+   * getStopReason getter of the reason why update asked to stop, empty if it
+   * did not
+   *
+   * @return stop_reason
+   */
+  std::string getStopReason() const;
+
+private:
+  Config &conf;
+
+  std::chrono::steady_clock::time_point start_time_;
+  float best_score_;
+  int stale_iterations_;
+  std::string stop_reason_;
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef COORDINATOR_H
+#define COORDINATOR_H
+
+/**
+ * @file Coordinator.h
+ * @brief Coordinator of a distributed learning across worker processes.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../app.h"
+#include "../types/MRSortModel.h"
+
+/** @class Coordinator Coordinator.h
+ *  @brief Coordinator of a distributed learning across worker processes.
+ *
+ * The coordinator listens on the Unix domain socket conf.coordinator_socket
+ * and waits for conf.n_workers worker processes (see RemoteMailbox and
+ * WorkerProtocol.h). The workers are connected in a ring in the order they
+ * register: the migrants posted by a worker are kept for the next one until it
+ * collects them. As in island mode, only the latest batch of migrants is
+ * kept.
+ *
+ * Every worker reports its best model when it is done. Once one of them
+ * reaches the target accuracy, the others are told to stop at their next
+ * collect. The coordinator returns when all the workers are done or
+ * disconnected.
+ */
+class Coordinator {
+public:
+  /**
+   * Coordinator constructor, creates the socket and starts listening so that
+   * the workers can be launched right after.
+   *
+   * @param config app config
+   */
+  Coordinator(Config &config);
+
+  /**
+   * Coordinator destructor, closes the connections and removes the socket
+   * file.
+   */
+  ~Coordinator();
+
+  Coordinator(const Coordinator &) = delete;
+  Coordinator &operator=(const Coordinator &) = delete;
+
+  /**
+   * serve answers the workers until all of them are done.
+   *
+   * @return best model reported by the workers
+   */
+  MRSortModel serve();
+
+  /**
+   * getNumberWorkers getter of the number of workers expected
+   *
+   * @return n_workers
+   */
+  int getNumberWorkers() const;
+
+private:
+  /**
+   * handleMessage reads and answers one message of a worker.
+   *
+   * @param worker_id id of the worker having sent a message
+   *
+   * @return true if the worker is done
+   */
+  bool handleMessage(int worker_id);
+
+  Config &conf;
+  int listen_fd;
+  std::vector<int> worker_fds;
+  // encoded migrants waiting for each worker, empty if none
+  std::vector<std::string> mailboxes;
+  std::vector<bool> done;
+  bool stop;
+  std::unique_ptr<MRSortModel> best_model;
+};
+
+#endif
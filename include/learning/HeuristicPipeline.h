@@ -7,11 +7,20 @@
  *
  */
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "../app.h"
+#include "AssignmentKernel.h"
+#include "ConvergenceController.h"
+#include "MigrationMailbox.h"
+#include "ModelCheckpointer.h"
 #include "ProfileInitializer.h"
 #include "ProfileUpdater.h"
+#include "ScratchArena.h"
 #include "WeightUpdater.h"
 
 /** @class HeuristicPipeline HeuristicPipeline.h
@@ -24,6 +33,12 @@
  *
  * A complete description of the heuristic can be found in @subpage
  * learning_algorithms.
+ *
+ * Within an iteration, each model goes through re-initialization, weight
+ * update and profile updates independently of the others. With n_threads > 1
+ * the models are spread dynamically over the threads, each linear problem
+ * being solved with a backend the WeightUpdater leases to the calling thread,
+ * and the ranking of the models is the only synchronization point.
  */
 
 class HeuristicPipeline {
@@ -32,8 +47,14 @@ public:
   /** HeuristicPipeline Base constructor, stores the given config.
    *
    * @param config app config to start and run the application.
+   * @param altPerfs dataset to learn from
+   * @param kernel assignment kernel of the dataset, built with
+   * config.rank_encoding, shared with the other pipelines of the dataset.
+   * Built by the pipeline if null
    */
-  HeuristicPipeline(Config &config, AlternativesPerformance &altPerfs);
+  HeuristicPipeline(
+      Config &config, AlternativesPerformance &altPerfs,
+      std::shared_ptr<const AssignmentKernel> kernel = nullptr);
 
   /** Start run the heuristic pipeline and return the best model learned.
    *
@@ -62,15 +83,105 @@ public:
    */
   void computeAccuracy(MRSortModel &model);
 
+  /** setIsland makes the pipeline one island of an IslandPipeline: every
+   * migration_interval iterations, copies of its best models are posted to the
+   * outbox and the migrants found in the inbox are integrated.
+   *
+   * @param island_id id of the island, used in the logs
+   * @param inbox mailbox the migrants are received from
+   * @param outbox mailbox the migrants are sent to
+   * @param stop flag shared by the islands, set when one of them reaches the
+   * target accuracy
+   */
+  void setIsland(int island_id, MigrationMailbox *inbox,
+                 MigrationMailbox *outbox, std::atomic<bool> *stop);
+
+  /** migrate sends copies of the n_migrants best models to the outbox and
+   * replaces the worst of the kept models by the migrants from the inbox.
+   * Models must be sorted in descending order of score.
+   *
+   */
+  void migrate();
+
   std::vector<MRSortModel> models;
 
 private:
   Config &conf;
   AlternativesPerformance &altPerfs;
 
+  // shared by the threads, which lease their own linear solver from it
   WeightUpdater weightUpdater;
   ProfileInitializer profileInitializer;
   ProfileUpdater profileUpdater;
+  ConvergenceController convergenceController;
+  ModelCheckpointer checkpointer;
+  // dense copy of the dataset, scores the models
+  std::shared_ptr<const AssignmentKernel> assignmentKernel;
+
+  // island mode, unset for a standalone pipeline
+  MigrationMailbox *inbox = nullptr;
+  MigrationMailbox *outbox = nullptr;
+  std::atomic<bool> *stop = nullptr;
+  std::string log_prefix = "";
+
+  // time spent per thread in profile initialization, weight update and
+  // profile update
+  std::vector<std::array<double, 3>> phase_durations;
+  // temporaries of the profile updates, one arena per thread kept over the
+  // iterations
+  std::vector<std::unique_ptr<ScratchArena>> scratch_arenas;
+
+  // metrics of the run, registered in conf.metrics: time of each call of the
+  // phases and counts of events
+  Metrics::Histogram &init_time;
+  Metrics::Histogram &weight_update_time;
+  Metrics::Histogram &profile_update_time;
+  Metrics::Histogram &accuracy_time;
+  Metrics::Counter &iteration_count;
+  Metrics::Counter &reinit_count;
+  Metrics::Counter &migrant_count;
+
+  /** updateModels runs one iteration of the sub algorithms on every model,
+   * spread over n_threads threads.
+   *
+   * @param first_reinit models from this index on are re-initialized first
+   */
+  void updateModels(int first_reinit);
+
+  /** updateModel runs the re-initialization, the weight update and the
+   * profile updates of one model.
+   *
+   * @param k index of the model
+   * @param reinit re-initialize the weights and profiles of the model first
+   * @param durations time spent in each phase, incremented
+   * @param arena arena of the calling thread
+   */
+  void updateModel(int k, bool reinit, std::array<double, 3> &durations,
+                   ScratchArena &arena);
+
+  /** updateAccuracy computes the accuracy of a model after one of its phases,
+   * logging its gain in debug.
+   *
+   * @param model model to work on
+   * @param k index of the model
+   * @param phase name of the phase in the log
+   */
+  void updateAccuracy(MRSortModel &model, int k, const char *phase);
+
+  /** polish runs a last weight update of the best model on the whole dataset
+   * when the weight updates only used samples of it (conf.lp_sample_size), and
+   * keeps it if it does not lower the accuracy.
+   *
+   * @param best_model best model learned, updated
+   */
+  void polish(MRSortModel &best_model);
+
+  /** stopIslands tells the other islands to stop if the best model reached the
+   * target accuracy.
+   *
+   * @param best_model best model of this island
+   */
+  void stopIslands(MRSortModel &best_model);
 };
 
 #endif
\ No newline at end of file
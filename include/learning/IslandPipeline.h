@@ -0,0 +1,82 @@
+#ifndef ISLANDPIPELINE_H
+#define ISLANDPIPELINE_H
+
+/**
+ * @file IslandPipeline.h
+ * @brief Parallel island model of the metaheuristic.
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+#include "../types/MRSortModel.h"
+#include "AssignmentKernel.h"
+#include "HeuristicPipeline.h"
+#include "MigrationMailbox.h"
+
+/** @class IslandPipeline IslandPipeline.h
+ *  @brief Parallel island model of the metaheuristic.
+ *
+ * The island pipeline runs n_islands independent HeuristicPipeline, each one
+ * on its own thread with its own population of model_batch_size models and its
+ * own WeightUpdater, ProfileInitializer and ProfileUpdater. The islands are
+ * connected in a ring: every migration_interval iterations, each island sends
+ * copies of its n_migrants best models to the next one through a
+ * MigrationMailbox.
+ *
+ * The islands stop on their own convergence criteria, or as soon as one of
+ * them reaches the target accuracy. Only the first island writes checkpoints,
+ * the best models of the others reaching it through migration.
+ */
+class IslandPipeline {
+
+public:
+  /** IslandPipeline Base constructor, stores the given config.
+   *
+   * @param config app config to start and run the application.
+   * @param altPerfs dataset to learn from
+   * @param kernel assignment kernel of the dataset, built with
+   * config.rank_encoding. Built once for all the islands if null
+   */
+  IslandPipeline(Config &config, AlternativesPerformance &altPerfs,
+                 std::shared_ptr<const AssignmentKernel> kernel = nullptr);
+
+  ~IslandPipeline();
+
+  /** Start run all the islands in parallel and return the best model learned.
+   *
+   * @return best_model
+   */
+  MRSortModel start();
+
+  /** getIsland getter of an island pipeline
+   *
+   * @param island_id index of the island
+   *
+   * @return island
+   */
+  HeuristicPipeline &getIsland(int island_id);
+
+  /** getNumberIslands getter of the number of islands
+   *
+   * @return n_islands
+   */
+  int getNumberIslands() const;
+
+private:
+  Config &conf;
+  AlternativesPerformance &altPerfs;
+
+  // one config per island, only the first island writes checkpoints
+  std::vector<std::unique_ptr<Config>> island_confs;
+  std::vector<std::unique_ptr<HeuristicPipeline>> islands;
+  // mailboxes[k] is the inbox of island k and the outbox of island k - 1
+  std::vector<std::unique_ptr<MigrationMailbox>> mailboxes;
+  std::atomic<bool> stop;
+};
+
+#endif
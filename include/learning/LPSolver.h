@@ -0,0 +1,75 @@
+#ifndef LPSOLVER_H
+#define LPSOLVER_H
+
+/**
+ * @file LPSolver.h
+ * @brief Interface of the linear problem backends of the WeightUpdater.
+ *
+ */
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/** @class LPSolver LPSolver.h
+ *  @brief Interface of the linear problem backends of the WeightUpdater.
+ *
+ * A backend receives the constraint matrices computed by the WeightUpdater,
+ * solves the linear problem described in @subpage weight_updater and returns
+ * the new lambda and weights. Three backends are available, selected by
+ * conf.lp_solver:
+ * - LinearSolver, wrapping the OR-Tools solvers ("GLOP" or any other solver id
+ * known by OR-Tools),
+ * - SimplexSolver ("SIMPLEX"), a bounded-variable simplex specialized to the
+ * structure of this problem, without the model building overhead of OR-Tools
+ * on the small problems we solve,
+ * - SubgradientSolver ("SUBGRADIENT"), a projected subgradient method on the
+ * same objective, approximate but in a predictable time.
+ */
+class LPSolver {
+public:
+  virtual ~LPSolver() {}
+
+  /** solve Solve the linear problem given the constraint matrices.
+   *
+   * @param x_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the x variables
+   * @param y_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the y variables
+   *
+   * @return results contained in a pair of (lambda, vector of weights)
+   */
+  virtual std::pair<float, std::vector<float>>
+  solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
+        std::vector<std::vector<std::vector<bool>>> y_matrix) = 0;
+
+  /** create instantiates the backend selected by conf.lp_solver.
+   *
+   * @param ap dataset of the problem
+   * @param conf config of the app
+   *
+   * @return backend
+   */
+  static std::unique_ptr<LPSolver> create(AlternativesPerformance &ap,
+                                          Config &conf);
+
+protected:
+  /** distinctRows groups the identical rows of a constraint matrix.
+   *
+   * @param matrix constraint matrix, empty rows are ignored
+   * @param rows filled with the distinct rows, in order of first appearance
+   * @param multiplicity filled with the number of alternatives of each row
+   * @param row_of_alt filled with the index in rows of each alternative per
+   * profile, -1 for empty rows
+   */
+  static void distinctRows(std::vector<std::vector<std::vector<bool>>> &matrix,
+                           std::vector<std::vector<bool>> &rows,
+                           std::vector<int> &multiplicity,
+                           std::vector<std::vector<int>> &row_of_alt);
+};
+
+#endif
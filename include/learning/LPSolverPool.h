@@ -0,0 +1,80 @@
+#ifndef LPSOLVERPOOL_H
+#define LPSOLVERPOOL_H
+
+/**
+ * @file LPSolverPool.h
+ * @brief Pool of linear problem backends shared by the threads of the weight
+ * update.
+ *
+ */
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+#include "LPSolver.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** @class LPSolverPool LPSolverPool.h
+ *  @brief Pool of linear problem backends shared by the threads of the weight
+ * update.
+ *
+ * The LPSolver backends are not thread safe and are expensive to create (the
+ * OR-Tools model is allocated with the solver). The pool owns the backends and
+ * leases each one to a single thread at a time: a thread acquires a backend,
+ * solves as many linear problems as it needs with it, and gives it back when
+ * the lease is destroyed. A backend is only created when all the others are
+ * leased, so that the pool holds at most one backend per thread solving
+ * concurrently, reused over the models and the iterations.
+ */
+class LPSolverPool {
+public:
+  /** Release gives a leased backend back to its pool. */
+  struct Release {
+    LPSolverPool *pool;
+    void operator()(LPSolver *solver) const;
+  };
+
+  /** Lease is the exclusive use of a backend of the pool, given back when it
+   * is destroyed. It must not outlive the pool. */
+  using Lease = std::unique_ptr<LPSolver, Release>;
+
+  /**
+   * LPSolverPool standard constructor, no backend is created before the first
+   * acquire.
+   *
+   * @param ap AlternativesPerformance objet that represents the dataset of the
+   * problem
+   * @param conf config setup of the app, conf.lp_solver selects the backend
+   */
+  LPSolverPool(AlternativesPerformance &ap, Config &conf);
+
+  LPSolverPool(const LPSolverPool &) = delete;
+  LPSolverPool &operator=(const LPSolverPool &) = delete;
+
+  /**
+   * acquire leases a backend, creating one if all of them are leased.
+   *
+   * @return lease
+   */
+  Lease acquire();
+
+  /**
+   * getNumberSolvers getter of the number of backends created by the pool
+   *
+   * @return n_solvers
+   */
+  int getNumberSolvers() const;
+
+private:
+  AlternativesPerformance &ap;
+  Config &conf;
+
+  mutable std::mutex mutex;
+  // backends owned by the pool, the leased ones are held by their lease
+  std::vector<std::unique_ptr<LPSolver>> available;
+  int n_solvers = 0;
+};
+
+#endif
@@ -0,0 +1,176 @@
+#ifndef LEARNINGSERVER_H
+#define LEARNINGSERVER_H
+
+/**
+ * @file LearningServer.h
+ * @brief Long running server learning models on resident datasets.
+ *
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+#include "../types/MRSortModel.h"
+#include "AssignmentKernel.h"
+
+/** @class LearningServer LearningServer.h
+ *  @brief Long running server learning models on resident datasets.
+ *
+ * The server listens on the Unix domain socket conf.server_socket and answers
+ * the learn and predict requests of its clients (see WorkerProtocol.h). A
+ * dataset is parsed on its first request and then stays in memory, so that
+ * learning again on the same dataset with other parameters does not load it
+ * again. It is loaded again if its file changed since.
+ *
+ * A learn request is a yaml mapping giving the dataset, the output of the
+ * model and the parameters of the config to change for this learning:
+ *
+ *     dataset: in7dataset.xml
+ *     output: in7model.xml
+ *     model_batch_size: 20
+ *     max_iterations: 50
+ *
+ * The model is saved in its output, as a single run would save it, and its
+ * xml is sent back. The server keeps it under the name of its output for the
+ * predict requests, which give the model and the dataset whose alternatives
+ * are to be assigned:
+ *
+ *     model: in7model.xml
+ *     dataset: in7dataset.xml
+ *
+ * The socket is only open to the user running the server. A request cannot
+ * change data_dir, the sockets or n_jobs, its dataset, output and lp_dump
+ * must be relative paths that stay in data_dir, and it cannot ask for more
+ * threads or islands than the config of the server (n_threads, n_islands).
+ *
+ * The requests are answered by conf.n_jobs threads. The connections waiting
+ * for a request are polled by the thread of serve, so that a thread is only
+ * held by a client while one of its requests is running.
+ */
+class LearningServer {
+public:
+  /**
+   * LearningServer constructor, creates the socket and starts listening so
+   * that the clients can connect right after.
+   *
+   * @param config app config
+   */
+  LearningServer(Config &config);
+
+  /**
+   * LearningServer destructor, closes the connections and removes the socket
+   * file.
+   */
+  ~LearningServer();
+
+  LearningServer(const LearningServer &) = delete;
+  LearningServer &operator=(const LearningServer &) = delete;
+
+  /**
+   * serve answers the clients until one of them asks for a shutdown.
+   */
+  void serve();
+
+  /**
+   * learn answers a learn request
+   *
+   * @param request yaml mapping of the request
+   *
+   * @return xml of the model learned
+   */
+  std::string learn(const std::string &request);
+
+  /**
+   * predict answers a predict request
+   *
+   * @param request yaml mapping of the request
+   *
+   * @return one "alternative category" line per alternative of the dataset
+   */
+  std::string predict(const std::string &request);
+
+  /**
+   * getNumberLoads getter of the number of times a dataset was parsed
+   *
+   * @return number of loads
+   */
+  int getNumberLoads() const;
+
+private:
+  /** Dataset kept in memory, with the time of the file it was read from and
+   * its assignment kernels, without and with rank encoding, built by the first
+   * learn request needing them */
+  struct ResidentDataset {
+    std::filesystem::file_time_type write_time;
+    std::shared_ptr<AlternativesPerformance> dataset;
+    std::shared_ptr<const AssignmentKernel> kernels[2];
+  };
+
+  /**
+   * getDataset gives the dataset of the config, parsing it if it is not in
+   * memory yet or if its file changed.
+   *
+   * @param config config giving the dataset and its directory
+   *
+   * @return dataset
+   */
+  std::shared_ptr<AlternativesPerformance> getDataset(Config &config);
+
+  /**
+   * getKernel gives the assignment kernel of a resident dataset for the
+   * encoding of the config, building it if no request built it yet.
+   *
+   * @param config config giving the dataset, its directory and the encoding
+   * @param dataset dataset given by getDataset for this config
+   *
+   * @return kernel shared by the learn requests on the dataset
+   */
+  std::shared_ptr<const AssignmentKernel>
+  getKernel(Config &config,
+            const std::shared_ptr<AlternativesPerformance> &dataset);
+
+  /**
+   * serveClient answers the pending request of a client, then gives its
+   * connection back to the poll loop of serve. The connection is closed if
+   * the client is gone.
+   *
+   * @param fd socket of the client
+   */
+  void serveClient(int fd);
+
+  /**
+   * handleRequest reads and answers one request of a client.
+   *
+   * @param fd socket of the client
+   */
+  void handleRequest(int fd);
+
+  Config &conf;
+  int listen_fd;
+  // written by the threads to wake up the poll loop when they give a
+  // connection back
+  int wake_fds[2];
+  std::atomic<bool> stop;
+  std::atomic<int> n_loads;
+  // connections without pending request, only used by the poll loop
+  std::vector<int> idle_clients;
+  // guards the clients waiting for a thread, the answered clients, the
+  // datasets and the models
+  std::mutex mutex;
+  std::condition_variable client_waiting;
+  std::deque<int> clients;
+  std::vector<int> answered_clients;
+  std::unordered_map<std::string, ResidentDataset> datasets;
+  std::unordered_map<std::string, MRSortModel> models;
+};
+
+#endif
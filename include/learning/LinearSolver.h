@@ -9,30 +9,46 @@
 
 #include "../app.h"
 #include "../types/AlternativesPerformance.h"
+#include "LPSolver.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "spdlog/spdlog.h"
 
+#include <memory>
 #include <string>
+#include <vector>
 
 /** @class LinearSolver LinearSolver.h
  *  @brief External linear solver wrapper
  *
  * The linear solver class is a wrapper that makes an abstraction between the
  * weight updater and the resolution of the linear problem. Currently this
- * wrapper uses ortools interface and only the ortools solver (GLOP) is
- * implemented. Other solver could be used by following the instruction on how
- * to install them for ortools and changing the initialisation of the solver to
- * use the right one, however the implementation of the resolution shouldn't
- * have to be changed.
+ * wrapper uses ortools interface and any solver known by ortools can be
+ * selected by its id (GLOP by default). Other solvers have to be installed for
+ * ortools following its instructions, the implementation of the resolution
+ * doesn't have to be changed. It is one of the LPSolver backends.
  *
  * The abstraction was made by receiving the constraint matrices according to
  * the equations described in the thesis and returning the solution found for
- * the new weights and lambda.
+ * the new weights and lambda. Each equation (sum of the weights and x, y
+ * constraints) is a single row whose lower and upper bounds are equal.
+ *
+ * When conf.reduce_lp is set, the alternatives sharing the same comparison
+ * vector share a single row, weighted in the objective by the number
+ * of alternatives they stand for. The solution is the same, but the linear
+ * problem only grows with the number of distinct comparison vectors, which is
+ * bounded by 2^n_crit whatever the number of alternatives.
+ *
+ * The variables and constraints are not named by the library, so that no name
+ * is built for each alternative at each resolution; OR-Tools still gives its
+ * own generated names to the unnamed ones. They are only named after the
+ * linear problem when conf.lp_dump is set, each linear problem being then exported
+ * to this file before being solved, for offline inspection. The exports of the
+ * threads are serialized, the file holding the last problem exported.
  *
  * Link to ortools (google) : https://github.com/google/or-tools
  */
 
-class LinearSolver {
+class LinearSolver : public LPSolver {
 public:
   /**
    * LinearSolver standard constructor.
@@ -40,12 +56,16 @@ public:
    * @param ap AlternativesPerformance objet that represents the dataset of the
    * problem
    * @param config config setup from the app
-   * @param solver solver type to use. Currently only "GLOP" is implemented
+   * @param solver ortools id of the solver to use, "GLOP" by default
    */
   LinearSolver(AlternativesPerformance &ap, Config &conf,
                float delta = 0.000001, std::string solver = "GLOP");
 
-  ~LinearSolver();
+  ~LinearSolver() override;
+
+  // the solver owns the OR-Tools model, it is neither copied nor shared
+  LinearSolver(const LinearSolver &) = delete;
+  LinearSolver &operator=(const LinearSolver &) = delete;
 
   /** initializeSolver Initialise the solver given the alternative performance
    * (dataset): add variables and constraints that are not changing given a
@@ -54,8 +74,18 @@ public:
    */
   void initializeSolver();
 
+  /** initializeSolver Initialise the solver for a linear problem on n_alt
+   * alternatives, e.g. the sample of the dataset a weight update is made on.
+   * Without reduction, the x, x', y, y' variables are created for each of
+   * them.
+   *
+   * @param n_alt number of alternatives in the constraint matrices
+   */
+  void initializeSolver(int n_alt);
+
   /** updateConstraints reset the previous constraints and add the new ones
-   * given by the matrixes
+   * given by the matrixes. The alternatives of the problem are the rows of the
+   * matrices, which may only be a sample of the dataset.
    *
    * @param x_matrix matrix recapitulating the constraints to add to the linear
    * problem for the x variables
@@ -77,7 +107,19 @@ public:
    */
   std::pair<float, std::vector<float>>
   solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
-        std::vector<std::vector<std::vector<bool>>> y_matrix);
+        std::vector<std::vector<std::vector<bool>>> y_matrix) override;
+
+  /** exportModel writes the current linear problem to a file, in MPS format if
+   * the file name ends with ".mps" and in LP format otherwise. The variables
+   * and constraints are only named if conf.lp_dump is set. The files are
+   * written one at a time, so that the solvers of several threads can export
+   * to the same file.
+   *
+   * @param file_name path of the file to write
+   *
+   * @return true if the model was written
+   */
+  bool exportModel(std::string file_name) const;
 
   /**
    * getAlternativesPerformance getter of the alternative performance
@@ -87,7 +129,7 @@ public:
   AlternativesPerformance &getAlternativesPerformance() const;
 
   /**
-   * getSolver getter of the solver
+   * getSolver getter of the solver, owned by the LinearSolver
    *
    * @return solver
    */
@@ -128,6 +170,24 @@ public:
    */
   std::vector<operations_research::MPVariable *> getYap() const;
 
+  /**
+   * getXRows getter of the mapping of the alternatives to the rows of the
+   * reduced problem: x_a[x_rows[h][alt]] is the x variable of the alternative
+   * alt for the profile h, -1 if alt has no row. Empty if the problem is not
+   * reduced.
+   *
+   * @return x_rows
+   */
+  std::vector<std::vector<int>> getXRows() const;
+
+  /**
+   * getYRows getter of the mapping of the alternatives to the y rows of the
+   * reduced problem, see getXRows.
+   *
+   * @return y_rows
+   */
+  std::vector<std::vector<int>> getYRows() const;
+
   /**
    * getConf getter of the conf
    *
@@ -137,13 +197,17 @@ public:
 
 private:
   AlternativesPerformance &ap;
-  operations_research::MPSolver *solver;
+  std::unique_ptr<operations_research::MPSolver> solver;
   std::string solver_name;
   Config &conf;
 
   // value use to transform strict inequalities into non-strict ones
   float delta;
 
+  // metrics of the resolutions, registered in conf.metrics
+  Metrics::Histogram &rows_metric;
+  Metrics::Histogram &iterations_metric;
+
   // variables
   std::vector<operations_research::MPVariable *> x_a;
   std::vector<operations_research::MPVariable *> x_ap;
@@ -156,6 +220,54 @@ private:
   std::vector<operations_research::MPConstraint *> x_constraints;
   std::vector<operations_research::MPConstraint *> y_constraints;
   std::vector<operations_research::MPConstraint *> weights_constraint;
+
+  // reduced problem: row of each alternative, per profile
+  std::vector<std::vector<int>> x_rows;
+  std::vector<std::vector<int>> y_rows;
+
+  /** lpName builds the name of a variable or a constraint, only if the linear
+   * problem is dumped. OR-Tools names the variables and constraints given an
+   * empty name itself.
+   *
+   * @param prefix prefix of the name
+   * @param index first index appended to the prefix
+   * @param alt alternative appended after "_a", -1 if none
+   *
+   * @return name, empty if conf.lp_dump is not set
+   */
+  std::string lpName(const std::string &prefix, int index, int alt = -1) const;
+
+  /** addReducedConstraints adds one row, with its variables, per
+   * distinct comparison vector of the matrices.
+   *
+   * @param x_matrix matrix of the x constraints
+   * @param y_matrix matrix of the y constraints
+   */
+  void
+  addReducedConstraints(std::vector<std::vector<std::vector<bool>>> &x_matrix,
+                        std::vector<std::vector<std::vector<bool>>> &y_matrix);
+
+  /** addXConstraints adds the equality row of one x constraint.
+   *
+   * @param x_row comparison vector of the alternative with the profile
+   * @param x x variable of the row
+   * @param xp x' variable of the row
+   * @param name name of the constraint
+   */
+  void addXConstraints(std::vector<bool> &x_row,
+                       operations_research::MPVariable *x,
+                       operations_research::MPVariable *xp, std::string name);
+
+  /** addYConstraints adds the equality row of one y constraint.
+   *
+   * @param y_row comparison vector of the alternative with the profile
+   * @param y y variable of the row
+   * @param yp y' variable of the row
+   * @param name name of the constraint
+   */
+  void addYConstraints(std::vector<bool> &y_row,
+                       operations_research::MPVariable *y,
+                       operations_research::MPVariable *yp, std::string name);
 };
 
 #endif
\ No newline at end of file
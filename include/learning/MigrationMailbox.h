@@ -0,0 +1,58 @@
+#ifndef MIGRATIONMAILBOX_H
+#define MIGRATIONMAILBOX_H
+
+/**
+ * @file MigrationMailbox.h
+ * @brief Lock-free mailbox used to exchange models between islands.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "../types/MRSortModel.h"
+
+/** @class MigrationMailbox MigrationMailbox.h
+ *  @brief Lock-free mailbox used to exchange models between islands.
+ *
+ * The mailbox holds at most one batch of migrants. The sending island posts a
+ * batch, replacing the previous one if it was not collected yet, and the
+ * receiving island collects it when it is ready to integrate migrants. Both
+ * operations are a single atomic exchange of the slot, so no island ever waits
+ * for an other one.
+ *
+ * post and collect are virtual so that the islands of a distributed run can
+ * exchange their migrants through the coordinator (see RemoteMailbox).
+ */
+class MigrationMailbox {
+public:
+  MigrationMailbox();
+
+  /**
+   * MigrationMailbox destructor, deletes the batch that was not collected.
+   */
+  virtual ~MigrationMailbox();
+
+  MigrationMailbox(const MigrationMailbox &) = delete;
+  MigrationMailbox &operator=(const MigrationMailbox &) = delete;
+
+  /**
+   * post puts a batch of migrants in the mailbox. A batch that was not
+   * collected yet is dropped, only the latest migrants are relevant.
+   *
+   * @param migrants models to send
+   */
+  virtual void post(const std::vector<MRSortModel> &migrants);
+
+  /**
+   * collect takes the batch of migrants out of the mailbox.
+   *
+   * @return migrants, empty if nothing was posted since the last collect
+   */
+  virtual std::vector<MRSortModel> collect();
+
+private:
+  std::atomic<std::vector<MRSortModel> *> slot_;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef MODELCHECKPOINTER_H
+#define MODELCHECKPOINTER_H
+
+/**
+ * @file ModelCheckpointer.h
+ * @brief Asynchronous saving of the best model during the learning.
+ *
+ */
+
+#include <chrono>
+#include <future>
+#include <string>
+
+#include "../app.h"
+#include "../types/MRSortModel.h"
+
+/** @class ModelCheckpointer ModelCheckpointer.h
+ *  @brief Asynchronous saving of the best model during the learning.
+ *
+ * The model checkpointer periodically writes the best model encountered so far
+ * to the output file of the app, so that a job killed before the end of the
+ * learning still yields a model. The model is copied and then written by a
+ * background thread through DataGenerator::saveModel, the learning does not
+ * wait for the disk. The file is first written next to the output and then
+ * renamed, so the output is never left half written.
+ *
+ * Checkpoints are enabled when checkpoint_interval_seconds is set and an
+ * output file is given in the config.
+ */
+class ModelCheckpointer {
+public:
+  /**
+   * ModelCheckpointer standard constructor.
+   *
+   * @param config app config holding the output file and the interval
+   */
+  ModelCheckpointer(Config &config);
+
+  /**
+   * ModelCheckpointer destructor, waits for the pending checkpoint.
+   */
+  ~ModelCheckpointer();
+
+  /**
+   * isDue tells if checkpoints are enabled and if the interval since the last
+   * one has elapsed.
+   *
+   * @return true if a checkpoint should be saved
+   */
+  bool isDue() const;
+
+  /**
+   * save copies the model and saves it asynchronously. If the previous
+   * checkpoint is still being written, waits for it first.
+   *
+   * @param model model to save
+   */
+  void save(const MRSortModel &model);
+
+  /**
+   * wait blocks until the pending checkpoint, if any, is written.
+   */
+  void wait();
+
+  /**
+   * getNumberCheckpoints getter of the number of checkpoints started
+   *
+   * @return n_checkpoints
+   */
+  int getNumberCheckpoints() const;
+
+private:
+  Config &conf;
+
+  std::future<void> pending_;
+  std::chrono::steady_clock::time_point last_checkpoint_;
+  int n_checkpoints_;
+};
+
+#endif
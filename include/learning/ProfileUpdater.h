@@ -8,11 +8,16 @@
  */
 
 #include <iostream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../app.h"
 #include "../types/MRSortModel.h"
+#include "ScratchArena.h"
 
 /** @class ProfileUpdater ProfileUpdater.h
  *  @brief Third step of the heuristic, updates the profiles given fixed weight
@@ -23,11 +28,20 @@
  * criterion to see what moves have the best impact on the alternatives
  * assignments.
  *
+ * The desirability maps built for each move are std::pmr containers: given
+ * the ScratchArena of the calling thread, updateProfiles allocates them in the
+ * arena, which is reset once the profiles are updated.
  *
+ * The assignments of the model are held by a copy of the dataset. The copies
+ * are kept by the ProfileUpdater and reused by the next updates, one per
+ * thread updating concurrently, so that an update does not copy the dataset.
  */
 
 class ProfileUpdater {
 public:
+  /** desirability of the moves of a profile, by new value of the profile */
+  using Desirability = std::pmr::unordered_map<float, float>;
+
   /**
    * ProfileUpdater standard constructor
    *
@@ -59,15 +73,17 @@ public:
    * @param cat_above above category delimited by the profile
    * @param ct_prof concordance table of the profile
    * @param altPerf_model alternativePerformance calculated with current model
+   * @param resource memory of the returned map
    *
    * @return the map of potential new perf for the profile and their
    * desirability
    */
-  std::unordered_map<float, float>
-  computeAboveDesirability(MRSortModel &model, std::string critId, Perf &b,
-                           Perf &b_above, Category &cat, Category &cat_above,
-                           std::unordered_map<std::string, float> &ct_prof,
-                           AlternativesPerformance &altPerf_model);
+  Desirability computeAboveDesirability(
+      MRSortModel &model, std::string critId, Perf &b, Perf &b_above,
+      Category &cat, Category &cat_above,
+      std::unordered_map<std::string, float> &ct_prof,
+      AlternativesPerformance &altPerf_model,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   /**
    * computeBelowDesirability computes the desirability of a move for the
@@ -81,15 +97,17 @@ public:
    * @param cat_above above category delimited by the profile
    * @param ct_prof concordance table of the profile
    * @param altPerf_model alternativePerformance calculated with current model
+   * @param resource memory of the returned map
    *
    * @return the map of potential new perf for the profile and their
    * desirability
    */
-  std::unordered_map<float, float>
-  computeBelowDesirability(MRSortModel &model, std::string critId, Perf &b,
-                           Perf &b_below, Category &cat, Category &cat_above,
-                           std::unordered_map<std::string, float> &ct_prof,
-                           AlternativesPerformance &altPerf_model);
+  Desirability computeBelowDesirability(
+      MRSortModel &model, std::string critId, Perf &b, Perf &b_below,
+      Category &cat, Category &cat_above,
+      std::unordered_map<std::string, float> &ct_prof,
+      AlternativesPerformance &altPerf_model,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   /**
    * chooseMaxDesirability chooses the move of the profiles that maximizes the
@@ -100,9 +118,8 @@ public:
    *
    * @returns profile value and associate desirability (max)
    */
-  std::pair<float, float>
-  chooseMaxDesirability(std::unordered_map<float, float> &desirability,
-                        Perf &b);
+  std::pair<float, float> chooseMaxDesirability(Desirability &desirability,
+                                                Perf &b);
 
   /**
    * updateTables updates model tables with new profile value
@@ -133,14 +150,16 @@ public:
    * @param model current model
    * @param ct concordance table
    * @param altPerf_model altPerf_model
+   * @param resource memory of the temporaries
    *
    */
   void optimizeProfile(
-      std::vector<Perf> &prof, Category &cat_below, Category &cat_above,
+      const std::vector<Perf> &prof, Category &cat_below, Category &cat_above,
       MRSortModel &model,
       std::unordered_map<std::string, std::unordered_map<std::string, float>>
           &ct,
-      AlternativesPerformance &altPerf_model);
+      AlternativesPerformance &altPerf_model,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   /**
    * optimize Optimizes all the profiles using the profileUpdater methods.
@@ -148,12 +167,15 @@ public:
    * @param model current model
    * @param ct concordance table
    * @param altPerf_model altPerf_model
+   * @param resource memory of the temporaries
    *
    */
-  void optimize(MRSortModel &model,
-                std::unordered_map<std::string,
-                                   std::unordered_map<std::string, float>> &ct,
-                AlternativesPerformance &altPerf_model);
+  void optimize(
+      MRSortModel &model,
+      std::unordered_map<std::string, std::unordered_map<std::string, float>>
+          &ct,
+      AlternativesPerformance &altPerf_model,
+      std::pmr::memory_resource *resource = std::pmr::get_default_resource());
 
   /**
    * updateProfiles Updates the profiles of the model using the metaheuristic
@@ -163,10 +185,48 @@ public:
    */
   void updateProfiles(MRSortModel &model);
 
+  /**
+   * updateProfiles Updates the profiles of the model using the metaheuristic,
+   * the temporaries being allocated in the arena, reset at the end
+   *
+   * @param model current model
+   * @param arena arena of the calling thread
+   *
+   */
+  void updateProfiles(MRSortModel &model, ScratchArena &arena);
+
 private:
+  /**
+   * acquireAssignmentTable leases a copy of the dataset, creating one if all
+   * of them are leased, holding the assignments of the model
+   *
+   * @param model current model
+   *
+   * @return assignments of the model
+   */
+  std::unique_ptr<AlternativesPerformance>
+  acquireAssignmentTable(MRSortModel &model);
+
+  /**
+   * releaseAssignmentTable gives back a leased copy of the dataset
+   *
+   * @param altPerf_model copy to give back
+   */
+  void
+  releaseAssignmentTable(std::unique_ptr<AlternativesPerformance> altPerf_model);
+
   float epsilon_;
   AlternativesPerformance &altPerf_data;
   Config &conf;
+
+  // moves of the profiles with a positive desirability, and the ones drawn,
+  // registered in conf.metrics
+  Metrics::Counter &moves_proposed;
+  Metrics::Counter &moves_accepted;
+
+  std::mutex mutex;
+  // copies of the dataset not leased by an update
+  std::vector<std::unique_ptr<AlternativesPerformance>> assignment_tables;
 };
 
 #endif
\ No newline at end of file
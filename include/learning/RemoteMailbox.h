@@ -0,0 +1,90 @@
+#ifndef REMOTEMAILBOX_H
+#define REMOTEMAILBOX_H
+
+/**
+ * @file RemoteMailbox.h
+ * @brief Mailbox of a worker process exchanging models through the
+ * coordinator.
+ *
+ */
+
+#include <atomic>
+#include <vector>
+
+#include "../app.h"
+#include "../types/MRSortModel.h"
+#include "MigrationMailbox.h"
+
+/** @class RemoteMailbox RemoteMailbox.h
+ *  @brief Mailbox of a worker process exchanging models through the
+ * coordinator.
+ *
+ * In distributed mode each worker process runs a single HeuristicPipeline
+ * whose inbox and outbox are the same RemoteMailbox. Posted migrants are sent
+ * to the coordinator which forwards them to the next worker of the ring, and
+ * collect asks the coordinator for the migrants sent by the previous one.
+ *
+ * When the coordinator answers a collect with Stop, an other worker reached
+ * the target accuracy and the stop flag given at construction is raised.
+ */
+class RemoteMailbox : public MigrationMailbox {
+public:
+  /**
+   * RemoteMailbox constructor, connects to the coordinator listening on
+   * conf.coordinator_socket and registers the worker.
+   *
+   * @param config app config
+   * @param stop flag raised when the coordinator stops the workers
+   */
+  RemoteMailbox(Config &config, std::atomic<bool> *stop);
+
+  /**
+   * RemoteMailbox destructor, closes the connection.
+   */
+  ~RemoteMailbox() override;
+
+  /**
+   * post sends migrants to the coordinator.
+   *
+   * @param migrants models to send
+   */
+  void post(const std::vector<MRSortModel> &migrants) override;
+
+  /**
+   * collect asks the coordinator for the migrants sent to this worker.
+   *
+   * @return migrants, empty if nothing was posted since the last collect
+   */
+  std::vector<MRSortModel> collect() override;
+
+  /**
+   * done reports the best model learned by the worker to the coordinator and
+   * closes the connection.
+   *
+   * @param best_model best model learned by the worker
+   */
+  void done(const MRSortModel &best_model);
+
+  /**
+   * getWorkerId getter of the id given by the coordinator
+   *
+   * @return worker_id
+   */
+  int getWorkerId() const;
+
+  /**
+   * getNumberWorkers getter of the number of workers of the run
+   *
+   * @return n_workers
+   */
+  int getNumberWorkers() const;
+
+private:
+  Config &conf;
+  std::atomic<bool> *stop;
+  int fd;
+  int worker_id;
+  int n_workers;
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef SCRATCHARENA_H
+#define SCRATCHARENA_H
+
+/**
+ * @file ScratchArena.h
+ * @brief Monotonic arena of the temporaries of one iteration of a thread.
+ *
+ */
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+/** @class ScratchArena ScratchArena.h
+ *  @brief Monotonic arena of the temporaries of one iteration of a thread.
+ *
+ * The arena hands out the memory of the std::pmr containers built and thrown
+ * away by one step of the learning (concordance of a profile, desirability of
+ * its moves...): an allocation moves a pointer in a buffer, a deallocation
+ * does nothing, and the whole buffer is given back at once by reset, at the
+ * end of the step, when none of these containers is alive anymore.
+ *
+ * When the buffer is full, the arena falls back to the heap. reset then grows
+ * the buffer by what was taken from the heap, so that after a few steps the
+ * temporaries of a step fit in the buffer and a step does not allocate at all.
+ *
+ * An arena is used by a single thread at a time.
+ */
+class ScratchArena {
+public:
+  /**
+   * ScratchArena standard constructor
+   *
+   * @param initial_size size of the buffer in bytes
+   */
+  ScratchArena(std::size_t initial_size = 64 * 1024);
+
+  ScratchArena(const ScratchArena &) = delete;
+  ScratchArena &operator=(const ScratchArena &) = delete;
+
+  ~ScratchArena();
+
+  /**
+   * resource gives the memory resource of the arena, for the std::pmr
+   * containers of the step
+   *
+   * @return memory resource, valid until the next reset
+   */
+  std::pmr::memory_resource *resource();
+
+  /**
+   * reset frees everything allocated from the arena, which must not be used
+   * anymore, and grows the buffer if the step did not fit in it
+   *
+   */
+  void reset();
+
+  /**
+   * getCapacity getter of the size of the buffer
+   *
+   * @return size in bytes
+   */
+  std::size_t getCapacity() const;
+
+private:
+  /** Overflow takes from the heap what does not fit in the buffer, and
+   * records its size. */
+  class Overflow : public std::pmr::memory_resource {
+  public:
+    std::size_t allocated = 0;
+
+  private:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void *p, std::size_t bytes,
+                       std::size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource &other) const
+        noexcept override;
+  };
+
+  std::vector<std::byte> buffer;
+  Overflow overflow;
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
+};
+
+#endif
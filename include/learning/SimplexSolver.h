@@ -0,0 +1,164 @@
+#ifndef SIMPLEXSOLVER_H
+#define SIMPLEXSOLVER_H
+
+/**
+ * @file SimplexSolver.h
+ * @brief Simplex solver specialized to the weight update linear problem.
+ *
+ */
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+#include "LPSolver.h"
+
+#include <utility>
+#include <vector>
+
+/** @class SimplexSolver SimplexSolver.h
+ *  @brief Simplex solver specialized to the weight update linear problem.
+ *
+ * In-house backend of the weight update, selected with conf.lp_solver set to
+ * "SIMPLEX". It solves the reduced linear problem (one row per distinct
+ * comparison vector, see @subpage weight_updater) with a bounded-variable
+ * primal simplex taking advantage of its structure:
+ * - the weights are bounded in [0, 1] and lambda in [0.5, 1], so that the
+ * bounds are handled by the ratio test instead of additional rows,
+ * - the deviation variables (x, x', y, y') of a row only appear in this row. A
+ * basis is thus made of the basic "core" variables (weights and lambda) and of
+ * one deviation variable per row that is not tight. Only the dense square
+ * matrix of the basic core variables on the tight rows, of size at most
+ * n_crit + 1, is factorized, so that an iteration costs O(n_rows * n_crit)
+ * instead of O(n_rows^2) for a full tableau,
+ * - a feasible starting basis is known (the first weight at 1, lambda at 0.5
+ * and in each row the deviation variable absorbing the gap), so that no phase
+ * 1 is needed,
+ * - when a basic deviation reaches 0, the step goes on with the other
+ * deviation of the row as long as the objective decreases (long step ratio
+ * test), instead of a pivot per crossed row,
+ * - the right hand sides are perturbed by less than 1e-8 to break the many
+ * ties between rows, on which the simplex would otherwise stall in degenerate
+ * pivots. The objective value is computed without the perturbation,
+ * - the pricing follows the Dantzig rule, and switches to the Bland rule after
+ * a series of degenerate pivots to avoid cycling.
+ *
+ * The basic values are recomputed from the basis at each iteration rather than
+ * updated, so that no error accumulates along the iterations.
+ */
+class SimplexSolver : public LPSolver {
+public:
+  /**
+   * SimplexSolver standard constructor.
+   *
+   * @param ap AlternativesPerformance objet that represents the dataset of the
+   * problem
+   * @param conf config setup from the app
+   * @param delta value used to transform strict inequalities into non-strict
+   * ones
+   */
+  SimplexSolver(AlternativesPerformance &ap, Config &conf,
+                float delta = 0.000001);
+
+  /** solve Solve the linear problem given the constraint matrix.
+   *
+   * @param x_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the x variables
+   * @param y_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the y variables
+   *
+   * @return results contained in a pair of (lambda, vector of weights)
+   */
+  std::pair<float, std::vector<float>>
+  solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
+        std::vector<std::vector<std::vector<bool>>> y_matrix) override;
+
+  /**
+   * getObjectiveValue getter of the objective value of the solution of the
+   * last solve
+   *
+   * @return objective_value
+   */
+  double getObjectiveValue() const;
+
+  /**
+   * getIterations getter of the number of iterations of the last solve
+   *
+   * @return iterations
+   */
+  int getIterations() const;
+
+private:
+  AlternativesPerformance &ap;
+  Config &conf;
+
+  // value use to transform strict inequalities into non-strict ones
+  float delta;
+
+  double objective_value;
+  int iterations;
+
+  // metrics of the resolutions, registered in conf.metrics
+  Metrics::Histogram &rows_metric;
+  Metrics::Histogram &iterations_metric;
+
+  // problem: row 0 is sum(w) = 1, then one row per distinct x and y vector.
+  // The core variables are w_0..w_n-1 and lambda.
+  int n_core;
+  int n_rows;
+  std::vector<double> coefficients; // n_rows * n_core, row major
+  std::vector<double> rhs;
+  std::vector<double> dev_sign; // coefficient of x (y) in the row, -x' (-y')
+  std::vector<double> dev_cost; // cost of x' (y') in the row, x (y) costs 0
+  std::vector<double> lower;
+  std::vector<double> upper;
+
+  // basis: status of each core variable (-1 at lower bound, 1 at upper bound,
+  // 0 basic) and basic deviation variable of each row (-1 if the row is tight,
+  // 0 for x or y, 1 for x' or y')
+  std::vector<int> core_status;
+  std::vector<int> row_basic;
+
+  // factorization of the basis and current solution
+  std::vector<int> basic_core;
+  std::vector<int> tight_rows;
+  std::vector<double> inverse; // inverse of the core basis matrix, row major
+  std::vector<double> values;  // values of the core variables
+  std::vector<double> dev_values; // value of the basic deviation of each row
+  std::vector<double> duals;
+
+  /** buildProblem sets the rows of the problem and the starting basis.
+   *
+   * @param x_rows distinct rows of the x constraints
+   * @param x_multiplicity number of alternatives of each x row
+   * @param y_rows distinct rows of the y constraints
+   * @param y_multiplicity number of alternatives of each y row
+   */
+  void buildProblem(std::vector<std::vector<bool>> &x_rows,
+                    std::vector<int> &x_multiplicity,
+                    std::vector<std::vector<bool>> &y_rows,
+                    std::vector<int> &y_multiplicity);
+
+  /** factorize computes the inverse of the basis matrix of the basic core
+   * variables on the tight rows, then the values and the duals of the basis.
+   */
+  void factorize();
+
+  /** optimize runs the simplex iterations from the current basis until
+   * optimality.
+   */
+  void optimize();
+
+  /** computeDirection computes B^-1 a for the column a of the entering
+   * variable.
+   *
+   * @param entering index of the entering variable: core variables first, then
+   * two deviation variables per row
+   * @param core_direction filled with the component of each basic core
+   * variable, in the order of basic_core
+   * @param dev_direction filled with the component of the basic deviation
+   * variable of each row
+   */
+  void computeDirection(int entering, std::vector<double> &core_direction,
+                        std::vector<double> &dev_direction);
+};
+
+#endif
@@ -0,0 +1,132 @@
+#ifndef SUBGRADIENTSOLVER_H
+#define SUBGRADIENTSOLVER_H
+
+/**
+ * @file SubgradientSolver.h
+ * @brief First order solver of the weight update problem, without linear
+ * programming.
+ *
+ */
+
+#include "../app.h"
+#include "../types/AlternativesPerformance.h"
+#include "LPSolver.h"
+
+#include <utility>
+#include <vector>
+
+/** @class SubgradientSolver SubgradientSolver.h
+ *  @brief First order solver of the weight update problem, without linear
+ * programming.
+ *
+ * Backend of the weight update selected with conf.lp_solver set to
+ * "SUBGRADIENT". At the optimum of the linear problem (see @subpage
+ * weight_updater), the deviation variables are x'_r = max(0, lambda - a_r.w)
+ * and y'_r = max(0, a_r.w - lambda + delta), so that the problem amounts to
+ * minimizing the convex piecewise linear function
+ *
+ * f(w, lambda) = sum(m_r * x'_r, x rows) + sum(m_r * y'_r, y rows)
+ *
+ * over the simplex of the weights and lambda in [0.5, 1], m_r being the number
+ * of alternatives of the row r. It is minimized by a projected subgradient
+ * method: a fixed number of steps (conf.subgradient_iterations) of decreasing
+ * length along the normalized subgradient, each followed by the euclidean
+ * projection of the weights on the simplex, the best point met being returned.
+ *
+ * Each step costs O(n_rows * n_crit) on the distinct rows of the reduced
+ * problem, stored column by column so that the products with the weights are
+ * plain loops over contiguous arrays. Unlike the LP backends, the solution is
+ * not exactly optimal, but the time of an update is predictable and does not
+ * depend on the degeneracy of the problem.
+ */
+class SubgradientSolver : public LPSolver {
+public:
+  /**
+   * SubgradientSolver standard constructor.
+   *
+   * @param ap AlternativesPerformance objet that represents the dataset of the
+   * problem
+   * @param conf config setup from the app
+   * @param delta value used to transform strict inequalities into non-strict
+   * ones
+   */
+  SubgradientSolver(AlternativesPerformance &ap, Config &conf,
+                    float delta = 0.000001);
+
+  /** solve Minimize the deviations of the linear problem given the constraint
+   * matrix.
+   *
+   * @param x_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the x variables
+   * @param y_matrix matrix recapitulating the constraints to add to the linear
+   * problem for the y variables
+   *
+   * @return results contained in a pair of (lambda, vector of weights)
+   */
+  std::pair<float, std::vector<float>>
+  solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
+        std::vector<std::vector<std::vector<bool>>> y_matrix) override;
+
+  /**
+   * getObjectiveValue getter of the objective value of the solution of the
+   * last solve
+   *
+   * @return objective_value
+   */
+  double getObjectiveValue() const;
+
+  /** projectOnSimplex replaces a vector by its euclidean projection on the
+   * simplex {w >= 0, sum(w) = 1}.
+   *
+   * @param w vector to project
+   */
+  static void projectOnSimplex(std::vector<double> &w);
+
+private:
+  AlternativesPerformance &ap;
+  Config &conf;
+
+  // value use to transform strict inequalities into non-strict ones
+  float delta;
+
+  double objective_value;
+
+  // metrics of the resolutions, registered in conf.metrics
+  Metrics::Histogram &rows_metric;
+
+  // distinct rows: the comparison vectors are stored column by column,
+  // columns[j * n_rows + r] being 1 if the criterion j is in the row r
+  int n_crit;
+  int n_rows;
+  std::vector<double> columns;
+  std::vector<double> row_sign; // -1 for the x rows, 1 for the y rows
+  std::vector<double> row_offset; // 0 for the x rows, delta for the y rows
+  std::vector<double> row_cost; // number of alternatives of the row
+
+  /** buildProblem sets the columns of the distinct rows.
+   *
+   * @param x_rows distinct rows of the x constraints
+   * @param x_multiplicity number of alternatives of each x row
+   * @param y_rows distinct rows of the y constraints
+   * @param y_multiplicity number of alternatives of each y row
+   */
+  void buildProblem(std::vector<std::vector<bool>> &x_rows,
+                    std::vector<int> &x_multiplicity,
+                    std::vector<std::vector<bool>> &y_rows,
+                    std::vector<int> &y_multiplicity);
+
+  /** evaluate computes the objective at a point and a subgradient.
+   *
+   * @param weights weights of the point
+   * @param lambda lambda of the point
+   * @param weight_gradient filled with the subgradient along the weights
+   * @param lambda_gradient set to the subgradient along lambda
+   *
+   * @return objective value
+   */
+  double evaluate(const std::vector<double> &weights, double lambda,
+                  std::vector<double> &weight_gradient,
+                  double &lambda_gradient);
+};
+
+#endif
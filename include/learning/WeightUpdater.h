@@ -12,7 +12,9 @@
 
 #include "../types/AlternativesPerformance.h"
 #include "../types/MRSortModel.h"
-#include "LinearSolver.h"
+#include "LPSolverPool.h"
+
+#include <memory>
 
 /** @class WeightUpdater WeightUpdater.h
  *  @brief Weight and Lambda update heuristic.
@@ -22,9 +24,21 @@
  * with the dataset and can then be used to transform a model into an updated
  * one.
  *
- * The solving of the linear problem is done externally by the LinearSolver. The
- * WeightUpdater class is responsible for computing the constraint matrix given
- * a specific model and passing them to the linear solver.
+ * The solving of the linear problem is done externally by the LPSolver backend
+ * selected by conf.lp_solver. The WeightUpdater class is responsible for
+ * computing the constraint matrix given a specific model and passing them to
+ * the linear solver.
+ *
+ * The backends are leased from a LPSolverPool shared with the copies of the
+ * WeightUpdater, so that a single WeightUpdater can update models from several
+ * threads at once, each solve using a backend no other thread is using.
+ *
+ * When conf.lp_sample_size is set, each weight update only puts a sample of
+ * the alternatives in the linear problem, stratified per category and
+ * optionally focused on the alternatives closest to the majority threshold
+ * (see sampleAlternatives). The constraint matrices are only computed for the
+ * sampled alternatives, and the linear problem only has variables for them.
+ * polishWeightsAndLambda then runs a last update on the whole dataset.
  *
  * A complete description of the heuristic can be found in @subpage
  * weight_updater.
@@ -42,7 +56,8 @@ public:
   WeightUpdater(AlternativesPerformance &ap, Config &conf);
 
   /**
-   * WeightUpdater constructor by copy.
+   * WeightUpdater constructor by copy. The copy shares the pool of linear
+   * solvers.
    *
    * @param wu WeightUpdater objet to copy.
    */
@@ -58,6 +73,34 @@ public:
    */
   void updateWeightsAndLambda(MRSortModel &model);
 
+  /** polishWeightsAndLambda updates the weights and the majority threshold
+   * with all the alternatives of the dataset in the linear problem, whatever
+   * conf.lp_sample_size.
+   *
+   * @param model MRSortModel to update
+   */
+  void polishWeightsAndLambda(MRSortModel &model);
+
+  /** sampleAlternatives draws the conf.lp_sample_size alternatives of the
+   * linear problem of a weight update. The sample is stratified: the size of
+   * the sample of each category is proportional to its number of alternatives
+   * (at least 1). In each category, a share conf.lp_sample_focus of the sample
+   * is made of the alternatives of lowest absolute concordance margin with the
+   * current model, i.e. the closest to the majority threshold on either side,
+   * the rest being drawn uniformly at random. The margin of an alternative is
+   * the lowest of sum(w_j, j in x row) - lambda and lambda - sum(w_j, j in y
+   * row) over its rows, negative when it is misclassified.
+   *
+   * Without focus, the draw takes a time proportional to the sample size. The
+   * focus needs the margin of every alternative of the dataset.
+   *
+   * @param model MRSortModel the margins are computed with
+   *
+   * @return indices of the sampled alternatives in the dataset, in increasing
+   * order
+   */
+  std::vector<int> sampleAlternatives(MRSortModel &model);
+
   /** computexMatrixX Computes linear constraint matrix for x variables. X
    * Constraint matrix are of dimension (n_prof - 1, n_alt, n_crit). In
    * the first dimension, we have the n_prof - 1 profiles of the problem. Inside
@@ -74,6 +117,18 @@ public:
   std::vector<std::vector<std::vector<bool>>>
   computeXMatrix(MRSortModel &model);
 
+  /** computeXMatrix Computes the x constraint matrix of some alternatives of
+   * the dataset only: inside profile h, the rows are those of the given
+   * alternatives, in their order.
+   *
+   * @param model MRSortModel use to compute the x matrix
+   * @param alts indices of the alternatives in the dataset
+   *
+   * @return x_matrix
+   */
+  std::vector<std::vector<std::vector<bool>>>
+  computeXMatrix(MRSortModel &model, const std::vector<int> &alts);
+
   /** computexMatrixY Computes linear constraint matrix for y variables. Y
    * Constraint matrix are of dimension (n_prof - 1, n_alt, n_crit). In
    * the first dimension, we have the n_prof - 1 profiles of the problem. Inside
@@ -90,6 +145,17 @@ public:
   std::vector<std::vector<std::vector<bool>>>
   computeYMatrix(MRSortModel &model);
 
+  /** computeYMatrix Computes the y constraint matrix of some alternatives of
+   * the dataset only, see computeXMatrix.
+   *
+   * @param model MRSortModel use to compute the y matrix
+   * @param alts indices of the alternatives in the dataset
+   *
+   * @return y_matrix
+   */
+  std::vector<std::vector<std::vector<bool>>>
+  computeYMatrix(MRSortModel &model, const std::vector<int> &alts);
+
   /** modelCheck Checks if the profile is suited to be updated with this weight
    * updater: it checks if the criterion in the profile appears in the same
    * order as in the dataset.
@@ -101,9 +167,38 @@ public:
   bool modelCheck(MRSortModel &model);
 
 private:
-  LinearSolver solver;
+  std::shared_ptr<LPSolverPool> solvers;
   AlternativesPerformance &ap;
   Config &conf;
+
+  // time spent solving each linear problem, registered in conf.metrics
+  Metrics::Histogram &solve_time;
+
+  // sampled linear problems only: category rank of each alternative and
+  // alternatives of each category, in increasing rank
+  std::vector<int> alt_ranks;
+  std::vector<std::vector<int>> strata;
+
+  /** concordanceMargin computes the concordance margin of an alternative with
+   * the model, see sampleAlternatives.
+   *
+   * @param model MRSortModel the margin is computed with
+   * @param alt index of the alternative in the dataset
+   *
+   * @return margin, infinity if the alternative has no row
+   */
+  float concordanceMargin(MRSortModel &model, int alt);
+
+  /** solveAndUpdate solves the linear problem of the given constraint matrices
+   * and sets the resulting weights and lambda in the model.
+   *
+   * @param model MRSortModel to update
+   * @param x_matrix x constraint matrix
+   * @param y_matrix y constraint matrix
+   */
+  void solveAndUpdate(MRSortModel &model,
+                      std::vector<std::vector<std::vector<bool>>> &x_matrix,
+                      std::vector<std::vector<std::vector<bool>>> &y_matrix);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef WORKERPROTOCOL_H
+#define WORKERPROTOCOL_H
+
+/**
+ * @file WorkerProtocol.h
+ * @brief Messages exchanged between the coordinator and the workers.
+ *
+ * In distributed mode, several worker processes learn on the same dataset and
+ * exchange their best models through a coordinator process over a Unix domain
+ * socket. Every message is a frame made of a one byte type, a 4 bytes payload
+ * length and the payload. Models are sent in a compact text form.
+ *
+ * Conversation of a worker with the coordinator:
+ * - Hello -> Welcome(worker id, number of workers)
+ * - Post(migrants) -> Ack, the migrants go to the next worker of the ring
+ * - Collect -> Migrants(migrants, possibly none) or Stop
+ * - Done(best model) -> Ack, the worker then disconnects
+ *
+ * The learning server (see LearningServer) answers its clients with the same
+ * frames, the payload of a request being a yaml mapping:
+ * - Learn(dataset, output, parameters) -> Model(xml of the model) or Error
+ * - Predict(model, dataset) -> Assignments("alternative category" lines) or
+ *   Error
+ * - Shutdown -> Ack, the server stops
+ *
+ * A frame whose payload is longer than max_payload_size is rejected, so that a
+ * peer cannot make the other side allocate up to 4 GiB.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../types/MRSortModel.h"
+
+enum class MessageType : uint8_t {
+  Hello = 1,
+  Welcome = 2,
+  Post = 3,
+  Collect = 4,
+  Migrants = 5,
+  Stop = 6,
+  Done = 7,
+  Ack = 8,
+  Learn = 9,
+  Predict = 10,
+  Model = 11,
+  Assignments = 12,
+  Error = 13,
+  Shutdown = 14
+};
+
+/** Largest payload of a frame, in bytes */
+const uint32_t max_payload_size = 64 * 1024 * 1024;
+
+/**
+ * sendMessage writes a complete frame on the socket.
+ *
+ * @param fd socket file descriptor
+ * @param type message type
+ * @param payload message payload
+ *
+ * @throws std::length_error if the payload is longer than max_payload_size
+ */
+void sendMessage(int fd, MessageType type, const std::string &payload = "");
+
+/**
+ * receiveMessage reads a complete frame from the socket.
+ *
+ * @param fd socket file descriptor
+ * @param payload filled with the message payload
+ *
+ * @return message type
+ *
+ * @throws std::length_error if the payload announced by the frame is longer
+ * than max_payload_size, the payload is then left unread
+ */
+MessageType receiveMessage(int fd, std::string &payload);
+
+/**
+ * encodeModels serializes models in the compact text form used by the
+ * protocol. Floats are written with enough digits to be read back exactly.
+ *
+ * @param models models to serialize
+ *
+ * @return encoded models
+ *
+ * @throws std::invalid_argument if an id is empty or holds whitespace, the
+ * fields being separated by spaces
+ */
+std::string encodeModels(const std::vector<MRSortModel> &models);
+
+/**
+ * decodeModels reads models written by encodeModels.
+ *
+ * @param encoded encoded models
+ *
+ * @return models
+ *
+ * @throws std::invalid_argument if the models are malformed, in particular
+ * if a count announces more items than the characters left
+ */
+std::vector<MRSortModel> decodeModels(const std::string &encoded);
+
+#endif
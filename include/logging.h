@@ -0,0 +1,71 @@
+#ifndef LOGGING_H
+#define LOGGING_H
+
+/**
+ * @file logging.h
+ * @brief Logging macros of the app, formatting the messages lazily.
+ *
+ * The messages are given in the fmt syntax, e.g.
+ * FASTPL_DEBUG(conf.logger, "accuracy of model {}: {}", k, score), and are
+ * only formatted when their level is enabled:
+ * - at compile time, the calls below SPDLOG_ACTIVE_LEVEL (LOG_LEVEL option of
+ * CMake, DEBUG by default) are removed from the binaries,
+ * - at runtime, the calls below the level of the logger (log_level of the
+ * config) are skipped before evaluating the arguments of the message.
+ *
+ * A message built over several statements (in a loop) is guarded with
+ * FASTPL_SHOULD_DEBUG, so that nothing is built when it is not logged.
+ */
+
+#include "spdlog/spdlog.h"
+
+/** FASTPL_LOG logs the message if the level is enabled for the logger, the
+ * arguments are not evaluated otherwise */
+#define FASTPL_LOG(logger, level, ...)                                         \
+  do {                                                                         \
+    if ((logger)->should_log(level)) {                                         \
+      SPDLOG_LOGGER_CALL(logger, level, __VA_ARGS__);                          \
+    }                                                                          \
+  } while (0)
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define FASTPL_TRACE(logger, ...)                                              \
+  FASTPL_LOG(logger, spdlog::level::trace, __VA_ARGS__)
+#else
+#define FASTPL_TRACE(logger, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define FASTPL_DEBUG(logger, ...)                                              \
+  FASTPL_LOG(logger, spdlog::level::debug, __VA_ARGS__)
+#else
+#define FASTPL_DEBUG(logger, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define FASTPL_INFO(logger, ...)                                               \
+  FASTPL_LOG(logger, spdlog::level::info, __VA_ARGS__)
+#else
+#define FASTPL_INFO(logger, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define FASTPL_WARN(logger, ...)                                               \
+  FASTPL_LOG(logger, spdlog::level::warn, __VA_ARGS__)
+#else
+#define FASTPL_WARN(logger, ...) (void)0
+#endif
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define FASTPL_ERROR(logger, ...)                                              \
+  FASTPL_LOG(logger, spdlog::level::err, __VA_ARGS__)
+#else
+#define FASTPL_ERROR(logger, ...) (void)0
+#endif
+
+/** FASTPL_SHOULD_DEBUG tells if the debug messages are logged */
+#define FASTPL_SHOULD_DEBUG(logger)                                            \
+  (SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG &&                                \
+   (logger)->should_log(spdlog::level::debug))
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+/**
+ * @file metrics.h
+ * @brief Registry of the counters and histograms measured during a run.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @class Metrics metrics.h
+ * @brief Registry of the counters and histograms measured during a run.
+ *
+ * The metrics are registered by name on first use and live as long as the
+ * registry. Registering goes through a lock, so that the components look their
+ * metrics up once (usually in their constructor) and keep a reference to them:
+ * recording is then lock free (relaxed atomic operations), and can be done from
+ * any thread at a negligible cost compared to the phases it measures.
+ *
+ * At the end of the run, the registry is saved as JSON next to the model
+ * output, see @subpage learning_algorithms.
+ */
+class Metrics {
+public:
+  /** @class Counter metrics.h
+   *  @brief Monotonic count of events.
+   */
+  class Counter {
+  public:
+    /**
+     * add increments the counter
+     *
+     * @param n increment
+     */
+    void add(std::uint64_t n = 1);
+
+    /**
+     * get getter of the value of the counter
+     *
+     * @return value
+     */
+    std::uint64_t get() const;
+
+  private:
+    std::atomic<std::uint64_t> value{0};
+  };
+
+  /** @class Histogram metrics.h
+   *  @brief Distribution of recorded values (latencies in microseconds, sizes)
+   *
+   * The values are counted in buckets of powers of 2: bucket 0 holds 0 and
+   * bucket i > 0 the values in [2^(i-1), 2^i - 1], so that the distribution
+   * of values ranging over several orders of magnitude is kept with a
+   * constant relative precision. The exact count, sum, min and max are kept
+   * besides.
+   */
+  class Histogram {
+  public:
+    static const int n_buckets = 65;
+
+    /**
+     * record adds a value to the distribution
+     *
+     * @param value value to record
+     */
+    void record(std::uint64_t value);
+
+    /**
+     * recordSeconds adds a duration to the distribution, in microseconds
+     *
+     * @param seconds duration to record
+     */
+    void recordSeconds(double seconds);
+
+    /**
+     * getCount getter of the number of recorded values
+     *
+     * @return count
+     */
+    std::uint64_t getCount() const;
+
+    /**
+     * getSum getter of the sum of the recorded values
+     *
+     * @return sum
+     */
+    std::uint64_t getSum() const;
+
+    /**
+     * getMin getter of the smallest recorded value, 0 if none
+     *
+     * @return min
+     */
+    std::uint64_t getMin() const;
+
+    /**
+     * getMax getter of the largest recorded value
+     *
+     * @return max
+     */
+    std::uint64_t getMax() const;
+
+    /**
+     * getBucketCount getter of the number of values recorded in a bucket
+     *
+     * @param bucket index of the bucket
+     *
+     * @return count
+     */
+    std::uint64_t getBucketCount(int bucket) const;
+
+    /**
+     * bucketOf index of the bucket of a value
+     *
+     * @param value value
+     *
+     * @return bucket
+     */
+    static int bucketOf(std::uint64_t value);
+
+  private:
+    std::atomic<std::uint64_t> count{0};
+    std::atomic<std::uint64_t> sum{0};
+    std::atomic<std::uint64_t> min{UINT64_MAX};
+    std::atomic<std::uint64_t> max{0};
+    std::array<std::atomic<std::uint64_t>, n_buckets> buckets{};
+  };
+
+  Metrics();
+
+  Metrics(const Metrics &) = delete;
+  Metrics &operator=(const Metrics &) = delete;
+
+  /**
+   * counter returns the counter of the given name, registered if needed
+   *
+   * @param name name of the counter
+   *
+   * @return counter, valid as long as the registry
+   */
+  Counter &counter(const std::string &name);
+
+  /**
+   * histogram returns the histogram of the given name, registered if needed
+   *
+   * @param name name of the histogram
+   *
+   * @return histogram, valid as long as the registry
+   */
+  Histogram &histogram(const std::string &name);
+
+  /**
+   * toJson serializes the registry, the metrics being sorted by name
+   *
+   * @return json
+   */
+  std::string toJson() const;
+
+  /**
+   * save writes the registry as JSON into a file
+   *
+   * @param file_name path of the file
+   *
+   * @return true if the file was written
+   */
+  bool save(const std::string &file_name) const;
+
+private:
+  mutable std::mutex mutex;
+  std::map<std::string, std::unique_ptr<Counter>> counters;
+  std::map<std::string, std::unique_ptr<Histogram>> histograms;
+};
+
+#endif
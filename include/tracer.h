@@ -0,0 +1,177 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+/**
+ * @file tracer.h
+ * @brief Timeline of the phases of a run, exported as a Chrome trace.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @class Tracer tracer.h
+ * @brief Timeline of the phases of a run, exported as a Chrome trace.
+ *
+ * The phases to trace are wrapped in a Span, which records its name, the model
+ * it works on, its start and its duration when it ends. Each thread records its
+ * spans in its own ring buffer, attached to the thread on its first span: the
+ * recording takes no lock, and when a buffer is full the oldest spans are
+ * overwritten. The buffer of a thread that exited is reused by the next new
+ * thread, so that the threads spawned at each iteration of the pipeline share
+ * the same lanes of the timeline.
+ *
+ * The tracer is disabled by default (conf.trace), a span then only costs the
+ * check of the flag. The timeline is exported as JSON in the Chrome trace
+ * event format, which can be opened in chrome://tracing or in Perfetto. The
+ * export must be done once the traced work is over.
+ */
+class Tracer {
+public:
+  /** @class Span tracer.h
+   *  @brief Phase of the timeline, from the construction to the destruction of
+   *  the span.
+   */
+  class Span {
+  public:
+    /**
+     * Span constructor, starts the span if the tracer is enabled.
+     *
+     * @param tracer tracer recording the span
+     * @param name name of the phase, must outlive the tracer (string literal)
+     * @param model index of the model the phase works on, -1 if none
+     */
+    Span(Tracer &tracer, const char *name, int model = -1)
+        : tracer(tracer.isEnabled() ? &tracer : nullptr), name(name),
+          model(model), start(this->tracer ? tracer.now() : 0) {}
+
+    ~Span() {
+      if (tracer != nullptr) {
+        tracer->record(name, model, start, tracer->now() - start);
+      }
+    }
+
+    Span(const Span &) = delete;
+    Span &operator=(const Span &) = delete;
+
+  private:
+    Tracer *tracer;
+    const char *name;
+    int model;
+    std::int64_t start;
+  };
+
+  /**
+   * Tracer standard constructor, disabled.
+   *
+   * @param capacity number of spans kept per thread
+   */
+  Tracer(int capacity = 65536);
+
+  Tracer(const Tracer &) = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  /**
+   * enable starts or stops the recording of the spans
+   *
+   * @param enabled true to record the spans
+   */
+  void enable(bool enabled = true);
+
+  /**
+   * isEnabled tells if the spans are recorded
+   *
+   * @return enabled
+   */
+  bool isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * now time elapsed since the creation of the tracer
+   *
+   * @return time in nanoseconds
+   */
+  std::int64_t now() const;
+
+  /**
+   * record adds a span to the buffer of the calling thread
+   *
+   * @param name name of the phase
+   * @param model index of the model the phase works on, -1 if none
+   * @param start start of the span, see now
+   * @param duration duration of the span in nanoseconds
+   */
+  void record(const char *name, int model, std::int64_t start,
+              std::int64_t duration);
+
+  /**
+   * getNumberSpans getter of the number of spans kept in the buffers
+   *
+   * @return n_spans
+   */
+  std::uint64_t getNumberSpans() const;
+
+  /**
+   * getNumberDropped getter of the number of spans overwritten in the full
+   * buffers
+   *
+   * @return n_dropped
+   */
+  std::uint64_t getNumberDropped() const;
+
+  /**
+   * toJson exports the spans in the Chrome trace event format, each buffer
+   * being a thread of the timeline
+   *
+   * @return json
+   */
+  std::string toJson() const;
+
+  /**
+   * save writes the Chrome trace into a file
+   *
+   * @param file_name path of the file
+   *
+   * @return true if the file was written
+   */
+  bool save(const std::string &file_name) const;
+
+private:
+  struct Event {
+    const char *name;
+    int model;
+    std::int64_t start;
+    std::int64_t duration;
+  };
+
+  struct Buffer {
+    int tid;
+    std::atomic<bool> in_use{true};
+    std::vector<Event> events; // ring of at most capacity events
+    std::atomic<std::uint64_t> n_recorded{0};
+  };
+
+  /** acquireBuffer attaches a buffer to the calling thread, reusing the one of
+   * an exited thread if any.
+   *
+   * @return buffer
+   */
+  std::shared_ptr<Buffer> acquireBuffer();
+
+  // identifies the tracer in the buffer cache of the threads, never reused
+  const std::uint64_t id;
+  const int capacity;
+  std::atomic<bool> enabled{false};
+  const std::chrono::steady_clock::time_point epoch;
+
+  mutable std::mutex mutex;
+  std::vector<std::shared_ptr<Buffer>> buffers;
+};
+
+#endif
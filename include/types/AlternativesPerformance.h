@@ -10,6 +10,7 @@
 #include "Category.h"
 #include "Criteria.h"
 #include "PerformanceTable.h"
+#include <atomic>
 #include <iostream>
 #include <iterator>
 #include <ostream>
@@ -77,6 +78,18 @@ public:
       const PerformanceTable &perf_table,
       std::unordered_map<std::string, Category> &alt_assignment = default_map);
 
+  /**
+   * AlternativesPerformance constructor using an existing performance table,
+   * with assignments of its alternatives that are not validated
+   *
+   * @param perf_table Performance table to copy
+   * @param alt_assignment Map of alternative assignements to categories,
+   * moved, the alternatives must be in perf_table
+   */
+  AlternativesPerformance(
+      const PerformanceTable &perf_table,
+      std::unordered_map<std::string, Category> &&alt_assignment, Trusted);
+
   /**
    * AlternativesPerformance constructor by copy
    *
@@ -84,6 +97,27 @@ public:
    */
   AlternativesPerformance(const AlternativesPerformance &alt);
 
+  /**
+   * AlternativesPerformance move constructor
+   *
+   * @param alt alternatives performances to move, left empty
+   */
+  AlternativesPerformance(AlternativesPerformance &&alt) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param alt alternatives performances to copy
+   */
+  AlternativesPerformance &operator=(const AlternativesPerformance &alt);
+
+  /**
+   * Move assignment operator
+   *
+   * @param alt alternatives performances to move, left empty
+   */
+  AlternativesPerformance &operator=(AlternativesPerformance &&alt) noexcept;
+
   ~AlternativesPerformance();
 
   friend std::ostream &operator<<(std::ostream &out,
@@ -92,9 +126,11 @@ public:
   /**
    * getAlternativesPerformanceMap getter of the alternatives assignments
    *
-   * @return alt_assignment_
+   * @return alt_assignment_, without copy: the reference is invalidated by the
+   * next change of the assignments
    */
-  std::unordered_map<std::string, Category> getAlternativesAssignments() const;
+  const std::unordered_map<std::string, Category> &
+  getAlternativesAssignments() const;
 
   // TODO Remove getter and setter
   // Performance wise after some profiling we found that getter and setter can
@@ -114,7 +150,7 @@ public:
    * @param altName name of the alternative of which the assignment is requested
    * @return assignment of the alternative
    */
-  Category getAlternativeAssignment(std::string altName) const;
+  const Category &getAlternativeAssignment(const std::string &altName) const;
 
   /**
    * setAlternative getter of the assignment of one specified alternative
@@ -122,7 +158,7 @@ public:
    * @param altName name of the alternative the category will be assigned to
    * @param cat category to assign
    */
-  void setAlternativeAssignment(std::string altName, Category &cat);
+  void setAlternativeAssignment(const std::string &altName, Category &cat);
 
   /**
    * getNumberCats compute the number of unique category in the dataset
@@ -140,12 +176,33 @@ public:
    */
   std::pair<float, float> getBoundaries();
 
+  /**
+   * getNumberCopies counts the copies of a performance table made by the
+   * AlternativesPerformance constructors, including the Trusted one that
+   * copies the table it is given the assignments of, and by its copy
+   * assignment, since the start of the program
+   *
+   * @return n_copies
+   */
+  static long getNumberCopies();
+
 private:
+  /**
+   * checkAssignments throws if an alternative of the map is not in the
+   * performance table, in O(n_alt)
+   *
+   * @param alt_assignment assignment map
+   */
+  void checkAssignments(
+      const std::unordered_map<std::string, Category> &alt_assignment) const;
+
   // TODO: Memory could be optimize here, there is no need to store the Category
   // object, we could use a reference instead.
 
   // Hashmap: key = Alternative Name, value = Category
   std::unordered_map<std::string, Category> alt_assignment_;
+
+  static std::atomic<long> n_copies_;
 };
 
 #endif
\ No newline at end of file
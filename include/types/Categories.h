@@ -49,6 +49,27 @@ public:
    * @param number_of_categories number of categories wanted
    */
   Categories(const Categories &categories);
+
+  /**
+   * Categories move constructor
+   *
+   * @param categories categories to move, left empty
+   */
+  Categories(Categories &&categories) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param categories categories to copy
+   */
+  Categories &operator=(const Categories &categories);
+
+  /**
+   * Move assignment operator
+   *
+   * @param categories categories to move, left empty
+   */
+  Categories &operator=(Categories &&categories) noexcept;
   ~Categories();
 
   // TODO looks like this could be removed as it is never used
@@ -135,8 +156,7 @@ public:
    *
    *@return Category object at index position of Categories object
    */
-  Category operator[](int index);
-  Category operator[](int index) const;
+  const Category &operator[](int index) const;
 
 private:
   std::vector<Category> categories_vector_;
@@ -0,0 +1,169 @@
+#ifndef COLUMNARDATASET_H
+#define COLUMNARDATASET_H
+
+/**
+ * @file ColumnarDataset.h
+ * @brief Dataset kept on disk in a memory mapped columnar file.
+ *
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "AlternativesPerformance.h"
+#include "MRSortModel.h"
+
+/** @class ColumnarDataset ColumnarDataset.h
+ * @brief Dataset kept on disk in a memory mapped columnar file.
+ *
+ * The columnar file holds the performances of the alternatives criterion by
+ * criterion (one contiguous float column per criterion), their expected
+ * category and their names. It is mapped read-only in memory: the pages are
+ * loaded by the system when they are read and can be dropped at any time, so
+ * that a dataset larger than the RAM can be used without holding it in
+ * AlternativesPerformance objects.
+ *
+ * Only samples of the dataset are materialized as AlternativesPerformance to
+ * run the learning, the accuracy of a model on the whole dataset being
+ * computed by streaming over the columns in blocks of alternatives. The
+ * passes of the learning itself (assignments, concordances, accuracy) run on
+ * the materialized sample and do not read the columns. The file
+ * is written once from a loaded dataset (see write) and reused by the next
+ * runs.
+ */
+class ColumnarDataset {
+public:
+  /**
+   * ColumnarDataset constructor, maps the file in memory.
+   *
+   * @param file_name path of the columnar file
+   */
+  ColumnarDataset(const std::string &file_name);
+
+  ColumnarDataset(const ColumnarDataset &) = delete;
+  ColumnarDataset &operator=(const ColumnarDataset &) = delete;
+
+  ~ColumnarDataset();
+
+  /**
+   * write saves a dataset as a columnar file, copying it only if it is in
+   * crit mode
+   *
+   * @param ap dataset to save
+   * @param file_name path of the columnar file
+   */
+  static void write(const AlternativesPerformance &ap,
+                    const std::string &file_name);
+
+  /**
+   * getNumberAlt getter of the number of alternatives
+   *
+   * @return n_alt
+   */
+  std::int64_t getNumberAlt() const;
+
+  /**
+   * getNumberCrit getter of the number of criteria
+   *
+   * @return n_crit
+   */
+  int getNumberCrit() const;
+
+  /**
+   * getCriteriaIds getter of the ids of the criteria, in the order of the
+   * columns
+   *
+   * @return crit_ids
+   */
+  const std::vector<std::string> &getCriteriaIds() const;
+
+  /**
+   * getAltName getter of the name of an alternative
+   *
+   * @param alt index of the alternative
+   *
+   * @return name
+   */
+  std::string getAltName(std::int64_t alt) const;
+
+  /**
+   * getColumn getter of the performances of the alternatives on a criterion
+   *
+   * @param crit index of the criterion
+   *
+   * @return n_alt performances
+   */
+  const float *getColumn(int crit) const;
+
+  /**
+   * getRanks getter of the rank of the expected category of the alternatives,
+   * -1 if unassigned
+   *
+   * @return n_alt ranks
+   */
+  const std::int32_t *getRanks() const;
+
+  /**
+   * sample draws alternatives uniformly without replacement
+   *
+   * @param n_sample number of alternatives, all of them if greater than the
+   * dataset
+   * @param seed seed of the random generator
+   *
+   * @return indexes of the alternatives, in ascending order
+   */
+  std::vector<std::int64_t> sample(std::int64_t n_sample,
+                                   unsigned long int seed) const;
+
+  /**
+   * materialize loads alternatives of the dataset in memory
+   *
+   * @param alts indexes of the alternatives
+   *
+   * @return alternatives with their expected category
+   */
+  AlternativesPerformance
+  materialize(const std::vector<std::int64_t> &alts) const;
+
+  /**
+   * computeAccuracy computes the share of the alternatives of the whole
+   * dataset assigned to their expected category by the model, in blocks of
+   * alternatives
+   *
+   * @param model model to evaluate, with profiles in alt mode
+   * @param block_size number of alternatives assigned at once
+   *
+   * @return accuracy
+   */
+  float computeAccuracy(MRSortModel &model, int block_size = 4096) const;
+
+private:
+  /**
+   * readLayout locates the parts of the mapped file
+   *
+   */
+  void readLayout();
+
+  /**
+   * unmap releases the mapping and the file
+   *
+   */
+  void unmap();
+
+  std::string file_name;
+  int fd;
+  void *data;
+  std::size_t size;
+
+  std::int64_t n_alt;
+  int n_crit;
+  std::vector<std::string> crit_ids;
+  std::vector<std::string> cat_ids; // id of the categories, by rank
+  const std::uint64_t *name_offsets;
+  const char *names;
+  const std::int32_t *ranks;
+  std::vector<const float *> columns;
+};
+
+#endif
@@ -9,6 +9,8 @@
 
 #include "Criterion.h"
 #include <iostream>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 /** @class Criteria Criteria.h
@@ -20,6 +22,10 @@
  * It is used to represents all the criterion defined in a dataset. Each
  * criterion is independent from the other, and no order should be implied in
  * the vector.
+ *
+ * The weights are also stored in a contiguous vector, in the order of the
+ * criteria, and the index of each criterion is stored by id, so that the
+ * weight of a criterion is read without copying nor comparing the criteria.
  */
 
 class Criteria {
@@ -46,6 +52,27 @@ public:
    */
   Criteria(const Criteria &crits);
 
+  /**
+   * Criteria move constructor
+   *
+   * @param crits criteria to move, left empty
+   */
+  Criteria(Criteria &&crits) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param crits criteria to copy
+   */
+  Criteria &operator=(const Criteria &crits);
+
+  /**
+   * Move assignment operator
+   *
+   * @param crits criteria to move, left empty
+   */
+  Criteria &operator=(Criteria &&crits) noexcept;
+
   ~Criteria();
 
   friend std::ostream &operator<<(std::ostream &out, const Criteria &crits);
@@ -66,7 +93,7 @@ public:
    *
    * @return criterion_vect_
    */
-  std::vector<Criterion> getCriterionVect() const;
+  const std::vector<Criterion> &getCriterionVect() const;
 
   // TODO looks like this could be removed as it is never used
   /**
@@ -97,7 +124,25 @@ public:
    *
    * @return get_weights
    */
-  std::vector<float> getWeights() const;
+  const std::vector<float> &getWeights() const;
+
+  /**
+   * getIndex returns the index of a criterion in the Criteria structure
+   *
+   * @param name id of the criterion
+   *
+   * @return index
+   */
+  int getIndex(const std::string &name) const;
+
+  /**
+   * getWeight returns the weight of a criterion
+   *
+   * @param name id of the criterion
+   *
+   * @return weight
+   */
+  float getWeight(const std::string &name) const;
 
   /**
    * Set new weights in the Criteria object
@@ -139,7 +184,16 @@ public:
   Criterion operator[](int index) const;
 
 private:
+  /**
+   * indexCriteria builds the weight vector and the index of the criteria
+   *
+   */
+  void indexCriteria();
+
   std::vector<Criterion> criterion_vect_;
+  // weights and indexes of the criteria, in sync with criterion_vect_
+  std::vector<float> weights_;
+  std::unordered_map<std::string, int> index_;
 };
 
 #endif
\ No newline at end of file
@@ -64,6 +64,27 @@ public:
    * @param mrsort MRSortModel object to copy
    */
   MRSortModel(const MRSortModel &mrsort);
+
+  /**
+   * MRSortModel move constructor
+   *
+   * @param mrsort model to move, left empty
+   */
+  MRSortModel(MRSortModel &&mrsort) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param mrsort model to copy
+   */
+  MRSortModel &operator=(const MRSortModel &mrsort);
+
+  /**
+   * Move assignment operator
+   *
+   * @param mrsort model to move, left empty
+   */
+  MRSortModel &operator=(MRSortModel &&mrsort) noexcept;
   ~MRSortModel();
 
   friend std::ostream &operator<<(std::ostream &out, const MRSortModel &mrsort);
@@ -100,11 +121,15 @@ public:
    *
    * @param alt PerfVect of the alternative
    * @param profiles_pt PerfTable of the profiles
+   * @param aligned the alternative and the profiles are aligned with the
+   * criteria of the model (see isAligned)
    *
    * @return category_assignment Category object associated to the alternative
    */
-  Category categoryAssignment(std::vector<Perf> &alt,
-                              std::vector<std::vector<Perf>> &profiles_pt);
+  Category
+  categoryAssignment(const std::vector<Perf> &alt,
+                     const std::vector<std::vector<Perf>> &profiles_pt,
+                     bool aligned = false);
 
   /**
    * categoryAssignments assign the categories given the performance table
@@ -117,16 +142,56 @@ public:
    */
   AlternativesPerformance categoryAssignments(PerformanceTable &pt);
 
+  /**
+   * categoryAssignments assign the categories given the performance table
+   * and the current state of the model, in an AlternativesPerformance of the
+   * same alternatives given by a previous call, so that pt is not copied
+   * again.
+   *
+   * @param pt PerformanceTable
+   * @param altPerf_model AlternativesPerformance whose assignments are
+   * replaced
+   */
+  void categoryAssignments(PerformanceTable &pt,
+                           AlternativesPerformance &altPerf_model);
+
   /**
    * computeConcordance computes the concordance value between a profile and an
    * alternative
    *
    * @param prof profile
    * @param alt alternative
+   * @param aligned the profile and the alternative are aligned with the
+   * criteria of the model (see isAligned): the weights are read by index,
+   * otherwise by criterion id
    *
    * @return concordance value
    */
-  float computeConcordance(std::vector<Perf> &prof, std::vector<Perf> &alt);
+  float computeConcordance(const std::vector<Perf> &prof,
+                           const std::vector<Perf> &alt, bool aligned = false);
+
+  /**
+   * isAligned tells if a row has the performances of the criteria of the
+   * model, in their order
+   *
+   * @param row performances of an alternative or of a profile
+   *
+   * @return true if aligned
+   */
+  bool isAligned(const std::vector<Perf> &row) const;
+
+  /**
+   * isAligned tells if the profiles and the alternatives of a table in alt
+   * mode are aligned with the criteria of the model. The rows of a table
+   * having their criteria in the same order, only its first one is checked.
+   *
+   * @param profiles_pt PerfTable of the profiles
+   * @param pt performance table in alt mode
+   *
+   * @return true if aligned
+   */
+  bool isAligned(const std::vector<std::vector<Perf>> &profiles_pt,
+                 const PerformanceTable &pt) const;
 
   /**
    * computeConcordanceTable computes the concordance table of a performance
@@ -33,9 +33,20 @@
  * This datastructure was designed to be itterated over easily, thus the access
  * time of a certain element (like in a hashmap) is in O(n_crit * n_alt) which
  * is absolutely inefficient and should be avoided.
+ *
+ * The tables given by the user are validated once, when they are built, in
+ * O(n_crit * n_alt). The copies of a table are not validated again, and the
+ * assignments built by the library for the alternatives of a validated table
+ * skip their validation with the Trusted constructor of
+ * AlternativesPerformance.
  */
 class PerformanceTable {
 public:
+  /** Trusted selects the constructors of the derived tables that do not
+   * validate their input, built by the library from tables already
+   * validated. */
+  struct Trusted {};
+
   /**
    * PerformanceTable constructor with defined vector of performance that
    * represents the PerformanceTable in a certain mode. All Vector of Perf
@@ -65,6 +76,27 @@ public:
    */
   PerformanceTable(const PerformanceTable &perfs);
 
+  /**
+   * PerformanceTable move constructor
+   *
+   * @param perfs performances to move, left empty
+   */
+  PerformanceTable(PerformanceTable &&perfs) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param perfs performances to copy
+   */
+  PerformanceTable &operator=(const PerformanceTable &perfs);
+
+  /**
+   * Move assignment operator
+   *
+   * @param perfs performances to move, left empty
+   */
+  PerformanceTable &operator=(PerformanceTable &&perfs) noexcept;
+
   ~PerformanceTable();
 
   /**
@@ -87,9 +119,10 @@ public:
   /**
    * getPerformanceTable getter of performance table parameter
    *
-   * @return performance_table
+   * @return performance_table, without copy: the reference is invalidated by
+   * the next change of the table
    */
-  std::vector<std::vector<Perf>> getPerformanceTable() const;
+  const std::vector<std::vector<Perf>> &getPerformanceTable() const;
 
   /**
    * getMode getter of the mode of the performance table
@@ -113,9 +146,10 @@ public:
    *
    * @param name name of the row we want to search
    *
-   *@return Performance object with associated criterion
+   *@return Performance object with associated criterion, without copy: the
+   *reference is invalidated by the next change of the table
    */
-  std::vector<Perf> operator[](std::string name);
+  const std::vector<Perf> &operator[](const std::string &name) const;
 
   /**
    * getPerf getter of a specific Perf in the performance table. This is highly
@@ -199,13 +233,14 @@ public:
   std::vector<Perf> getWorstPerfByCrit(Criteria &crits);
 
   /**
-   * findAlt return true if the alternative is in the performance table
+   * isAltInTable return true if the alternative is in the performance table,
+   * in both modes
    *
    * @param altName Alternative to lookup
    *
    * @return true if found, false if nots
    */
-  bool isAltInTable(std::string altName);
+  bool isAltInTable(const std::string &altName) const;
 
   /**
 
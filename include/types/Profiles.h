@@ -73,6 +73,27 @@ public:
    */
   Profiles(const Profiles &profiles);
 
+  /**
+   * Profiles move constructor
+   *
+   * @param profiles profiles to move, left empty
+   */
+  Profiles(Profiles &&profiles) noexcept;
+
+  /**
+   * Copy assignment operator
+   *
+   * @param profiles profiles to copy
+   */
+  Profiles &operator=(const Profiles &profiles);
+
+  /**
+   * Move assignment operator
+   *
+   * @param profiles profiles to move, left empty
+   */
+  Profiles &operator=(Profiles &&profiles) noexcept;
+
   ~Profiles(){};
 
   /**
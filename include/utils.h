@@ -174,8 +174,9 @@ inline std::vector<std::string> getCriterionIds(std::vector<Perf> vectPerf) {
  *
  * @return Perf for given critId
  */
-inline Perf getPerfOfCrit(std::vector<Perf> &vectPerf, std::string critId) {
-  for (Perf &p : vectPerf) {
+inline Perf getPerfOfCrit(const std::vector<Perf> &vectPerf,
+                          std::string critId) {
+  for (const Perf &p : vectPerf) {
     if (p.crit_ == critId) {
       return p;
     }
@@ -247,7 +248,7 @@ inline std::vector<Perf> createVectorPerfWithNoPerf(std::string id,
  * @param p vector of Perf objects
  *
  */
-inline std::vector<double> getPerfFromPerfVect(std::vector<Perf> &p) {
+inline std::vector<double> getPerfFromPerfVect(const std::vector<Perf> &p) {
   std::vector<double> values;
   for (auto perf : p) {
     values.push_back(static_cast<double>(perf.value_));
@@ -292,7 +293,7 @@ inline void plotGlobalData(AlternativesPerformance &ap) {
   std::vector<std::vector<double>> performances;
   std::unordered_map<int, int> index;
   int nbCriteria = 0;
-  for (std::vector<Perf> &p : ap.getPerformanceTable()) {
+  for (const std::vector<Perf> &p : ap.getPerformanceTable()) {
     int rank = map[p[0].name_].rank_;
     if (nbCriteria == 0)
       nbCriteria = p.size();
@@ -357,7 +358,7 @@ inline void plotProfile(Profiles &p) {
   // }
 
   std::vector<std::vector<double>> prof_performances;
-  for (std::vector<Perf> &perf : p.getPerformanceTable()) {
+  for (const std::vector<Perf> &perf : p.getPerformanceTable()) {
     prof_performances.push_back(getPerfFromPerfVect(perf));
   }
   std::vector<double> x(prof_performances[0].size());
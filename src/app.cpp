@@ -1,14 +1,24 @@
+#include "spdlog/async.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/spdlog.h"
 #include "yaml-cpp/yaml.h"
 
 #include "../include/app.h"
+#include "../include/batch.h"
+#include "../include/learning/Coordinator.h"
 #include "../include/learning/HeuristicPipeline.h"
+#include "../include/learning/IslandPipeline.h"
+#include "../include/learning/LearningServer.h"
+#include "../include/learning/RemoteMailbox.h"
 #include "../include/types/AlternativesPerformance.h"
 #include "../include/types/DataGenerator.h"
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 
 void App::initializeLogger(YAML::Node &yml_conf) {
 
@@ -16,7 +26,21 @@ void App::initializeLogger(YAML::Node &yml_conf) {
   if (yml_conf["log_file"]) {
     conf.log_file = yml_conf["log_file"].as<std::string>();
   }
-  conf.logger = spdlog::basic_logger_mt("app_logger", conf.log_file);
+  if (yml_conf["log_queue_size"]) {
+    conf.log_queue_size = yml_conf["log_queue_size"].as<int>();
+  }
+  if (conf.log_queue_size < 0) {
+    throw std::invalid_argument("The log queue size must be >= 0");
+  }
+  if (conf.log_queue_size > 0) {
+    // the messages are written by a background thread, when the queue is full
+    // the oldest ones are dropped so that the workers never wait on the logger
+    spdlog::init_thread_pool(conf.log_queue_size, 1);
+    conf.logger = spdlog::create_async_nb<spdlog::sinks::basic_file_sink_mt>(
+        "app_logger", conf.log_file);
+  } else {
+    conf.logger = spdlog::basic_logger_mt("app_logger", conf.log_file);
+  }
 
   if (yml_conf["log_level"].as<std::string>() == "DEBUG") {
     spdlog::set_level(spdlog::level::debug);
@@ -32,22 +56,98 @@ void App::initializeLogger(YAML::Node &yml_conf) {
   } else {
     spdlog::set_level(spdlog::level::info);
   }
-  conf.logger->flush_on(spdlog::level::info);
+  // flushing on every message would serialize the threads on the file
+  conf.logger->flush_on(spdlog::level::warn);
+  spdlog::flush_every(std::chrono::seconds(1));
 }
 
-void App::extractConfig(YAML::Node &yml_conf) {
+void App::readParameters(YAML::Node &yml_conf, Config &config) {
   if (yml_conf["data_dir"]) {
-    conf.data_dir = yml_conf["data_dir"].as<std::string>();
+    config.data_dir = yml_conf["data_dir"].as<std::string>();
   }
   if (yml_conf["model_batch_size"]) {
-    conf.model_batch_size = yml_conf["model_batch_size"].as<int>();
+    config.model_batch_size = yml_conf["model_batch_size"].as<int>();
   }
   if (yml_conf["max_iterations"]) {
-    conf.max_iterations = yml_conf["max_iterations"].as<int>();
+    config.max_iterations = yml_conf["max_iterations"].as<int>();
   }
   if (yml_conf["n_profile_update"]) {
-    conf.n_profile_update = yml_conf["n_profile_update"].as<int>();
+    config.n_profile_update = yml_conf["n_profile_update"].as<int>();
+  }
+  if (yml_conf["target_accuracy"]) {
+    config.target_accuracy = yml_conf["target_accuracy"].as<float>();
+  }
+  if (yml_conf["max_stale_iterations"]) {
+    config.max_stale_iterations = yml_conf["max_stale_iterations"].as<int>();
+  }
+  if (yml_conf["time_budget_seconds"]) {
+    config.time_budget_seconds = yml_conf["time_budget_seconds"].as<float>();
+  }
+  if (yml_conf["min_diversity"]) {
+    config.min_diversity = yml_conf["min_diversity"].as<float>();
+  }
+  if (yml_conf["checkpoint_interval_seconds"]) {
+    config.checkpoint_interval_seconds =
+        yml_conf["checkpoint_interval_seconds"].as<float>();
+  }
+  if (yml_conf["rank_encoding"]) {
+    config.rank_encoding = yml_conf["rank_encoding"].as<bool>();
+  }
+  if (yml_conf["reduce_lp"]) {
+    config.reduce_lp = yml_conf["reduce_lp"].as<bool>();
+  }
+  if (yml_conf["lp_solver"]) {
+    config.lp_solver = yml_conf["lp_solver"].as<std::string>();
+  }
+  if (yml_conf["lp_dump"]) {
+    config.lp_dump = yml_conf["lp_dump"].as<std::string>();
+  }
+  if (yml_conf["subgradient_iterations"]) {
+    config.subgradient_iterations =
+        yml_conf["subgradient_iterations"].as<int>();
+  }
+  if (yml_conf["lp_sample_size"]) {
+    config.lp_sample_size = yml_conf["lp_sample_size"].as<int>();
+  }
+  if (yml_conf["lp_sample_focus"]) {
+    config.lp_sample_focus = yml_conf["lp_sample_focus"].as<float>();
+  }
+  if (yml_conf["out_of_core_sample"]) {
+    config.out_of_core_sample = yml_conf["out_of_core_sample"].as<int>();
+  }
+  if (yml_conf["n_threads"]) {
+    config.n_threads = yml_conf["n_threads"].as<int>();
+  }
+  if (yml_conf["n_jobs"]) {
+    config.n_jobs = yml_conf["n_jobs"].as<int>();
+  }
+  if (yml_conf["n_islands"]) {
+    config.n_islands = yml_conf["n_islands"].as<int>();
+  }
+  if (yml_conf["migration_interval"]) {
+    config.migration_interval = yml_conf["migration_interval"].as<int>();
+  }
+  if (yml_conf["n_migrants"]) {
+    config.n_migrants = yml_conf["n_migrants"].as<int>();
   }
+  if (yml_conf["coordinator_socket"]) {
+    config.coordinator_socket =
+        yml_conf["coordinator_socket"].as<std::string>();
+  }
+  if (yml_conf["server_socket"]) {
+    config.server_socket = yml_conf["server_socket"].as<std::string>();
+  }
+  if (yml_conf["save_metrics"]) {
+    config.save_metrics = yml_conf["save_metrics"].as<bool>();
+  }
+  if (yml_conf["trace"]) {
+    config.trace = yml_conf["trace"].as<bool>();
+  }
+}
+
+void App::extractConfig(YAML::Node &yml_conf) {
+  readParameters(yml_conf, conf);
+  conf.tracer->enable(conf.trace);
   this->initializeLogger(yml_conf);
 }
 
@@ -56,7 +156,15 @@ void App::showUsage(std::string name) {
             << "Options:\n"
             << "\t-h,--help\t\tShow this help message\n"
             << "\t-d,--dataset DATASET\tDataset file path\n"
-            << "\t-o,--output OUTPUT\tModel output file path" << std::endl;
+            << "\t-o,--output OUTPUT\tModel output file path\n"
+            << "\t-c,--coordinator N\tCoordinate N worker processes and "
+               "save the best model in OUTPUT\n"
+            << "\t-w,--worker\t\tLearn DATASET as a worker of a coordinator\n"
+            << "\t-b,--batch MANIFEST\tLearn the datasets listed in "
+               "MANIFEST, each in its own output\n"
+            << "\t-s,--server\t\tServe learn and predict requests on "
+               "the server socket"
+            << std::endl;
 }
 
 int App::parseArgs(int argc, char *argv[]) {
@@ -83,14 +191,81 @@ int App::parseArgs(int argc, char *argv[]) {
         std::cerr << "--output option requires one argument." << std::endl;
         return 1;
       }
+    } else if ((arg == "-c") || (arg == "--coordinator")) {
+      if (i + 1 < argc) {
+        i++;
+        // "abc", "2x" or a number out of the int range are rejected too
+        int n_workers = 0;
+        try {
+          std::size_t end;
+          n_workers = std::stoi(argv[i], &end);
+          if (argv[i][end] != '\0') {
+            n_workers = 0;
+          }
+        } catch (const std::logic_error &) {
+          n_workers = 0;
+        }
+        if (n_workers <= 0) {
+          std::cerr << "\n--coordinator option requires a number of workers "
+                       ">= 1.\n"
+                    << std::endl;
+          showUsage(argv[0]);
+          return 1;
+        }
+        conf.n_workers = n_workers;
+      } else {
+        std::cerr << "--coordinator option requires one argument."
+                  << std::endl;
+        return 1;
+      }
+    } else if ((arg == "-w") || (arg == "--worker")) {
+      conf.worker = true;
+    } else if ((arg == "-b") || (arg == "--batch")) {
+      if (i + 1 < argc) {
+        i++;
+        std::string batch = argv[i];
+        conf.batch = batch;
+      } else {
+        std::cerr << "--batch option requires one argument." << std::endl;
+        return 1;
+      }
+    } else if ((arg == "-s") || (arg == "--server")) {
+      conf.server = true;
     }
   }
-  if (conf.dataset == "") {
+  if (conf.server && (conf.batch != "" || conf.n_workers > 0 || conf.worker)) {
+    std::cerr << "\n--server cannot be used in batch or distributed mode.\n"
+              << std::endl;
+    showUsage(argv[0]);
+    return 1;
+  }
+  // the requests give the datasets and the outputs
+  if (conf.server) {
+    return -1;
+  }
+  if (conf.batch != "" && (conf.n_workers > 0 || conf.worker)) {
+    std::cerr << "\n--batch cannot be used in distributed mode.\n"
+              << std::endl;
+    showUsage(argv[0]);
+    return 1;
+  }
+  // the manifest gives the dataset and the output of each job
+  if (conf.batch != "") {
+    return -1;
+  }
+  if (conf.n_workers > 0 && conf.worker) {
+    std::cerr << "\n--coordinator and --worker are exclusive.\n" << std::endl;
+    showUsage(argv[0]);
+    return 1;
+  }
+  // the coordinator does not read the dataset and the workers do not save
+  // their model, the coordinator does
+  if (conf.dataset == "" && conf.n_workers == 0) {
     std::cerr << "\n--dataset option is required.\n" << std::endl;
     showUsage(argv[0]);
     return 1;
   }
-  if (conf.output == "") {
+  if (conf.output == "" && !conf.worker) {
     std::cerr << "\n--output option is required.\n" << std::endl;
     showUsage(argv[0]);
     return 1;
@@ -103,15 +278,104 @@ App::App() {}
 
 Config App::getConf() const { return conf; }
 
+MRSortModel App::learn(AlternativesPerformance &dataset,
+                       std::shared_ptr<const AssignmentKernel> kernel) {
+  if (conf.n_islands > 1) {
+    IslandPipeline ip = IslandPipeline(conf, dataset, std::move(kernel));
+    return ip.start();
+  }
+  HeuristicPipeline hp = HeuristicPipeline(conf, dataset, std::move(kernel));
+  return hp.start();
+}
+
+std::unique_ptr<ColumnarDataset> App::openColumnarDataset() {
+  std::string columns_path = conf.data_dir + conf.dataset + ".columns";
+  if (!std::filesystem::exists(columns_path)) {
+    // the dataset is only loaded in memory for the conversion
+    DataGenerator dg = DataGenerator(conf);
+    AlternativesPerformance dataset = dg.loadDataset(conf.dataset);
+    ColumnarDataset::write(dataset, columns_path);
+    conf.logger->info("Columnar dataset written in " + columns_path);
+  }
+  return std::make_unique<ColumnarDataset>(columns_path);
+}
+
+void App::saveMetrics() {
+  if (!conf.save_metrics) {
+    return;
+  }
+  std::string metrics_path = conf.data_dir + conf.output + ".metrics.json";
+  if (conf.metrics->save(metrics_path)) {
+    conf.logger->info("Metrics saved in " + metrics_path);
+  } else {
+    conf.logger->warn("Cannot save the metrics in " + metrics_path);
+  }
+}
+
+void App::saveTrace() {
+  if (!conf.trace) {
+    return;
+  }
+  std::string trace_path = conf.data_dir + conf.output + ".trace.json";
+  if (conf.tracer->save(trace_path)) {
+    conf.logger->info("Trace saved in " + trace_path);
+  } else {
+    conf.logger->warn("Cannot save the trace in " + trace_path);
+  }
+}
+
+int App::runBatch() {
+  int n_failed;
+  try {
+    Batch batch = Batch(conf, conf.batch);
+    n_failed = batch.run();
+  } catch (const std::exception &e) {
+    std::cerr << "Cannot run the batch: " << e.what() << std::endl;
+    conf.logger->error(std::string("Cannot run the batch: ") + e.what());
+    return 1;
+  }
+  if (n_failed > 0) {
+    conf.logger->error(std::to_string(n_failed) +
+                       " job(s) of the batch failed");
+    return 1;
+  }
+  conf.logger->info("App terminated");
+  return 0;
+}
+
+int App::runServer() {
+  try {
+    LearningServer server = LearningServer(conf);
+    server.serve();
+  } catch (const std::exception &e) {
+    std::cerr << "Cannot run the server: " << e.what() << std::endl;
+    conf.logger->error(std::string("Cannot run the server: ") + e.what());
+    return 1;
+  }
+  conf.logger->info("App terminated");
+  return 0;
+}
+
 int App::run() {
   conf.logger->info("Starting...");
+  if (conf.batch != "") {
+    return this->runBatch();
+  }
+  if (conf.server) {
+    return this->runServer();
+  }
   DataGenerator dg = DataGenerator(conf);
   std::string data_path = conf.data_dir + conf.dataset;
   std::string model_path = conf.data_dir + conf.output;
 
-  // verify dataset exists at given path
+  // verify dataset exists at given path, the out-of-core mode only needs its
+  // columnar copy
   std::filesystem::path data_f{data_path};
-  if (!std::filesystem::exists(data_f)) {
+  bool data_found =
+      std::filesystem::exists(data_f) ||
+      (conf.out_of_core_sample > 0 &&
+       std::filesystem::exists(data_path + ".columns"));
+  if (conf.n_workers == 0 && !data_found) {
     std::cerr << "No file found in dataset path: " << data_path << std::endl;
     conf.logger->error("No file found in data set path.");
     return 1;
@@ -125,21 +389,68 @@ int App::run() {
     }
   }
   std::filesystem::path model_f{directory_models};
-  if (!std::filesystem::exists(model_f)) {
+  if (!conf.worker && !std::filesystem::exists(model_f)) {
     std::cerr << "No directory found for output at: " << directory_models
               << std::endl;
     conf.logger->error("No directory found for output.");
     return 1;
   }
 
-  AlternativesPerformance dataset = dg.loadDataset(data_path);
+  if (conf.n_workers > 0) {
+    // the workers do the learning, only keep the best model they report
+    Coordinator coordinator = Coordinator(conf);
+    MRSortModel opti = coordinator.serve();
+    conf.logger->info("Saving models...");
+    dg.saveModel(conf.output, opti.lambda, opti.criteria, opti.profiles, true,
+                 opti.getId());
+    this->saveMetrics();
+    this->saveTrace();
+    conf.logger->info("App terminated");
+    return 0;
+  }
+
+  // out-of-core mode: the dataset stays on disk, the learning runs on a sample
+  std::unique_ptr<ColumnarDataset> columns;
+  if (conf.out_of_core_sample > 0) {
+    columns = this->openColumnarDataset();
+  }
+  // DataGenerator paths are relative to the data directory
+  AlternativesPerformance dataset =
+      columns != nullptr
+          ? columns->materialize(
+                columns->sample(conf.out_of_core_sample, time(NULL)))
+          : dg.loadDataset(conf.dataset);
   conf.logger->info("Dataset loaded");
 
-  HeuristicPipeline hp = HeuristicPipeline(conf, dataset);
-  MRSortModel opti = hp.start();
+  if (conf.worker) {
+    std::atomic<bool> stop(false);
+    RemoteMailbox mailbox = RemoteMailbox(conf, &stop);
+    HeuristicPipeline hp = HeuristicPipeline(conf, dataset);
+    hp.setIsland(mailbox.getWorkerId(), &mailbox, &mailbox, &stop);
+    mailbox.done(hp.start());
+    conf.logger->info("App terminated");
+    return 0;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  MRSortModel opti = this->learn(dataset);
+  conf.metrics->histogram("app.learn_us")
+      .recordSeconds(std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count());
+  if (columns != nullptr) {
+    MRSortModel alt_model = opti;
+    if (alt_model.profiles.getMode() != "alt") {
+      alt_model.profiles.changeMode("alt");
+    }
+    conf.logger->info("Accuracy of the model on the whole dataset: " +
+                      std::to_string(columns->computeAccuracy(alt_model)));
+  }
   conf.logger->info("Saving models...");
-  dg.saveModel(model_path, opti.lambda, opti.criteria, opti.profiles, true,
+  dg.saveModel(conf.output, opti.lambda, opti.criteria, opti.profiles, true,
                opti.getId());
+  this->saveMetrics();
+  this->saveTrace();
   conf.logger->info("App terminated");
   return 0;
 }
\ No newline at end of file
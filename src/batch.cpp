@@ -0,0 +1,112 @@
+#include "yaml-cpp/yaml.h"
+
+#include "../include/app.h"
+#include "../include/batch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <thread>
+
+Batch::Batch(Config &config, std::string manifest) : conf(config) {
+  if (conf.n_jobs < 1) {
+    throw std::invalid_argument("The number of jobs must be >= 1");
+  }
+  std::string manifest_path = conf.data_dir + manifest;
+  if (!std::filesystem::exists(manifest_path)) {
+    throw std::invalid_argument("No manifest found at " + manifest_path);
+  }
+  YAML::Node yml_manifest = YAML::LoadFile(manifest_path);
+  if (!yml_manifest["jobs"] || !yml_manifest["jobs"].IsSequence()) {
+    throw std::invalid_argument("The manifest must have a list of jobs");
+  }
+
+  for (YAML::Node yml_job : yml_manifest["jobs"]) {
+    if (!yml_job["dataset"] || !yml_job["output"]) {
+      throw std::invalid_argument(
+          "Each job of the manifest must have a dataset and an output");
+    }
+    Job job;
+    job.config = conf;
+    // the overrides are read here, not by the threads of the batch: a bad
+    // parameter stops the batch before any learning
+    if (yml_job["overrides"]) {
+      YAML::Node overrides = yml_job["overrides"];
+      App::readParameters(overrides, job.config);
+    }
+    job.dataset = yml_job["dataset"].as<std::string>();
+    job.output = yml_job["output"].as<std::string>();
+    job.config.dataset = job.dataset;
+    job.config.output = job.output;
+    job.config.batch = "";
+    // the metrics and the trace of a job are saved with its model
+    job.config.metrics = std::make_shared<Metrics>();
+    job.config.tracer = std::make_shared<Tracer>();
+    job.config.tracer->enable(job.config.trace);
+
+    std::error_code ec;
+    std::uintmax_t size =
+        std::filesystem::file_size(job.config.data_dir + job.dataset, ec);
+    job.size = ec ? 0 : size;
+    jobs.push_back(std::move(job));
+  }
+  // largest first, in the order of the manifest for the same size
+  std::stable_sort(jobs.begin(), jobs.end(), [](const Job &a, const Job &b) {
+    return a.size > b.size;
+  });
+}
+
+const std::vector<Batch::Job> &Batch::getJobs() const { return jobs; }
+
+int Batch::runJob(Job &job) {
+  conf.logger->info("Job " + job.dataset + " -> " + job.output + " started");
+  const auto start = std::chrono::steady_clock::now();
+  int status;
+  try {
+    App app = App(job.config);
+    status = app.run();
+  } catch (const std::exception &e) {
+    conf.logger->error("Job " + job.dataset + " failed: " + e.what());
+    return 1;
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+  if (status != 0) {
+    conf.logger->error("Job " + job.dataset + " failed with status " +
+                       std::to_string(status));
+  } else {
+    conf.logger->info("Job " + job.dataset + " done in " +
+                      std::to_string(seconds) + "s");
+  }
+  return status;
+}
+
+int Batch::run() {
+  conf.logger->info("Batch of " + std::to_string(jobs.size()) + " jobs on " +
+                    std::to_string(conf.n_jobs) + " threads");
+  std::atomic<int> next_job(0);
+  std::atomic<int> n_failed(0);
+  auto worker = [&]() {
+    for (int i = next_job++; i < static_cast<int>(jobs.size());
+         i = next_job++) {
+      if (this->runJob(jobs[i]) != 0) {
+        n_failed++;
+      }
+    }
+  };
+
+  int n_threads = std::min<int>(conf.n_jobs, jobs.size());
+  std::vector<std::thread> threads;
+  for (int t = 1; t < n_threads; t++) {
+    threads.emplace_back(worker);
+  }
+  // the calling thread takes its share of the jobs
+  worker();
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  return n_failed;
+}
@@ -0,0 +1,284 @@
+#include "../../include/learning/AssignmentKernel.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// signature of the assignment loops, see assignAlternatives
+template <typename T>
+using AssignFunction = void (*)(const T *alternatives, int n_alt, int n_crit,
+                                const T *profiles, int n_prof,
+                                const float *weights, float lambda, int *ranks);
+
+/**
+ * assignAlternatives assigns each alternative to the highest category whose
+ * lower profile gets a concordance >= lambda, as
+ * MRSortModel::categoryAssignment. N_CRIT and N_PROF fix the sizes at compile
+ * time, 0 for the sizes given at runtime.
+ *
+ * @param alternatives n_alt x n_crit performances or codes, row major
+ * @param n_alt number of alternatives
+ * @param n_crit number of criteria
+ * @param profiles n_prof x n_crit performances or codes of the profiles, row
+ * major, in ascending order
+ * @param n_prof number of profiles
+ * @param weights weights of the criteria
+ * @param lambda majority threshold
+ * @param ranks rank of the category of each alternative, output
+ */
+template <typename T, int N_CRIT, int N_PROF>
+void assignAlternatives(const T *alternatives, int n_alt, int n_crit,
+                        const T *profiles, int n_prof, const float *weights,
+                        float lambda, int *ranks) {
+  const int nc = N_CRIT > 0 ? N_CRIT : n_crit;
+  const int np = N_PROF > 0 ? N_PROF : n_prof;
+  for (int a = 0; a < n_alt; a++) {
+    const T *alt = alternatives + a * nc;
+    int rank = 0;
+    for (int h = np - 1; h >= 0; h--) {
+      const T *prof = profiles + h * nc;
+      // the weights are added in the order of the criteria, as
+      // MRSortModel::computeConcordance, to get the same rounding
+      float c = 0;
+      for (int j = 0; j < nc; j++) {
+        c += alt[j] > prof[j] ? weights[j] : 0.f;
+      }
+      if (c >= lambda) {
+        rank = h + 1;
+        break;
+      }
+    }
+    ranks[a] = rank;
+  }
+}
+
+const int n_crit_sizes =
+    AssignmentKernel::max_crit - AssignmentKernel::min_crit + 1;
+const int n_prof_sizes =
+    AssignmentKernel::max_cat - AssignmentKernel::min_cat + 1;
+
+template <typename T>
+using LoopTable =
+    std::array<std::array<AssignFunction<T>, n_prof_sizes>, n_crit_sizes>;
+
+template <typename T, int N_CRIT, int... P>
+constexpr std::array<AssignFunction<T>, sizeof...(P)>
+specializedRow(std::integer_sequence<int, P...>) {
+  return {
+      &assignAlternatives<T, N_CRIT, P + AssignmentKernel::min_cat - 1>...};
+}
+
+template <typename T, int... C>
+constexpr LoopTable<T> specializedTable(std::integer_sequence<int, C...>) {
+  return {specializedRow<T, C + AssignmentKernel::min_crit>(
+      std::make_integer_sequence<int, n_prof_sizes>())...};
+}
+
+/**
+ * selectLoop gives the loop compiled for the sizes if any, the generic one
+ * otherwise
+ *
+ * @param n_crit number of criteria
+ * @param n_prof number of profiles
+ *
+ * @return assignment loop
+ */
+template <typename T> AssignFunction<T> selectLoop(int n_crit, int n_prof) {
+  // compiled loops, indexed by the number of criteria and of profiles
+  static const LoopTable<T> specialized_loops =
+      specializedTable<T>(std::make_integer_sequence<int, n_crit_sizes>());
+  if (AssignmentKernel::isSpecialized(n_crit, n_prof + 1)) {
+    return specialized_loops[n_crit - AssignmentKernel::min_crit]
+                            [n_prof + 1 - AssignmentKernel::min_cat];
+  }
+  return &assignAlternatives<T, 0, 0>;
+}
+
+} // namespace
+
+AssignmentKernel::AssignmentKernel(const AlternativesPerformance &ap,
+                                   bool rank_encoding)
+    : n_alt(0), n_crit(0) {
+  // the alternatives are read one row at a time, only a dataset in crit mode
+  // is copied to change its mode
+  std::unique_ptr<AlternativesPerformance> alt_copy;
+  const AlternativesPerformance *alt_ap = &ap;
+  if (ap.getMode() != "alt") {
+    alt_copy = std::make_unique<AlternativesPerformance>(ap);
+    alt_copy->changeMode("alt");
+    alt_ap = alt_copy.get();
+  }
+  const std::vector<std::vector<Perf>> &pt = alt_ap->getPerformanceTable();
+  if (pt.empty()) {
+    return;
+  }
+  n_alt = pt.size();
+  n_crit = pt[0].size();
+  for (const Perf &perf : pt[0]) {
+    crit_ids.push_back(perf.crit_);
+  }
+  const std::unordered_map<std::string, Category> &assignments =
+      alt_ap->getAlternativesAssignments();
+  alternatives.reserve(n_alt * n_crit);
+  for (const std::vector<Perf> &alt : pt) {
+    if (alt.size() != n_crit) {
+      throw std::invalid_argument(
+          "All the alternatives must have the same number of criteria");
+    }
+    for (int j = 0; j < n_crit; j++) {
+      if (alt[j].crit_ != crit_ids[j]) {
+        throw std::invalid_argument(
+            "All the alternatives must have the criteria in the same order");
+      }
+      alternatives.push_back(alt[j].value_);
+    }
+    auto it = assignments.find(alt[0].name_);
+    expected_ranks.push_back(it != assignments.end() ? it->second.rank_
+                                                     : Category().rank_);
+  }
+  if (!rank_encoding) {
+    return;
+  }
+
+  // dictionary of each criterion
+  dictionaries.resize(n_crit);
+  size_t max_size = 0;
+  for (int j = 0; j < n_crit; j++) {
+    std::vector<float> &dictionary = dictionaries[j];
+    for (int a = 0; a < n_alt; a++) {
+      dictionary.push_back(alternatives[a * n_crit + j]);
+    }
+    std::sort(dictionary.begin(), dictionary.end());
+    dictionary.erase(std::unique(dictionary.begin(), dictionary.end()),
+                     dictionary.end());
+    max_size = std::max(max_size, dictionary.size());
+  }
+  // code of a performance: 1 + its position in the dictionary, the codes of
+  // the profiles being in [0, size]
+  bool narrow = max_size < std::numeric_limits<std::uint16_t>::max();
+  for (int i = 0; i < alternatives.size(); i++) {
+    std::vector<float> &dictionary = dictionaries[i % n_crit];
+    std::uint32_t code =
+        std::lower_bound(dictionary.begin(), dictionary.end(),
+                         alternatives[i]) -
+        dictionary.begin() + 1;
+    if (narrow) {
+      alternatives_16.push_back(code);
+    } else {
+      alternatives_32.push_back(code);
+    }
+  }
+  // the float matrix is not needed anymore
+  std::vector<float>().swap(alternatives);
+}
+
+AssignmentKernel::~AssignmentKernel() {}
+
+bool AssignmentKernel::isCompatible(MRSortModel &model) const {
+  if (model.profiles.getMode() != "alt") {
+    return false;
+  }
+  const std::vector<Criterion> &criteria = model.criteria.getCriterionVect();
+  if (criteria.size() != n_crit) {
+    return false;
+  }
+  for (int j = 0; j < n_crit; j++) {
+    if (criteria[j].getId() != crit_ids[j]) {
+      return false;
+    }
+  }
+  for (const std::vector<Perf> &prof : model.profiles.getPerformanceTable()) {
+    if (prof.size() != n_crit) {
+      return false;
+    }
+    for (int j = 0; j < n_crit; j++) {
+      if (prof[j].crit_ != crit_ids[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool AssignmentKernel::isSpecialized(int n_crit, int n_cat) {
+  return n_crit >= min_crit && n_crit <= max_crit && n_cat >= min_cat &&
+         n_cat <= max_cat;
+}
+
+int AssignmentKernel::getCodeBits() const {
+  if (dictionaries.empty()) {
+    return 0;
+  }
+  return alternatives_32.empty() ? 16 : 32;
+}
+
+template <typename T>
+std::vector<T>
+AssignmentKernel::encodeProfiles(const std::vector<float> &profiles) const {
+  std::vector<T> codes;
+  codes.reserve(profiles.size());
+  for (int i = 0; i < profiles.size(); i++) {
+    // number of values of the criterion <= the profile: the alternatives
+    // above the profile have a greater code
+    const std::vector<float> &dictionary = dictionaries[i % n_crit];
+    codes.push_back(std::upper_bound(dictionary.begin(), dictionary.end(),
+                                     profiles[i]) -
+                    dictionary.begin());
+  }
+  return codes;
+}
+
+std::vector<int> AssignmentKernel::assign(MRSortModel &model) const {
+  if (!this->isCompatible(model)) {
+    throw std::invalid_argument(
+        "The model must have the criteria of the dataset, in the same order");
+  }
+  const std::vector<std::vector<Perf>> &profiles_pt =
+      model.profiles.getPerformanceTable();
+  int n_prof = profiles_pt.size();
+  std::vector<float> profiles;
+  profiles.reserve(n_prof * n_crit);
+  for (const std::vector<Perf> &prof : profiles_pt) {
+    for (const Perf &perf : prof) {
+      profiles.push_back(perf.value_);
+    }
+  }
+
+  std::vector<int> ranks(n_alt);
+  const float *weights = model.criteria.getWeights().data();
+  if (this->getCodeBits() == 16) {
+    std::vector<std::uint16_t> codes =
+        this->encodeProfiles<std::uint16_t>(profiles);
+    selectLoop<std::uint16_t>(n_crit, n_prof)(
+        alternatives_16.data(), n_alt, n_crit, codes.data(), n_prof, weights,
+        model.lambda, ranks.data());
+  } else if (this->getCodeBits() == 32) {
+    std::vector<std::uint32_t> codes =
+        this->encodeProfiles<std::uint32_t>(profiles);
+    selectLoop<std::uint32_t>(n_crit, n_prof)(
+        alternatives_32.data(), n_alt, n_crit, codes.data(), n_prof, weights,
+        model.lambda, ranks.data());
+  } else {
+    selectLoop<float>(n_crit, n_prof)(alternatives.data(), n_alt, n_crit,
+                                      profiles.data(), n_prof, weights,
+                                      model.lambda, ranks.data());
+  }
+  return ranks;
+}
+
+float AssignmentKernel::computeAccuracy(MRSortModel &model) const {
+  std::vector<int> ranks = this->assign(model);
+  int acc = 0;
+  for (int a = 0; a < n_alt; a++) {
+    if (ranks[a] == expected_ranks[a]) {
+      acc++;
+    }
+  }
+  return float(acc) / float(n_alt);
+}
@@ -0,0 +1,109 @@
+#include "../../include/learning/ConvergenceController.h"
+#include "../../include/types/MRSortModel.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+ConvergenceController::ConvergenceController(Config &config) : conf(config) {
+  this->start();
+}
+
+ConvergenceController::~ConvergenceController() {}
+
+void ConvergenceController::start() {
+  start_time_ = std::chrono::steady_clock::now();
+  best_score_ = -1;
+  stale_iterations_ = 0;
+  stop_reason_ = "";
+}
+
+bool ConvergenceController::update(std::vector<MRSortModel> &models,
+                                   float best_score) {
+  if (best_score > best_score_) {
+    best_score_ = best_score;
+    stale_iterations_ = 0;
+  } else {
+    stale_iterations_++;
+  }
+
+  if (conf.target_accuracy > 0 && best_score_ >= conf.target_accuracy) {
+    stop_reason_ = "target accuracy of " +
+                   std::to_string(conf.target_accuracy) + " reached";
+    return true;
+  }
+  if (conf.max_stale_iterations > 0 &&
+      stale_iterations_ >= conf.max_stale_iterations) {
+    stop_reason_ = "no improvement of the best score for " +
+                   std::to_string(stale_iterations_) + " iterations";
+    return true;
+  }
+  if (this->isTimeBudgetExhausted()) {
+    stop_reason_ = "time budget of " +
+                   std::to_string(conf.time_budget_seconds) +
+                   "s exhausted";
+    return true;
+  }
+  if (conf.min_diversity > 0) {
+    // only the models kept for the next iteration are relevant, the worst half
+    // is re-initialized anyway
+    float diversity = this->computeDiversity(models, models.size() / 2);
+    if (diversity < conf.min_diversity) {
+      stop_reason_ = "population diversity " + std::to_string(diversity) +
+                     " below " + std::to_string(conf.min_diversity);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ConvergenceController::isTimeBudgetExhausted() const {
+  if (conf.time_budget_seconds <= 0) {
+    return false;
+  }
+  return this->getElapsedSeconds() >= conf.time_budget_seconds;
+}
+
+double ConvergenceController::getElapsedSeconds() const {
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start_time_;
+  return elapsed.count();
+}
+
+float ConvergenceController::computeDiversity(std::vector<MRSortModel> &models,
+                                              int n_models) {
+  if (n_models > models.size()) {
+    n_models = models.size();
+  }
+  if (n_models < 2) {
+    return 0;
+  }
+  // parameters of a model: its weights followed by lambda
+  std::vector<std::vector<float>> params;
+  for (int k = 0; k < n_models; k++) {
+    std::vector<float> p = models[k].criteria.getWeights();
+    p.push_back(models[k].lambda);
+    params.push_back(p);
+  }
+  std::vector<float> centroid(params[0].size(), 0);
+  for (std::vector<float> &p : params) {
+    for (int i = 0; i < p.size(); i++) {
+      centroid[i] += p[i] / n_models;
+    }
+  }
+  float diversity = 0;
+  for (std::vector<float> &p : params) {
+    for (int i = 0; i < p.size(); i++) {
+      diversity += std::abs(p[i] - centroid[i]);
+    }
+  }
+  return diversity / n_models;
+}
+
+int ConvergenceController::getStaleIterations() const {
+  return stale_iterations_;
+}
+
+std::string ConvergenceController::getStopReason() const {
+  return stop_reason_;
+}
@@ -0,0 +1,156 @@
+#include "../../include/learning/Coordinator.h"
+#include "../../include/learning/WorkerProtocol.h"
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+Coordinator::Coordinator(Config &config)
+    : conf(config), listen_fd(-1), stop(false) {
+  if (conf.n_workers < 1) {
+    throw std::invalid_argument("The number of workers must be >= 1");
+  }
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (conf.coordinator_socket.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument("Coordinator socket path is too long");
+  }
+  std::strcpy(addr.sun_path, conf.coordinator_socket.c_str());
+
+  listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    throw std::runtime_error("Cannot create socket");
+  }
+  // socket file left by a previous run
+  ::unlink(conf.coordinator_socket.c_str());
+  if (::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) < 0 ||
+      ::listen(listen_fd, conf.n_workers) < 0) {
+    ::close(listen_fd);
+    throw std::runtime_error("Cannot listen on " + conf.coordinator_socket +
+                             ": " + std::strerror(errno));
+  }
+  mailboxes.resize(conf.n_workers);
+}
+
+Coordinator::~Coordinator() {
+  for (int k = 0; k < worker_fds.size(); k++) {
+    if (!done[k]) {
+      ::close(worker_fds[k]);
+    }
+  }
+  if (listen_fd >= 0) {
+    ::close(listen_fd);
+    ::unlink(conf.coordinator_socket.c_str());
+  }
+}
+
+MRSortModel Coordinator::serve() {
+  conf.logger->info("Waiting for " + std::to_string(conf.n_workers) +
+                    " workers on " + conf.coordinator_socket);
+  int n_done = 0;
+  while (n_done < conf.n_workers) {
+    std::vector<pollfd> fds;
+    std::vector<int> ids;
+    if (worker_fds.size() < conf.n_workers) {
+      fds.push_back({listen_fd, POLLIN, 0});
+      ids.push_back(-1);
+    }
+    for (int k = 0; k < worker_fds.size(); k++) {
+      if (!done[k]) {
+        fds.push_back({worker_fds[k], POLLIN, 0});
+        ids.push_back(k);
+      }
+    }
+    if (::poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error("Coordinator poll failed");
+    }
+
+    for (int p = 0; p < fds.size(); p++) {
+      if (fds[p].revents == 0) {
+        continue;
+      }
+      if (ids[p] == -1) {
+        int fd = ::accept(listen_fd, nullptr, nullptr);
+        if (fd >= 0) {
+          worker_fds.push_back(fd);
+          done.push_back(false);
+        }
+        continue;
+      }
+      int k = ids[p];
+      bool finished;
+      try {
+        finished = this->handleMessage(k);
+      } catch (const std::exception &e) {
+        conf.logger->warn("Worker " + std::to_string(k) +
+                          " disconnected: " + e.what());
+        finished = true;
+      }
+      if (finished) {
+        ::close(worker_fds[k]);
+        done[k] = true;
+        n_done++;
+      }
+    }
+  }
+
+  if (best_model == nullptr) {
+    throw std::runtime_error("No worker reported a model");
+  }
+  conf.logger->info("Best model reported by the workers has a score of: " +
+                    std::to_string(best_model->getScore()));
+  return *best_model;
+}
+
+bool Coordinator::handleMessage(int worker_id) {
+  int fd = worker_fds[worker_id];
+  std::string payload;
+  switch (receiveMessage(fd, payload)) {
+  case MessageType::Hello:
+    sendMessage(fd, MessageType::Welcome,
+                std::to_string(worker_id) + " " +
+                    std::to_string(conf.n_workers));
+    conf.logger->info("Worker " + std::to_string(worker_id) + " registered");
+    return false;
+  case MessageType::Post:
+    mailboxes[(worker_id + 1) % conf.n_workers] = payload;
+    sendMessage(fd, MessageType::Ack);
+    return false;
+  case MessageType::Collect:
+    if (stop) {
+      sendMessage(fd, MessageType::Stop);
+    } else {
+      sendMessage(fd, MessageType::Migrants, mailboxes[worker_id]);
+      mailboxes[worker_id].clear();
+    }
+    return false;
+  case MessageType::Done: {
+    std::vector<MRSortModel> reported = decodeModels(payload);
+    sendMessage(fd, MessageType::Ack);
+    if (!reported.empty()) {
+      float score = reported[0].getScore();
+      conf.logger->info("Worker " + std::to_string(worker_id) +
+                        " done with a score of: " + std::to_string(score));
+      if (best_model == nullptr || best_model->getScore() < score) {
+        best_model = std::make_unique<MRSortModel>(reported[0]);
+      }
+      if (conf.target_accuracy > 0 && score >= conf.target_accuracy) {
+        stop = true;
+      }
+    }
+    return true;
+  }
+  default:
+    throw std::runtime_error("Unexpected message");
+  }
+}
+
+int Coordinator::getNumberWorkers() const { return conf.n_workers; }
@@ -1,189 +1,341 @@
 #include <algorithm>
-#include <sstream>
+#include <array>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
 #include <vector>
 
+#include "../../include/learning/ConvergenceController.h"
 #include "../../include/learning/HeuristicPipeline.h"
+#include "../../include/learning/MigrationMailbox.h"
+#include "../../include/learning/ModelCheckpointer.h"
 #include "../../include/learning/ProfileInitializer.h"
 #include "../../include/learning/ProfileUpdater.h"
 #include "../../include/learning/WeightUpdater.h"
+#include "../../include/logging.h"
 #include "../../include/types/MRSortModel.h"
 
-HeuristicPipeline::HeuristicPipeline(Config &config,
-                                     AlternativesPerformance &altPerfs)
+HeuristicPipeline::HeuristicPipeline(
+    Config &config, AlternativesPerformance &altPerfs,
+    std::shared_ptr<const AssignmentKernel> kernel)
     : conf(config), altPerfs(altPerfs), weightUpdater(altPerfs, config),
-      profileInitializer(config, altPerfs), profileUpdater(config, altPerfs) {}
+      profileInitializer(config, altPerfs), profileUpdater(config, altPerfs),
+      convergenceController(config), checkpointer(config),
+      assignmentKernel(kernel != nullptr ? std::move(kernel)
+                                         : std::make_shared<AssignmentKernel>(
+                                               altPerfs, config.rank_encoding)),
+      init_time(config.metrics->histogram("pipeline.init_us")),
+      weight_update_time(config.metrics->histogram("pipeline.weight_update_us")),
+      profile_update_time(
+          config.metrics->histogram("pipeline.profile_update_us")),
+      accuracy_time(config.metrics->histogram("pipeline.accuracy_us")),
+      iteration_count(config.metrics->counter("pipeline.iterations")),
+      reinit_count(config.metrics->counter("pipeline.models_reinitialized")),
+      migrant_count(config.metrics->counter("pipeline.migrants_received")) {
+  if (conf.n_threads < 1) {
+    throw std::invalid_argument("The number of threads must be >= 1");
+  }
+  if (conf.migration_interval < 1) {
+    throw std::invalid_argument("The migration interval must be >= 1");
+  }
+  if (conf.n_migrants < 0) {
+    throw std::invalid_argument("The number of migrants must be >= 0");
+  }
+  phase_durations.resize(conf.n_threads);
+  for (int t = 0; t < conf.n_threads; t++) {
+    scratch_arenas.push_back(std::make_unique<ScratchArena>());
+  }
+}
 
 MRSortModel HeuristicPipeline::start() {
-  conf.logger->info("Starting heuristic pipeline");
+  conf.logger->info(log_prefix + "Starting heuristic pipeline");
+  convergenceController.start();
   int n_cat = altPerfs.getNumberCats();
   int n_crit = altPerfs.getNumberCrit();
 
   // First iteration outside the loop: run every algorithm on all models
   // Creation of models and profile initialization
-  conf.logger->info("Running 1st iteration on all models");
-
-  using clock = std::chrono::system_clock;
-  using sec = std::chrono::duration<double>;
-  const auto before_init = clock::now();
+  conf.logger->info(log_prefix + "Running 1st iteration on all models");
   for (int k = 0; k < conf.model_batch_size; k++) {
-    MRSortModel model = MRSortModel(n_cat, n_crit);
-    profileInitializer.initializeProfiles(model);
-
-    // change back to alt mode
-    model.profiles.changeMode("alt");
-    float acc_before = model.getScore();
-    this->computeAccuracy(model);
-    models.push_back(model);
-
-    std::ostringstream ss;
-    ss << "accuracy of model " << k << " after init: " << model.getScore()
-       << ", gain of: " << model.getScore() - acc_before << std::endl;
-    conf.logger->debug(ss.str());
+    models.push_back(MRSortModel(n_cat, n_crit));
   }
-  const sec init_duration = clock::now() - before_init;
-  const auto before_weight = clock::now();
-
-  // Update weight and lambda
-  for (int k = 0; k < conf.model_batch_size; k++) {
-    weightUpdater.updateWeightsAndLambda(models[k]);
-    float acc_before = models[k].getScore();
-    this->computeAccuracy(models[k]);
-
-    std::ostringstream ss;
-    ss << "accuracy of model " << k
-       << " after weight update: " << models[k].getScore()
-       << ", gain of: " << models[k].getScore() - acc_before << std::endl;
-    conf.logger->debug(ss.str());
+  for (std::array<double, 3> &durations : phase_durations) {
+    durations.fill(0);
   }
-  const sec weight_duration = clock::now() - before_weight;
-  const auto before_profile = clock::now();
+  this->updateModels(0);
 
-  // Update profiles
-  for (int k = 0; k < conf.model_batch_size; k++) {
-    for (int i = 0; i < conf.n_profile_update; i++) {
-      profileUpdater.updateProfiles(models[k]);
-      float acc_before = models[k].getScore();
-      this->computeAccuracy(models[k]);
-
-      std::ostringstream ss;
-      ss << "accuracy of model " << k
-         << " after profile update: " << models[k].getScore()
-         << ", gain of: " << models[k].getScore() - acc_before << std::endl;
-      conf.logger->debug(ss.str());
+  if (FASTPL_SHOULD_DEBUG(conf.logger)) {
+    // durations are summed over the threads
+    double init_duration = 0, weight_duration = 0, profile_duration = 0;
+    for (std::array<double, 3> &durations : phase_durations) {
+      init_duration += durations[0];
+      weight_duration += durations[1];
+      profile_duration += durations[2];
     }
+    double total_time = init_duration + weight_duration + profile_duration;
+    // no share of the total when the phases were too fast to be timed
+    auto share = [total_time](double duration) {
+      return total_time > 0
+                 ? " - " + std::to_string(int(100 * duration / total_time)) +
+                       "%"
+                 : std::string();
+    };
+    conf.logger->debug("Profile initialization of all models took: {}s{}",
+                       init_duration, share(init_duration));
+    conf.logger->debug("Weight update of all models took: {}s{}",
+                       weight_duration, share(weight_duration));
+    conf.logger->debug("Profile update of all models took: {}s{}",
+                       profile_duration, share(profile_duration));
   }
-
-  const sec profile_duration = clock::now() - before_profile;
-  auto total_time = init_duration.count() + weight_duration.count() +
-                    profile_duration.count();
-  std::ostringstream ss0;
-  ss0 << "Profile initialization of all models took: " << init_duration.count()
-      << "s"
-      << " - " << int(100 * init_duration.count() / total_time) << "%"
-      << std::endl;
-  conf.logger->debug(ss0.str());
-  std::ostringstream ss1;
-  ss1 << "Weight update of all models took: " << weight_duration.count() << "s"
-      << " - " << int(100 * weight_duration.count() / total_time) << "%"
-      << std::endl;
-  conf.logger->debug(ss1.str());
-  std::ostringstream ss2;
-  ss2 << "Profile update of all models took: " << profile_duration.count()
-      << "s"
-      << " - " << int(100 * profile_duration.count() / total_time) << "%"
-      << std::endl;
-  conf.logger->debug(ss2.str());
   this->orderModels();
-  conf.logger->info("Iteration 1 done, best model has a score of: " +
+  iteration_count.add();
+  conf.logger->info(log_prefix +
+                    "Iteration 1 done, best model has a score of: " +
                     std::to_string(models[0].getScore()));
 
   MRSortModel best_model = models[0];
+  if (checkpointer.isDue()) {
+    checkpointer.save(best_model);
+  }
+  if (convergenceController.update(models, best_model.getScore())) {
+    conf.logger->info(log_prefix + "Stopping algorithm: " +
+                      convergenceController.getStopReason());
+    this->stopIslands(best_model);
+    this->polish(best_model);
+    // the final model is saved by the caller, the checkpoint must not
+    // overwrite it
+    checkpointer.wait();
+    return best_model;
+  }
 
   // iterating until convergence or reaching the max iteration
   for (int i = 1; i < conf.max_iterations; i++) {
-    // ** profiles initialization **
-
     // models are sorted in descending order by getScore()
-    // re-initialize the worst half of the models
-    for (int k = conf.model_batch_size - 1; k > conf.model_batch_size / 2 - 1;
-         k--) {
-      models[k].criteria.generateRandomCriteriaWeights();
-      profileInitializer.initializeProfiles(models[k]);
-      models[k].profiles.changeMode("alt");
-      float acc_before = models[k].getScore();
-      this->computeAccuracy(models[k]);
-
-      std::ostringstream ss;
-      ss << "accuracy of model " << k
-         << " after re-init: " << models[k].getScore()
-         << ", gain of: " << models[k].getScore() - acc_before << std::endl;
-      conf.logger->debug(ss.str());
-    }
-    // ** Weight and lambda update **
-    for (int k = 0; k < conf.model_batch_size; k++) {
-      weightUpdater.updateWeightsAndLambda(models[k]);
-      float acc_before = models[k].getScore();
-      this->computeAccuracy(models[k]);
-
-      std::ostringstream ss;
-      ss << "accuracy of model " << k
-         << " after weight update: " << models[k].getScore()
-         << ", gain of: " << models[k].getScore() - acc_before << std::endl;
-      conf.logger->debug(ss.str());
-    }
-    // ** Profiles update **
-    for (int k = 0; k < conf.model_batch_size; k++) {
-      for (int i = 0; i < conf.n_profile_update; i++) {
-        profileUpdater.updateProfiles(models[k]);
-        float acc_before = models[k].getScore();
-        this->computeAccuracy(models[k]);
-
-        std::ostringstream ss;
-        ss << "accuracy of model " << k
-           << " after profile update: " << models[k].getScore()
-           << ", gain of: " << models[k].getScore() - acc_before << std::endl;
-        conf.logger->debug(ss.str());
-      }
-    }
+    // re-initialize the worst half of the models, then update all of them
+    this->updateModels(conf.model_batch_size / 2);
     this->orderModels();
-    if (best_model.getScore() > models[0].getScore()) {
+    iteration_count.add();
+    // ** Migration between islands **
+    if (outbox != nullptr && i % conf.migration_interval == 0) {
+      this->migrate();
+    }
+    if (best_model.getScore() < models[0].getScore()) {
       best_model = models[0];
     }
-    conf.logger->info("Iteration " + std::to_string(i) +
+    if (checkpointer.isDue()) {
+      checkpointer.save(best_model);
+    }
+    conf.logger->info(log_prefix + "Iteration " + std::to_string(i) +
                       " done, best model encountered has a score of: " +
                       std::to_string(best_model.getScore()));
-    // if one model is accurately representing the dataset, stop the learning
-    if (best_model.getScore() == 1) {
-      conf.logger->info(
-          "Model with an accuracy of 1 found, stopping algorithm");
+    // stop the learning when converged or out of budget
+    if (convergenceController.update(models, best_model.getScore())) {
+      conf.logger->info(log_prefix + "Stopping algorithm: " +
+                        convergenceController.getStopReason());
+      this->stopIslands(best_model);
+      this->polish(best_model);
+      checkpointer.wait();
+      return best_model;
+    }
+    // an other island found a model good enough
+    if (stop != nullptr && stop->load()) {
+      conf.logger->info(log_prefix + "Stopped by an other island");
+      this->polish(best_model);
+      checkpointer.wait();
       return best_model;
     }
   }
-  conf.logger->info("Reaching max iteration, terminating the pipeline");
+  conf.logger->info(log_prefix +
+                    "Reaching max iteration, terminating the pipeline");
+  this->polish(best_model);
+  checkpointer.wait();
   return best_model;
 }
 
+void HeuristicPipeline::setIsland(int island_id, MigrationMailbox *inbox,
+                                  MigrationMailbox *outbox,
+                                  std::atomic<bool> *stop) {
+  this->inbox = inbox;
+  this->outbox = outbox;
+  this->stop = stop;
+  log_prefix = "Island " + std::to_string(island_id) + " - ";
+}
+
+void HeuristicPipeline::updateModels(int first_reinit) {
+  int n_models = models.size();
+  int n_threads = std::min(conf.n_threads, n_models);
+  if (n_threads <= 1) {
+    for (int k = 0; k < n_models; k++) {
+      this->updateModel(k, k >= first_reinit, phase_durations[0],
+                        *scratch_arenas[0]);
+    }
+    return;
+  }
+
+  // each thread takes the next model not yet updated and runs all its phases,
+  // so slow linear programs on some models overlap with the profile updates
+  // of the others
+  std::atomic<int> next(0);
+  std::vector<std::exception_ptr> errors(n_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < n_threads; t++) {
+    threads.push_back(
+        std::thread([this, t, first_reinit, n_models, &next, &errors]() {
+          try {
+            for (int k = next++; k < n_models; k = next++) {
+              this->updateModel(k, k >= first_reinit, phase_durations[t],
+                                *scratch_arenas[t]);
+            }
+          } catch (...) {
+            errors[t] = std::current_exception();
+            // no need for the other threads to go on
+            next.store(n_models);
+          }
+        }));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  for (std::exception_ptr &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
+void HeuristicPipeline::updateModel(int k, bool reinit,
+                                    std::array<double, 3> &durations,
+                                    ScratchArena &arena) {
+  using clock = std::chrono::steady_clock;
+  using sec = std::chrono::duration<double>;
+  MRSortModel &model = models[k];
+
+  // ** profiles initialization **
+  const auto before_init = clock::now();
+  if (reinit) {
+    {
+      Tracer::Span span(*conf.tracer, "initializeProfiles", k);
+      model.criteria.generateRandomCriteriaWeights();
+      profileInitializer.initializeProfiles(model);
+      // change back to alt mode
+      model.profiles.changeMode("alt");
+    }
+    init_time.recordSeconds(sec(clock::now() - before_init).count());
+    reinit_count.add();
+    this->updateAccuracy(model, k, "init");
+  }
+  const auto before_weight = clock::now();
+  durations[0] += sec(before_weight - before_init).count();
+
+  // ** Weight and lambda update **
+  // when the time budget is exhausted, the remaining phases are skipped and the
+  // model is ranked as it is
+  if (!convergenceController.isTimeBudgetExhausted()) {
+    {
+      Tracer::Span span(*conf.tracer, "updateWeightsAndLambda", k);
+      weightUpdater.updateWeightsAndLambda(model);
+    }
+    weight_update_time.recordSeconds(sec(clock::now() - before_weight).count());
+    this->updateAccuracy(model, k, "weight update");
+  }
+  const auto before_profile = clock::now();
+  durations[1] += sec(before_profile - before_weight).count();
+
+  // ** Profiles update **
+  if (!convergenceController.isTimeBudgetExhausted()) {
+    for (int i = 0; i < conf.n_profile_update; i++) {
+      const auto before_update = clock::now();
+      {
+        Tracer::Span span(*conf.tracer, "updateProfiles", k);
+        profileUpdater.updateProfiles(model, arena);
+      }
+      profile_update_time.recordSeconds(
+          sec(clock::now() - before_update).count());
+      this->updateAccuracy(model, k, "profile update");
+    }
+  }
+  durations[2] += sec(clock::now() - before_profile).count();
+}
+
+void HeuristicPipeline::migrate() {
+  if (inbox == nullptr || outbox == nullptr) {
+    return;
+  }
+  // the worst half of the models is re-initialized at the next iteration, only
+  // the kept half can send or receive migrants
+  int n_kept = models.size() / 2;
+  int n_migrants = std::min(conf.n_migrants, n_kept);
+
+  // models are sorted in descending order, send copies of the best ones
+  std::vector<MRSortModel> migrants(models.begin(),
+                                    models.begin() + n_migrants);
+  outbox->post(migrants);
+
+  // migrants replace the worst of the kept models
+  std::vector<MRSortModel> arrivals = inbox->collect();
+  int n_arrivals = std::min(int(arrivals.size()), n_kept);
+  for (int j = 0; j < n_arrivals; j++) {
+    models[n_kept - 1 - j] = arrivals[j];
+  }
+  migrant_count.add(n_arrivals);
+  if (n_arrivals > 0) {
+    this->customSort();
+    FASTPL_DEBUG(conf.logger, "{}{} migrants received", log_prefix,
+                 n_arrivals);
+  }
+}
+
+void HeuristicPipeline::stopIslands(MRSortModel &best_model) {
+  if (stop != nullptr && conf.target_accuracy > 0 &&
+      best_model.getScore() >= conf.target_accuracy) {
+    stop->store(true);
+  }
+}
+
+void HeuristicPipeline::polish(MRSortModel &best_model) {
+  if (conf.lp_sample_size <= 0) {
+    return;
+  }
+  if (convergenceController.isTimeBudgetExhausted()) {
+    conf.logger->info(log_prefix +
+                      "Time budget exhausted, the best model is not polished");
+    return;
+  }
+  // the weight updates only saw samples of the alternatives, a last one on the
+  // whole dataset is kept if it does not lower the accuracy
+  MRSortModel polished = best_model;
+  weightUpdater.polishWeightsAndLambda(polished);
+  this->computeAccuracy(polished);
+  conf.logger->info(log_prefix + "Best model polished on the whole dataset, " +
+                    "score of: " + std::to_string(polished.getScore()));
+  if (polished.getScore() >= best_model.getScore()) {
+    best_model = polished;
+  }
+}
+
 void HeuristicPipeline::customSort() {
   std::vector<int> temp;
   for (int i = 0; i < models.size(); i++) {
     temp.push_back(i);
   }
-  auto lambda_models = models;
-  std::sort(temp.begin(), temp.end(),
-            [lambda_models](const auto &a, const auto &b) {
-              return lambda_models[a].getScore() > lambda_models[b].getScore();
-            });
-  std::vector<MRSortModel> models_copy;
-  for (auto e : models) {
-    models_copy.push_back(e);
-  }
-  models.clear();
+  std::sort(temp.begin(), temp.end(), [this](const auto &a, const auto &b) {
+    return models[a].getScore() > models[b].getScore();
+  });
+  // the models are moved, not copied, in their new order
+  std::vector<MRSortModel> sorted_models;
+  sorted_models.reserve(models.size());
   for (auto i : temp) {
-    models.push_back(models_copy[i]);
+    sorted_models.push_back(std::move(models[i]));
   }
+  models = std::move(sorted_models);
 }
 
 void HeuristicPipeline::orderModels() {
+  Tracer::Span span(*conf.tracer, "orderModels");
   for (int k = 0; k < models.size(); k++) {
     this->computeAccuracy(models[k]);
   }
@@ -191,18 +343,41 @@ void HeuristicPipeline::orderModels() {
   this->customSort();
 }
 
+void HeuristicPipeline::updateAccuracy(MRSortModel &model, int k,
+                                       const char *phase) {
+  if (FASTPL_SHOULD_DEBUG(conf.logger)) {
+    float acc_before = model.getScore();
+    this->computeAccuracy(model);
+    conf.logger->debug("accuracy of model {} after {}: {}, gain of: {}", k,
+                       phase, model.getScore(),
+                       model.getScore() - acc_before);
+  } else {
+    this->computeAccuracy(model);
+  }
+}
+
 void HeuristicPipeline::computeAccuracy(MRSortModel &model) {
-  AlternativesPerformance model_assignments =
-      model.categoryAssignments(altPerfs);
-  std::unordered_map<std::string, Category> truth =
-      altPerfs.getAlternativesAssignments();
-  std::unordered_map<std::string, Category> assignments =
-      model_assignments.getAlternativesAssignments();
-  int acc = 0;
-  for (std::pair<std::string, Category> e : assignments) {
-    if (e.second.rank_ == truth[e.first].rank_) {
-      acc++;
+  Tracer::Span span(*conf.tracer, "computeAccuracy");
+  const auto start = std::chrono::steady_clock::now();
+  if (assignmentKernel->isCompatible(model)) {
+    model.setScore(assignmentKernel->computeAccuracy(model));
+  } else {
+    // criteria of the model not aligned with the dataset
+    AlternativesPerformance model_assignments =
+        model.categoryAssignments(altPerfs);
+    const std::unordered_map<std::string, Category> &truth =
+        altPerfs.getAlternativesAssignments();
+    const std::unordered_map<std::string, Category> &assignments =
+        model_assignments.getAlternativesAssignments();
+    int acc = 0;
+    for (const auto &e : assignments) {
+      if (e.second.rank_ == truth.at(e.first).rank_) {
+        acc++;
+      }
     }
+    model.setScore(float(acc) / float(altPerfs.getNumberAlt()));
   }
-  model.setScore(float(acc) / float(altPerfs.getNumberAlt()));
+  accuracy_time.recordSeconds(
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count());
 }
\ No newline at end of file
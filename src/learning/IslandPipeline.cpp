@@ -0,0 +1,84 @@
+#include "../../include/learning/IslandPipeline.h"
+#include "../../include/learning/HeuristicPipeline.h"
+#include "../../include/learning/MigrationMailbox.h"
+#include "../../include/types/MRSortModel.h"
+
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+IslandPipeline::IslandPipeline(Config &config,
+                               AlternativesPerformance &altPerfs,
+                               std::shared_ptr<const AssignmentKernel> kernel)
+    : conf(config), altPerfs(altPerfs), stop(false) {
+  if (conf.n_islands < 1) {
+    throw std::invalid_argument("The number of islands must be >= 1");
+  }
+  // the islands learn on the same dataset, they share its kernel
+  if (kernel == nullptr) {
+    kernel = std::make_shared<AssignmentKernel>(altPerfs, conf.rank_encoding);
+  }
+  for (int k = 0; k < conf.n_islands; k++) {
+    mailboxes.push_back(std::make_unique<MigrationMailbox>());
+  }
+  for (int k = 0; k < conf.n_islands; k++) {
+    island_confs.push_back(std::make_unique<Config>(conf));
+    if (k > 0) {
+      island_confs[k]->checkpoint_interval_seconds = 0;
+    }
+    islands.push_back(std::make_unique<HeuristicPipeline>(*island_confs[k],
+                                                          altPerfs, kernel));
+    islands[k]->setIsland(k, mailboxes[k].get(),
+                          mailboxes[(k + 1) % conf.n_islands].get(), &stop);
+  }
+}
+
+IslandPipeline::~IslandPipeline() {}
+
+MRSortModel IslandPipeline::start() {
+  conf.logger->info("Starting " + std::to_string(conf.n_islands) +
+                    " islands");
+  stop.store(false);
+
+  std::vector<std::unique_ptr<MRSortModel>> results(conf.n_islands);
+  std::vector<std::exception_ptr> errors(conf.n_islands);
+  std::vector<std::thread> threads;
+  for (int k = 0; k < conf.n_islands; k++) {
+    threads.push_back(std::thread([this, k, &results, &errors]() {
+      try {
+        results[k] = std::make_unique<MRSortModel>(islands[k]->start());
+      } catch (...) {
+        errors[k] = std::current_exception();
+        // no need for the other islands to go on
+        stop.store(true);
+      }
+    }));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  for (std::exception_ptr &e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+
+  int best = 0;
+  for (int k = 0; k < conf.n_islands; k++) {
+    conf.logger->info("Island " + std::to_string(k) +
+                      " best model has a score of: " +
+                      std::to_string(results[k]->getScore()));
+    if (results[k]->getScore() > results[best]->getScore()) {
+      best = k;
+    }
+  }
+  return *results[best];
+}
+
+HeuristicPipeline &IslandPipeline::getIsland(int island_id) {
+  return *islands[island_id];
+}
+
+int IslandPipeline::getNumberIslands() const { return islands.size(); }
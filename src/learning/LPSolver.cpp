@@ -0,0 +1,45 @@
+#include "../../include/learning/LPSolver.h"
+#include "../../include/learning/LinearSolver.h"
+#include "../../include/learning/SimplexSolver.h"
+#include "../../include/learning/SubgradientSolver.h"
+
+#include <unordered_map>
+
+std::unique_ptr<LPSolver> LPSolver::create(AlternativesPerformance &ap,
+                                           Config &conf) {
+  if (conf.lp_solver == "SIMPLEX") {
+    return std::make_unique<SimplexSolver>(ap, conf);
+  }
+  if (conf.lp_solver == "SUBGRADIENT") {
+    return std::make_unique<SubgradientSolver>(ap, conf);
+  }
+  return std::make_unique<LinearSolver>(ap, conf, 0.000001, conf.lp_solver);
+}
+
+void LPSolver::distinctRows(std::vector<std::vector<std::vector<bool>>> &matrix,
+                            std::vector<std::vector<bool>> &rows,
+                            std::vector<int> &multiplicity,
+                            std::vector<std::vector<int>> &row_of_alt) {
+  std::unordered_map<std::vector<bool>, int> index;
+  rows.clear();
+  multiplicity.clear();
+  row_of_alt.assign(matrix.size(), std::vector<int>());
+  for (int h = 0; h < matrix.size(); h++) {
+    row_of_alt[h].assign(matrix[h].size(), -1);
+    for (int alt = 0; alt < matrix[h].size(); alt++) {
+      if (matrix[h][alt].empty()) {
+        continue;
+      }
+      auto it = index.find(matrix[h][alt]);
+      if (it != index.end()) {
+        multiplicity[it->second]++;
+        row_of_alt[h][alt] = it->second;
+      } else {
+        index[matrix[h][alt]] = rows.size();
+        row_of_alt[h][alt] = rows.size();
+        rows.push_back(matrix[h][alt]);
+        multiplicity.push_back(1);
+      }
+    }
+  }
+}
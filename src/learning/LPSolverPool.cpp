@@ -0,0 +1,30 @@
+#include "../../include/learning/LPSolverPool.h"
+
+LPSolverPool::LPSolverPool(AlternativesPerformance &ap, Config &conf)
+    : ap(ap), conf(conf) {}
+
+LPSolverPool::Lease LPSolverPool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!available.empty()) {
+      Lease lease = Lease(available.back().release(), Release{this});
+      available.pop_back();
+      return lease;
+    }
+  }
+  // creating a backend can be slow, it is done outside the lock
+  std::unique_ptr<LPSolver> solver = LPSolver::create(ap, conf);
+  std::lock_guard<std::mutex> lock(mutex);
+  n_solvers++;
+  return Lease(solver.release(), Release{this});
+}
+
+int LPSolverPool::getNumberSolvers() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return n_solvers;
+}
+
+void LPSolverPool::Release::operator()(LPSolver *solver) const {
+  std::lock_guard<std::mutex> lock(pool->mutex);
+  pool->available.push_back(std::unique_ptr<LPSolver>(solver));
+}
@@ -0,0 +1,422 @@
+#include "../../include/learning/LearningServer.h"
+#include "../../include/learning/WorkerProtocol.h"
+#include "../../include/types/DataGenerator.h"
+
+#include "yaml-cpp/yaml.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <poll.h>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+// the poll loop looks at the stop flag between two waits
+const int poll_timeout_ms = 200;
+
+// keys of the config only set by the server: its data directory, its sockets
+// and its number of threads
+const char *const server_keys[] = {"data_dir", "server_socket",
+                                   "coordinator_socket", "n_jobs"};
+
+// keys of a request giving a file of the data directory
+const char *const path_keys[] = {"dataset", "output", "lp_dump"};
+
+/**
+ * isInDataDir tells if a path given by a client stays in the data directory:
+ * relative, and without ".." component
+ *
+ * @param path path relative to the data directory
+ *
+ * @return true if the path is in the data directory
+ */
+bool isInDataDir(const std::string &path) {
+  std::filesystem::path p(path);
+  if (p.is_absolute()) {
+    return false;
+  }
+  for (const std::filesystem::path &part : p) {
+    if (part == "..") {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * checkRequest throws if a request changes a key only set by the server,
+ * gives a path out of the data directory or asks for more threads or islands
+ * than the config of the server
+ *
+ * @param request yaml mapping of the request
+ * @param conf config of the server
+ */
+void checkRequest(const YAML::Node &request, const Config &conf) {
+  for (const char *key : server_keys) {
+    if (request[key]) {
+      throw std::invalid_argument(std::string("A request cannot set ") + key);
+    }
+  }
+  for (const char *key : path_keys) {
+    if (request[key] && !isInDataDir(request[key].as<std::string>())) {
+      throw std::invalid_argument(
+          std::string("The ") + key +
+          " of a request must be a relative path in the data directory");
+    }
+  }
+  if (request["n_threads"] &&
+      request["n_threads"].as<int>() > std::max(conf.n_threads, 1)) {
+    throw std::invalid_argument(
+        "A request cannot use more threads than the server (n_threads: " +
+        std::to_string(conf.n_threads) + ")");
+  }
+  if (request["n_islands"] &&
+      request["n_islands"].as<int>() > std::max(conf.n_islands, 1)) {
+    throw std::invalid_argument(
+        "A request cannot use more islands than the server (n_islands: " +
+        std::to_string(conf.n_islands) + ")");
+  }
+}
+} // namespace
+
+LearningServer::LearningServer(Config &config)
+    : conf(config), listen_fd(-1), wake_fds{-1, -1}, stop(false), n_loads(0) {
+  if (conf.n_jobs < 1) {
+    throw std::invalid_argument("The number of jobs must be >= 1");
+  }
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (conf.server_socket.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument("Server socket path is too long");
+  }
+  std::strcpy(addr.sun_path, conf.server_socket.c_str());
+
+  // non blocking, the poll loop drains it without waiting and a full pipe
+  // already wakes it up
+  if (::pipe(wake_fds) < 0) {
+    throw std::runtime_error("Cannot create pipe");
+  }
+  ::fcntl(wake_fds[0], F_SETFL, O_NONBLOCK);
+  ::fcntl(wake_fds[1], F_SETFL, O_NONBLOCK);
+  listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listen_fd < 0) {
+    ::close(wake_fds[0]);
+    ::close(wake_fds[1]);
+    throw std::runtime_error("Cannot create socket");
+  }
+  // socket file left by a previous run
+  ::unlink(conf.server_socket.c_str());
+  // only the user running the server can connect to it
+  if (::bind(listen_fd, (sockaddr *)&addr, sizeof(addr)) < 0 ||
+      ::chmod(conf.server_socket.c_str(), S_IRUSR | S_IWUSR) < 0 ||
+      ::listen(listen_fd, SOMAXCONN) < 0) {
+    ::close(listen_fd);
+    ::close(wake_fds[0]);
+    ::close(wake_fds[1]);
+    throw std::runtime_error("Cannot listen on " + conf.server_socket + ": " +
+                             std::strerror(errno));
+  }
+}
+
+LearningServer::~LearningServer() {
+  for (int fd : idle_clients) {
+    ::close(fd);
+  }
+  for (int fd : clients) {
+    ::close(fd);
+  }
+  for (int fd : answered_clients) {
+    ::close(fd);
+  }
+  ::close(wake_fds[0]);
+  ::close(wake_fds[1]);
+  if (listen_fd >= 0) {
+    ::close(listen_fd);
+    ::unlink(conf.server_socket.c_str());
+  }
+}
+
+void LearningServer::serve() {
+  conf.logger->info("Serving on " + conf.server_socket + " with " +
+                    std::to_string(conf.n_jobs) + " threads");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < conf.n_jobs; t++) {
+    threads.emplace_back([this]() {
+      while (true) {
+        int fd;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          client_waiting.wait(lock,
+                              [this]() { return stop || !clients.empty(); });
+          if (stop) {
+            return;
+          }
+          fd = clients.front();
+          clients.pop_front();
+        }
+        this->serveClient(fd);
+      }
+    });
+  }
+
+  // the idle connections are polled here, a connection goes to a thread when
+  // its client sent a request and comes back once it is answered
+  std::vector<pollfd> fds;
+  while (!stop) {
+    fds.clear();
+    fds.push_back({listen_fd, POLLIN, 0});
+    fds.push_back({wake_fds[0], POLLIN, 0});
+    for (int fd : idle_clients) {
+      fds.push_back({fd, POLLIN, 0});
+    }
+    int ready = ::poll(fds.data(), fds.size(), poll_timeout_ms);
+    if (ready < 0 && errno != EINTR) {
+      conf.logger->error("Server poll failed: " +
+                         std::string(std::strerror(errno)));
+      stop = true;
+    }
+    if (ready <= 0) {
+      continue;
+    }
+
+    std::vector<int> still_idle;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (int p = 2; p < fds.size(); p++) {
+        if (fds[p].revents & POLLIN) {
+          clients.push_back(fds[p].fd);
+          client_waiting.notify_one();
+        } else if (fds[p].revents != 0) {
+          // hung up without a pending request
+          ::close(fds[p].fd);
+        } else {
+          still_idle.push_back(fds[p].fd);
+        }
+      }
+      if (fds[1].revents != 0) {
+        char wake[64];
+        while (::read(wake_fds[0], wake, sizeof(wake)) > 0) {
+        }
+        still_idle.insert(still_idle.end(), answered_clients.begin(),
+                          answered_clients.end());
+        answered_clients.clear();
+      }
+    }
+    idle_clients = std::move(still_idle);
+    if (fds[0].revents != 0) {
+      int fd = ::accept(listen_fd, nullptr, nullptr);
+      if (fd >= 0) {
+        idle_clients.push_back(fd);
+      }
+    }
+  }
+
+  {
+    // wakes up the threads waiting for a client
+    std::lock_guard<std::mutex> lock(mutex);
+    client_waiting.notify_all();
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  conf.logger->info("Server stopped");
+}
+
+void LearningServer::serveClient(int fd) {
+  try {
+    this->handleRequest(fd);
+  } catch (const std::exception &e) {
+    // the client is gone
+    ::close(fd);
+    return;
+  }
+  // the connection goes back to the polled ones until its next request
+  std::lock_guard<std::mutex> lock(mutex);
+  answered_clients.push_back(fd);
+  char wake = 0;
+  // fails only when the pipe is full, the poll loop is then woken up anyway
+  (void)!::write(wake_fds[1], &wake, 1);
+}
+
+void LearningServer::handleRequest(int fd) {
+  std::string payload;
+  MessageType type;
+  try {
+    type = receiveMessage(fd, payload);
+  } catch (const std::length_error &e) {
+    // the payload is left unread, the connection cannot go on
+    conf.logger->warn(std::string("Request rejected: ") + e.what());
+    sendMessage(fd, MessageType::Error, e.what());
+    throw;
+  }
+  try {
+    switch (type) {
+    case MessageType::Learn:
+      sendMessage(fd, MessageType::Model, this->learn(payload));
+      return;
+    case MessageType::Predict:
+      sendMessage(fd, MessageType::Assignments, this->predict(payload));
+      return;
+    case MessageType::Shutdown:
+      conf.logger->info("Shutdown requested by a client");
+      stop = true;
+      sendMessage(fd, MessageType::Ack);
+      return;
+    default:
+      throw std::invalid_argument("Unexpected request");
+    }
+  } catch (const std::exception &e) {
+    // the error is the answer, the client may send other requests
+    conf.logger->warn(std::string("Request failed: ") + e.what());
+    sendMessage(fd, MessageType::Error, e.what());
+  }
+}
+
+std::shared_ptr<AlternativesPerformance>
+LearningServer::getDataset(Config &config) {
+  std::string data_path = config.data_dir + config.dataset;
+  std::error_code ec;
+  std::filesystem::file_time_type write_time =
+      std::filesystem::last_write_time(data_path, ec);
+  if (ec) {
+    throw std::invalid_argument("No file found in dataset path: " + data_path);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto resident = datasets.find(data_path);
+    if (resident != datasets.end() &&
+        resident->second.write_time == write_time) {
+      return resident->second.dataset;
+    }
+  }
+  // parsed without the lock, the other requests go on meanwhile
+  DataGenerator dg = DataGenerator(config);
+  std::shared_ptr<AlternativesPerformance> dataset =
+      std::make_shared<AlternativesPerformance>(
+          dg.loadDataset(config.dataset));
+  n_loads++;
+  conf.logger->info("Dataset " + data_path + " loaded");
+  std::lock_guard<std::mutex> lock(mutex);
+  datasets.insert_or_assign(data_path, ResidentDataset{write_time, dataset});
+  return dataset;
+}
+
+std::shared_ptr<const AssignmentKernel> LearningServer::getKernel(
+    Config &config, const std::shared_ptr<AlternativesPerformance> &dataset) {
+  std::string data_path = config.data_dir + config.dataset;
+  int encoding = config.rank_encoding ? 1 : 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto resident = datasets.find(data_path);
+    if (resident != datasets.end() && resident->second.dataset == dataset &&
+        resident->second.kernels[encoding] != nullptr) {
+      return resident->second.kernels[encoding];
+    }
+  }
+  // built without the lock, as the datasets, and only kept if the dataset was
+  // not reloaded meanwhile
+  std::shared_ptr<const AssignmentKernel> kernel =
+      std::make_shared<AssignmentKernel>(*dataset, config.rank_encoding);
+  std::lock_guard<std::mutex> lock(mutex);
+  auto resident = datasets.find(data_path);
+  if (resident != datasets.end() && resident->second.dataset == dataset) {
+    resident->second.kernels[encoding] = kernel;
+  }
+  return kernel;
+}
+
+std::string LearningServer::learn(const std::string &request) {
+  YAML::Node yml_request = YAML::Load(request);
+  if (!yml_request["dataset"] || !yml_request["output"]) {
+    throw std::invalid_argument(
+        "A learn request must have a dataset and an output");
+  }
+  Config job_conf = conf;
+  checkRequest(yml_request, conf);
+  App::readParameters(yml_request, job_conf);
+  job_conf.dataset = yml_request["dataset"].as<std::string>();
+  job_conf.output = yml_request["output"].as<std::string>();
+  // the metrics and the trace of a learning are saved with its model
+  job_conf.metrics = std::make_shared<Metrics>();
+  job_conf.tracer = std::make_shared<Tracer>();
+  job_conf.tracer->enable(job_conf.trace);
+
+  std::shared_ptr<AlternativesPerformance> dataset = this->getDataset(job_conf);
+  std::shared_ptr<const AssignmentKernel> kernel =
+      this->getKernel(job_conf, dataset);
+  conf.logger->info("Learning on " + job_conf.dataset);
+  App app = App(job_conf);
+  MRSortModel model = app.learn(*dataset, kernel);
+  DataGenerator dg = DataGenerator(job_conf);
+  dg.saveModel(job_conf.output, model.lambda, model.criteria, model.profiles,
+               true, model.getId());
+  app.saveMetrics();
+  app.saveTrace();
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    models.insert_or_assign(job_conf.output, model);
+  }
+
+  std::ifstream model_file(job_conf.data_dir + job_conf.output);
+  std::ostringstream model_xml;
+  model_xml << model_file.rdbuf();
+  return model_xml.str();
+}
+
+std::string LearningServer::predict(const std::string &request) {
+  YAML::Node yml_request = YAML::Load(request);
+  if (!yml_request["model"] || !yml_request["dataset"]) {
+    throw std::invalid_argument(
+        "A predict request must have a model and a dataset");
+  }
+  std::string model_name = yml_request["model"].as<std::string>();
+  std::unique_ptr<MRSortModel> model;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto learned = models.find(model_name);
+    if (learned == models.end()) {
+      throw std::invalid_argument("No model learned in " + model_name);
+    }
+    model = std::make_unique<MRSortModel>(learned->second);
+  }
+  if (model->profiles.getMode() != "alt") {
+    model->profiles.changeMode("alt");
+  }
+
+  Config job_conf = conf;
+  checkRequest(yml_request, conf);
+  App::readParameters(yml_request, job_conf);
+  job_conf.dataset = yml_request["dataset"].as<std::string>();
+  std::shared_ptr<AlternativesPerformance> dataset = this->getDataset(job_conf);
+  // the resident dataset is shared with the other requests, it is not changed
+  std::unique_ptr<PerformanceTable> alt_pt;
+  PerformanceTable *pt = dataset.get();
+  if (dataset->getMode() != "alt") {
+    alt_pt = std::make_unique<PerformanceTable>(*dataset);
+    alt_pt->changeMode("alt");
+    pt = alt_pt.get();
+  }
+
+  AlternativesPerformance assigned = model->categoryAssignments(*pt);
+  const std::unordered_map<std::string, Category> &assignments =
+      assigned.getAlternativesAssignments();
+  std::ostringstream out;
+  for (const std::vector<Perf> &alt : pt->getPerformanceTable()) {
+    out << alt[0].name_ << " " << assignments.at(alt[0].name_).category_id_
+        << "\n";
+  }
+  return out.str();
+}
+
+int LearningServer::getNumberLoads() const { return n_loads; }
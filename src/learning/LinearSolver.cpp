@@ -1,27 +1,35 @@
 #include "../../include/learning/LinearSolver.h"
 #include "../../include/app.h"
+#include "../../include/logging.h"
 #include "../../include/types/AlternativesPerformance.h"
 #include "ortools/linear_solver/linear_solver.h"
 
-#include <sstream>
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
 #include <string>
 
 LinearSolver::LinearSolver(AlternativesPerformance &ap, Config &conf,
                            float delta, std::string solver_name)
-    : ap(ap), conf(conf) {
-  solver = operations_research::MPSolver::CreateSolver(solver_name);
-  solver_name = solver_name;
-  delta = delta;
+    : ap(ap), conf(conf), rows_metric(conf.metrics->histogram("lp.rows")),
+      iterations_metric(conf.metrics->histogram("lp.iterations")) {
+  solver.reset(operations_research::MPSolver::CreateSolver(solver_name));
+  if (solver == nullptr) {
+    throw std::invalid_argument("Unknown linear solver " + solver_name);
+  }
+  this->solver_name = solver_name;
+  this->delta = delta;
 }
 
-LinearSolver::~LinearSolver() { delete solver; }
+LinearSolver::~LinearSolver() {}
 
 AlternativesPerformance &LinearSolver::getAlternativesPerformance() const {
   return ap;
 }
 
 operations_research::MPSolver *LinearSolver::getSolver() const {
-  return solver;
+  return solver.get();
 }
 
 Config LinearSolver::getConf() const { return conf; }
@@ -47,7 +55,52 @@ std::vector<operations_research::MPVariable *> LinearSolver::getYap() const {
   return y_ap;
 }
 
+std::vector<std::vector<int>> LinearSolver::getXRows() const { return x_rows; }
+
+std::vector<std::vector<int>> LinearSolver::getYRows() const { return y_rows; }
+
+std::string LinearSolver::lpName(const std::string &prefix, int index,
+                                 int alt) const {
+  if (conf.lp_dump.empty()) {
+    return "";
+  }
+  std::string name = prefix;
+  if (index >= 0) {
+    name += std::to_string(index);
+  }
+  if (alt >= 0) {
+    name += "_a" + std::to_string(alt);
+  }
+  return name;
+}
+
+namespace {
+// the solvers of all the threads and islands export to the same file, one
+// at a time
+std::mutex export_mutex;
+} // namespace
+
+bool LinearSolver::exportModel(std::string file_name) const {
+  std::string model;
+  bool mps = file_name.size() >= 4 &&
+             file_name.compare(file_name.size() - 4, 4, ".mps") == 0;
+  bool exported = mps ? solver->ExportModelAsMpsFormat(false, false, &model)
+                      : solver->ExportModelAsLpFormat(false, &model);
+  std::lock_guard<std::mutex> lock(export_mutex);
+  std::ofstream file(file_name);
+  if (!exported || !file) {
+    conf.logger->warn("Cannot export the linear problem to " + file_name);
+    return false;
+  }
+  file << model;
+  return true;
+}
+
 void LinearSolver::initializeSolver() {
+  this->initializeSolver(ap.getNumberAlt());
+}
+
+void LinearSolver::initializeSolver(int n_alt) {
 
   // reset constraints vectors
   x_constraints.clear();
@@ -60,6 +113,8 @@ void LinearSolver::initializeSolver() {
   y_a.clear();
   y_ap.clear();
   weights.clear();
+  x_rows.clear();
+  y_rows.clear();
 
   // reset previous solver
   solver->Clear();
@@ -68,33 +123,29 @@ void LinearSolver::initializeSolver() {
 
   // weight variables
   for (int i = 0; i < ap.getNumberCrit(); i++) {
-    weights.push_back(solver->MakeNumVar(0., 1.0, "w" + std::to_string(i)));
+    weights.push_back(solver->MakeNumVar(0., 1.0, lpName("w", i)));
   }
 
-  // x, x' (xp), y, y' (yp) variables
-  for (int i = 0; i < ap.getNumberAlt(); i++) {
-    x_a.push_back(solver->MakeNumVar(0., infinity, "x" + std::to_string(i)));
-    x_ap.push_back(solver->MakeNumVar(0., infinity, "xp" + std::to_string(i)));
-    y_a.push_back(solver->MakeNumVar(0., infinity, "y" + std::to_string(i)));
-    y_ap.push_back(solver->MakeNumVar(0., infinity, "yp" + std::to_string(i)));
+  // x, x' (xp), y, y' (yp) variables, one of each per alternative. When the
+  // problem is reduced, they are created per distinct row by updateConstraints
+  if (!conf.reduce_lp) {
+    for (int i = 0; i < n_alt; i++) {
+      x_a.push_back(solver->MakeNumVar(0., infinity, lpName("x", i)));
+      x_ap.push_back(solver->MakeNumVar(0., infinity, lpName("xp", i)));
+      y_a.push_back(solver->MakeNumVar(0., infinity, lpName("y", i)));
+      y_ap.push_back(solver->MakeNumVar(0., infinity, lpName("yp", i)));
+    }
   }
 
   // lambda variable
-  lambda = solver->MakeNumVar(0.5, 1.0, "lambda");
+  lambda = solver->MakeNumVar(0.5, 1.0, lpName("lambda", -1));
 
-  // sum weight = 1 constraint: -sum <= -1 and sum <= 1
-  // -sum <= -1
-  auto w_maj = solver->MakeRowConstraint(-infinity, -1, "weight_constraint_p");
+  // sum weight = 1 constraint, as a single equality row
+  auto w_sum = solver->MakeRowConstraint(1, 1, lpName("weight_constraint", -1));
   for (operations_research::MPVariable *w_i : weights) {
-    w_maj->SetCoefficient(w_i, -1);
+    w_sum->SetCoefficient(w_i, 1);
   }
-  weights_constraint.push_back(w_maj);
-  // sum <= 1
-  auto w_min = solver->MakeRowConstraint(-infinity, 1, "weight_constraint_m");
-  for (operations_research::MPVariable *w_i : weights) {
-    w_min->SetCoefficient(w_i, 1);
-  }
-  weights_constraint.push_back(w_min);
+  weights_constraint.push_back(w_sum);
 
   // objective function, minimize sum(xp + yp)
   operations_research::MPObjective *const objective =
@@ -112,10 +163,21 @@ void LinearSolver::updateConstraints(
     std::vector<std::vector<std::vector<bool>>> x_matrix,
     std::vector<std::vector<std::vector<bool>>> y_matrix) {
 
-  // re-initialise solver with variable and default constraint
-  this->initializeSolver();
+  // re-initialise solver with variable and default constraint, for the
+  // alternatives of the matrices only
+  int n_alt = 0;
+  for (const std::vector<std::vector<bool>> &x_h : x_matrix) {
+    n_alt = std::max(n_alt, int(x_h.size()));
+  }
+  for (const std::vector<std::vector<bool>> &y_h : y_matrix) {
+    n_alt = std::max(n_alt, int(y_h.size()));
+  }
+  this->initializeSolver(n_alt);
 
-  const double infinity = solver->infinity();
+  if (conf.reduce_lp) {
+    this->addReducedConstraints(x_matrix, y_matrix);
+    return;
+  }
 
   // add new constraints given the matrixs
 
@@ -126,42 +188,8 @@ void LinearSolver::updateConstraints(
     for (int alt = 0; alt < x_matrix[h].size(); alt++) {
       // if alt is empty the alt was not assigned to this category (h)
       if (!x_matrix[h][alt].empty()) {
-        // create constraint with name cst_x_b2_a6
-        // as with ORTools, the form of the Linear Problem is cannonical, we
-        // need to add two constraints from the equality : cst_x_b2_a6 = 0 <-->
-        // cst_x_b2_a6_- <= 0 and cst_x_b2_a6_+ >= 0
-
-        // cst_x_b2_a6_+ : - cst_x_b2_a6 <= 0
-        operations_research::MPConstraint *cst_min = solver->MakeRowConstraint(
-            -infinity, 0,
-            "cst_x_b" + std::to_string(h) + "_a" + std::to_string(alt) + "_+");
-
-        // cst_x_b2_a6_- : cst_x_b2_a6 <= 0
-        operations_research::MPConstraint *cst_maj = solver->MakeRowConstraint(
-            -infinity, 0,
-            "cst_x_b" + std::to_string(h) + "_a" + std::to_string(alt) + "_-");
-
-        // -lambda
-        cst_min->SetCoefficient(lambda, -1);
-        cst_maj->SetCoefficient(lambda, 1);
-
-        // -x_a
-        cst_min->SetCoefficient(x_a[alt], -1);
-        cst_maj->SetCoefficient(x_a[alt], 1);
-
-        // +x_ap
-        cst_min->SetCoefficient(x_ap[alt], 1);
-        cst_maj->SetCoefficient(x_ap[alt], -1);
-
-        // +sum(w_j(a_i, b_h-1) if a_i>=bi_h-1)
-        for (int crit = 0; crit < x_matrix[h][alt].size(); crit++) {
-          if (x_matrix[h][alt][crit]) {
-            cst_min->SetCoefficient(weights[crit], 1);
-            cst_maj->SetCoefficient(weights[crit], -1);
-          }
-        }
-        x_constraints.push_back(cst_min);
-        x_constraints.push_back(cst_maj);
+        this->addXConstraints(x_matrix[h][alt], x_a[alt], x_ap[alt],
+                              lpName("cst_x_b", h, alt));
       }
     }
   }
@@ -170,51 +198,104 @@ void LinearSolver::updateConstraints(
   for (int h = 0; h < y_matrix.size(); h++) {
     for (int alt = 0; alt < y_matrix[h].size(); alt++) {
       if (!y_matrix[h][alt].empty()) {
-        // create constraint with name cst_y_b2_a6 for ex
-        operations_research::MPConstraint *cst_min = solver->MakeRowConstraint(
-            -infinity, -delta,
-            "cst_y_h" + std::to_string(h) + "_a" + std::to_string(alt));
-        operations_research::MPConstraint *cst_maj = solver->MakeRowConstraint(
-            -infinity, delta,
-            "cst_y_h" + std::to_string(h) + "_a" + std::to_string(alt));
-
-        cst_min->SetCoefficient(lambda, -1);
-        cst_maj->SetCoefficient(lambda, 1);
-
-        cst_min->SetCoefficient(y_a[alt], 1);
-        cst_maj->SetCoefficient(y_a[alt], -1);
-
-        cst_min->SetCoefficient(y_ap[alt], -1);
-        cst_maj->SetCoefficient(y_ap[alt], 1);
-
-        for (int crit = 0; crit < y_matrix[h][alt].size(); crit++) {
-          if (y_matrix[h][alt][crit]) {
-            cst_min->SetCoefficient(weights[crit], 1);
-            cst_maj->SetCoefficient(weights[crit], -1);
-          }
-        }
-
-        y_constraints.push_back(cst_min);
-        y_constraints.push_back(cst_maj);
+        this->addYConstraints(y_matrix[h][alt], y_a[alt], y_ap[alt],
+                              lpName("cst_y_h", h, alt));
       }
     }
   }
 }
 
+void LinearSolver::addReducedConstraints(
+    std::vector<std::vector<std::vector<bool>>> &x_matrix,
+    std::vector<std::vector<std::vector<bool>>> &y_matrix) {
+  const double infinity = solver->infinity();
+  operations_research::MPObjective *const objective =
+      solver->MutableObjective();
+
+  // The row of an alternative only depends on its comparison vector, the
+  // profile appears nowhere else. Alternatives sharing the same vector (on
+  // any profile) share the same x, x' (or y, y') variables, the optimal x'
+  // being the same for all of them: the row is added once and its x' is
+  // weighted in the objective by the number of alternatives it stands for.
+  std::vector<std::vector<bool>> x_distinct;
+  std::vector<int> x_multiplicity;
+  LPSolver::distinctRows(x_matrix, x_distinct, x_multiplicity, x_rows);
+  for (int r = 0; r < x_distinct.size(); r++) {
+    x_a.push_back(solver->MakeNumVar(0., infinity, lpName("x", r)));
+    x_ap.push_back(solver->MakeNumVar(0., infinity, lpName("xp", r)));
+    this->addXConstraints(x_distinct[r], x_a[r], x_ap[r], lpName("cst_x_r", r));
+    objective->SetCoefficient(x_ap[r], x_multiplicity[r]);
+  }
+
+  std::vector<std::vector<bool>> y_distinct;
+  std::vector<int> y_multiplicity;
+  LPSolver::distinctRows(y_matrix, y_distinct, y_multiplicity, y_rows);
+  for (int r = 0; r < y_distinct.size(); r++) {
+    y_a.push_back(solver->MakeNumVar(0., infinity, lpName("y", r)));
+    y_ap.push_back(solver->MakeNumVar(0., infinity, lpName("yp", r)));
+    this->addYConstraints(y_distinct[r], y_a[r], y_ap[r], lpName("cst_y_r", r));
+    objective->SetCoefficient(y_ap[r], y_multiplicity[r]);
+  }
+  FASTPL_DEBUG(conf.logger, "Reduced linear problem - {} distinct rows",
+               x_ap.size() + y_ap.size());
+}
+
+void LinearSolver::addXConstraints(std::vector<bool> &x_row,
+                                   operations_research::MPVariable *x,
+                                   operations_research::MPVariable *xp,
+                                   std::string name) {
+  // cst_x_b2_a6 : sum(w_j(a_i, b_h-1) if a_i>=bi_h-1) - lambda - x + xp = 0,
+  // as a single equality row (lower and upper bounds set to 0)
+  operations_research::MPConstraint *cst =
+      solver->MakeRowConstraint(0, 0, name);
+
+  cst->SetCoefficient(lambda, -1);
+  cst->SetCoefficient(x, -1);
+  cst->SetCoefficient(xp, 1);
+  for (int crit = 0; crit < x_row.size(); crit++) {
+    if (x_row[crit]) {
+      cst->SetCoefficient(weights[crit], 1);
+    }
+  }
+  x_constraints.push_back(cst);
+}
+
+void LinearSolver::addYConstraints(std::vector<bool> &y_row,
+                                   operations_research::MPVariable *y,
+                                   operations_research::MPVariable *yp,
+                                   std::string name) {
+  // cst_y_b2_a6 : sum(w_j(a_i, b_h) if a_i>=bi_h) - lambda + y - yp = -delta
+  operations_research::MPConstraint *cst =
+      solver->MakeRowConstraint(-delta, -delta, name);
+
+  cst->SetCoefficient(lambda, -1);
+  cst->SetCoefficient(y, 1);
+  cst->SetCoefficient(yp, -1);
+  for (int crit = 0; crit < y_row.size(); crit++) {
+    if (y_row[crit]) {
+      cst->SetCoefficient(weights[crit], 1);
+    }
+  }
+  y_constraints.push_back(cst);
+}
+
 std::pair<float, std::vector<float>>
 LinearSolver::solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
                     std::vector<std::vector<std::vector<bool>>> y_matrix) {
   this->updateConstraints(x_matrix, y_matrix);
+  if (!conf.lp_dump.empty()) {
+    this->exportModel(conf.data_dir + conf.lp_dump);
+  }
   const operations_research::MPSolver::ResultStatus result_status =
       solver->Solve();
   if (result_status != operations_research::MPSolver::OPTIMAL) {
     conf.logger->warn("Solver couldn't find an optimal solution.");
     throw std::logic_error("Solver couldn't find an optimal solution");
   }
-  std::ostringstream ss;
-  ss << "Problem solved - " << solver->wall_time() << " ms, "
-     << solver->iterations() << " iterations.";
-  conf.logger->debug(ss.str());
+  FASTPL_DEBUG(conf.logger, "Problem solved - {} ms, {} iterations.",
+               solver->wall_time(), solver->iterations());
+  rows_metric.record(solver->NumConstraints());
+  iterations_metric.record(solver->iterations());
 
   std::vector<float> weight_values;
   for (auto w_i : weights) {
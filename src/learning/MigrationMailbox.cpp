@@ -0,0 +1,24 @@
+#include "../../include/learning/MigrationMailbox.h"
+
+#include <vector>
+
+MigrationMailbox::MigrationMailbox() : slot_(nullptr) {}
+
+MigrationMailbox::~MigrationMailbox() { delete slot_.exchange(nullptr); }
+
+void MigrationMailbox::post(const std::vector<MRSortModel> &migrants) {
+  std::vector<MRSortModel> *batch = new std::vector<MRSortModel>(migrants);
+  // the previous batch, if not collected, is owned by us after the exchange
+  delete slot_.exchange(batch, std::memory_order_acq_rel);
+}
+
+std::vector<MRSortModel> MigrationMailbox::collect() {
+  std::vector<MRSortModel> *batch =
+      slot_.exchange(nullptr, std::memory_order_acq_rel);
+  if (batch == nullptr) {
+    return std::vector<MRSortModel>();
+  }
+  std::vector<MRSortModel> migrants = *batch;
+  delete batch;
+  return migrants;
+}
@@ -0,0 +1,52 @@
+#include "../../include/learning/ModelCheckpointer.h"
+#include "../../include/types/DataGenerator.h"
+#include "../../include/types/MRSortModel.h"
+
+#include <filesystem>
+#include <string>
+
+ModelCheckpointer::ModelCheckpointer(Config &config)
+    : conf(config), last_checkpoint_(std::chrono::steady_clock::now()),
+      n_checkpoints_(0) {}
+
+ModelCheckpointer::~ModelCheckpointer() { this->wait(); }
+
+bool ModelCheckpointer::isDue() const {
+  if (conf.checkpoint_interval_seconds <= 0 || conf.output == "") {
+    return false;
+  }
+  const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - last_checkpoint_;
+  return elapsed.count() >= conf.checkpoint_interval_seconds;
+}
+
+void ModelCheckpointer::save(const MRSortModel &model) {
+  this->wait();
+  last_checkpoint_ = std::chrono::steady_clock::now();
+  n_checkpoints_++;
+
+  Config &config = conf;
+  pending_ = std::async(std::launch::async, [&config, checkpoint = model]() {
+    std::string tmp_output = config.output + ".tmp";
+    try {
+      DataGenerator dg = DataGenerator(config);
+      dg.saveModel(tmp_output, checkpoint.lambda, checkpoint.criteria,
+                   checkpoint.profiles, true, checkpoint.getId());
+      std::filesystem::rename(config.data_dir + tmp_output,
+                              config.data_dir + config.output);
+      config.logger->info("Checkpoint saved, best model has a score of: " +
+                          std::to_string(checkpoint.getScore()));
+    } catch (const std::exception &e) {
+      // a failed checkpoint must not stop the learning
+      config.logger->warn(std::string("Checkpoint failed: ") + e.what());
+    }
+  });
+}
+
+void ModelCheckpointer::wait() {
+  if (pending_.valid()) {
+    pending_.get();
+  }
+}
+
+int ModelCheckpointer::getNumberCheckpoints() const { return n_checkpoints_; }
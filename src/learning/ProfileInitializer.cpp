@@ -2,6 +2,7 @@
 #include "../../extsrc/spdlog/include/spdlog/spdlog.h"
 
 #include "../../include/learning/ProfileInitializer.h"
+#include "../../include/logging.h"
 #include "../../include/types/AlternativesPerformance.h"
 #include "../../include/types/Categories.h"
 #include "../../include/types/Criteria.h"
@@ -22,12 +23,12 @@
 ProfileInitializer::ProfileInitializer(Config &config,
                                        AlternativesPerformance &altPerfs)
     : conf(config), altPerformance_(altPerfs) {
-  conf.logger->debug("Starting ProfileInitializer object...");
+  FASTPL_DEBUG(conf.logger, "Starting ProfileInitializer object...");
 }
 
 ProfileInitializer::ProfileInitializer(const ProfileInitializer &profInit)
     : conf(profInit.conf), altPerformance_(profInit.altPerformance_) {
-  conf.logger->debug("Starting ProfileInitializer object...");
+  FASTPL_DEBUG(conf.logger, "Starting ProfileInitializer object...");
 }
 
 AlternativesPerformance ProfileInitializer::getAlternativesPerformance() const {
@@ -46,7 +47,7 @@ std::vector<float> ProfileInitializer::categoryFrequency() {
   // Extraction category rank from each alternative and storing it in values
   // SOMETIMES THIS DOESNT WORK this is seen as Segmentation Fault when using
   // InitProfile
-  std::unordered_map<std::string, Category> map =
+  const std::unordered_map<std::string, Category> &map =
       altPerformance_.getAlternativesAssignments();
   std::vector<int> values(map.size());
 
@@ -95,12 +96,12 @@ std::vector<Perf> ProfileInitializer::getProfilePerformanceCandidates(
     catAbove = catBelow + 1;
   }
 
-  for (std::vector<Perf> &vPerf : altPerformance_.getPerformanceTable()) {
+  for (const std::vector<Perf> &vPerf : altPerformance_.getPerformanceTable()) {
     if (altPerformance_.getAlternativeAssignment(vPerf[0].name_).rank_ ==
             catBelow ||
         altPerformance_.getAlternativeAssignment(vPerf[0].name_).rank_ ==
             catAbove) {
-      for (Perf &p : vPerf) {
+      for (const Perf &p : vPerf) {
         if (p.crit_ == crit.getId()) {
           candidates.push_back(p);
           break;
@@ -1,4 +1,5 @@
 #include "../../include/learning/ProfileUpdater.h"
+#include "../../include/logging.h"
 #include "../../include/utils.h"
 
 #include <algorithm>
@@ -8,30 +9,35 @@
 #include <random>
 #include <string>
 #include <typeinfo>
+#include <utility>
 
 ProfileUpdater::ProfileUpdater(Config &conf,
                                AlternativesPerformance &altPerf_data,
                                float epsilon)
-    : conf(conf), altPerf_data(altPerf_data), epsilon_(epsilon) {
-  conf.logger->debug("Starting ProfileUpdater object...");
+    : conf(conf), altPerf_data(altPerf_data), epsilon_(epsilon),
+      moves_proposed(conf.metrics->counter("profile_update.moves_proposed")),
+      moves_accepted(conf.metrics->counter("profile_update.moves_accepted")) {
+  FASTPL_DEBUG(conf.logger, "Starting ProfileUpdater object...");
 }
 
 ProfileUpdater::ProfileUpdater(const ProfileUpdater &profUp)
     : conf(profUp.conf), altPerf_data(profUp.altPerf_data),
-      epsilon_(profUp.epsilon_) {
-  conf.logger->debug("Starting ProfileUpdater object...");
+      epsilon_(profUp.epsilon_), moves_proposed(profUp.moves_proposed),
+      moves_accepted(profUp.moves_accepted) {
+  FASTPL_DEBUG(conf.logger, "Starting ProfileUpdater object...");
 }
 
 ProfileUpdater::~ProfileUpdater() {}
 
-std::unordered_map<float, float> ProfileUpdater::computeAboveDesirability(
+ProfileUpdater::Desirability ProfileUpdater::computeAboveDesirability(
     MRSortModel &model, std::string critId, Perf &b, Perf &b_above,
     Category &cat, Category &cat_above,
     std::unordered_map<std::string, float> &ct_prof,
-    AlternativesPerformance &altPerf_model) {
+    AlternativesPerformance &altPerf_model,
+    std::pmr::memory_resource *resource) {
   // Data from the problem
   float lambda = model.lambda;
-  float weight = model.criteria[critId].getWeight();
+  float weight = model.criteria.getWeight(critId);
   float epsilon = this->epsilon_;
 
   // Alternatives between given profile and above profile. AltPerf_model needs
@@ -42,7 +48,7 @@ std::unordered_map<float, float> ProfileUpdater::computeAboveDesirability(
   std::vector<Perf> alt_between =
       altPerf_model.getAltBetweenSorted(critId, b.value_, b_above.value_);
   // Initializing the map of desirability indexes
-  std::unordered_map<float, float> desirability_above;
+  Desirability desirability_above(resource);
   float numerator = 0;
   float denominator = 0;
 
@@ -100,14 +106,15 @@ std::unordered_map<float, float> ProfileUpdater::computeAboveDesirability(
   return desirability_above;
 }
 
-std::unordered_map<float, float> ProfileUpdater::computeBelowDesirability(
+ProfileUpdater::Desirability ProfileUpdater::computeBelowDesirability(
     MRSortModel &model, std::string critId, Perf &b, Perf &b_below,
     Category &cat, Category &cat_above,
     std::unordered_map<std::string, float> &ct_prof,
-    AlternativesPerformance &altPerf_model) {
+    AlternativesPerformance &altPerf_model,
+    std::pmr::memory_resource *resource) {
   // Data from the problem
   float lambda = model.lambda;
-  float weight = model.criteria[critId].getWeight();
+  float weight = model.criteria.getWeight(critId);
   // Direction & epsilon not in original algorithm
   float epsilon = this->epsilon_;
 
@@ -119,13 +126,13 @@ std::unordered_map<float, float> ProfileUpdater::computeBelowDesirability(
   std::vector<Perf> alt_between =
       altPerf_model.getAltBetweenSorted(critId, b_below.value_, b.value_);
   // Initializing the map of desirability indexes
-  std::unordered_map<float, float> desirability_below;
+  Desirability desirability_below(resource);
   float numerator = 0;
   float denominator = 0;
 
   // Going in reverse order as we are moving the profile down
   for (int i = alt_between.size() - 1; i >= 0; i--) {
-    Perf alt = alt_between[i];
+    Perf &alt = alt_between[i];
     // Checking if the move will not go below b_below
     if ((alt.value_ - epsilon) > b_below.value_) {
       std::string altName = alt.name_;
@@ -180,8 +187,8 @@ std::unordered_map<float, float> ProfileUpdater::computeBelowDesirability(
   return desirability_below;
 }
 
-std::pair<float, float> ProfileUpdater::chooseMaxDesirability(
-    std::unordered_map<float, float> &desirability, Perf &b) {
+std::pair<float, float>
+ProfileUpdater::chooseMaxDesirability(Desirability &desirability, Perf &b) {
   float key_max = 0;
   float value_max = 0;
   for (auto it = desirability.begin(); it != desirability.end(); ++it) {
@@ -200,6 +207,10 @@ void ProfileUpdater::updateTables(
   if (b_old.name_ != b_new.name_ || b_old.crit_ != b_new.crit_) {
     throw std::invalid_argument("Profile perfs must have same name and crit");
   }
+  if (altPerf_data.getMode() != "alt") {
+    throw std::invalid_argument(
+        "Performance table set in wrong mode, should be alt.");
+  }
 
   float w = 0;
   // Determine if the profile is moving up or down to know how to adjust the
@@ -207,15 +218,25 @@ void ProfileUpdater::updateTables(
   // perf and new profile perf.
   std::vector<Perf> alt_between;
   if (b_old.value_ > b_new.value_) {
-    w = model.criteria[critId].getWeight();
+    w = model.criteria.getWeight(critId);
     alt_between =
         altPerf_model.getAltBetween(critId, b_new.value_, b_old.value_);
   } else {
-    w = -model.criteria[critId].getWeight();
+    w = -model.criteria.getWeight(critId);
     alt_between =
         altPerf_model.getAltBetween(critId, b_old.value_, b_new.value_);
   }
 
+  // the profile used by the new assignments only changes once
+  if (!alt_between.empty()) {
+    model.profiles.setPerf(b_new.name_, b_new.crit_, b_new.value_);
+  }
+  const std::vector<std::vector<Perf>> &pt =
+      model.profiles.getPerformanceTable();
+  int n_alt = altPerf_data.getNumberAlt();
+  float change = static_cast<float>(1) / static_cast<float>(n_alt);
+  bool aligned = model.isAligned(pt, altPerf_data);
+
   for (Perf &alt : alt_between) {
     // Data assignment
     std::string aa_data =
@@ -227,22 +248,17 @@ void ProfileUpdater::updateTables(
     // Update concordance table
     float c = ct[b_old.name_][alt.name_] + w;
     ct[b_old.name_][alt.name_] = c;
-    // Update profile
-    model.profiles.setPerf(b_new.name_, b_new.crit_, b_new.value_);
 
-    // New assignment
-    altPerf_model.changeMode("alt");
-    auto alternative = altPerf_model.operator[](alt.name_);
-    std::vector<std::vector<Perf>> pt = model.profiles.getPerformanceTable();
-    Category cat_new = model.categoryAssignment(alternative, pt);
+    // New assignment, the alternative is read in the dataset so that
+    // altPerf_model keeps its mode and its sort for the next moves
+    const std::vector<Perf> &alternative = altPerf_data[alt.name_];
+    Category cat_new = model.categoryAssignment(alternative, pt, aligned);
     std::string aa_new = cat_new.category_id_;
 
     // Update alternative assignment
     altPerf_model.setAlternativeAssignment(alt.name_, cat_new);
 
     // Update model score
-    int n_alt = altPerf_data.getNumberAlt();
-    float change = static_cast<float>(1) / static_cast<float>(n_alt);
     if (aa_old == aa_new) {
       break;
     } else if (aa_old == aa_data) {
@@ -254,33 +270,35 @@ void ProfileUpdater::updateTables(
 }
 
 void ProfileUpdater::optimizeProfile(
-    std::vector<Perf> &prof, Category &cat_below, Category &cat_above,
+    const std::vector<Perf> &prof, Category &cat_below, Category &cat_above,
     MRSortModel &model,
     std::unordered_map<std::string, std::unordered_map<std::string, float>> &ct,
-    AlternativesPerformance &altPerf_model) {
+    AlternativesPerformance &altPerf_model,
+    std::pmr::memory_resource *resource) {
   // get the worst and best values in the dataset to compute the boundaries of
   // the profile
   std::pair<float, float> bounds = altPerf_model.getBoundaries();
   std::pair<std::vector<Perf>, std::vector<Perf>> below_above =
       model.profiles.getBelowAndAboveProfile(prof[0].name_, bounds.first,
                                              bounds.second);
-  std::vector<Perf> prof_below = below_above.first;
-  std::vector<Perf> prof_above = below_above.second;
+  const std::vector<Perf> &prof_below = below_above.first;
+  const std::vector<Perf> &prof_above = below_above.second;
 
-  for (Criterion crit : model.criteria.getCriterionVect()) {
+  for (const Criterion &crit : model.criteria.getCriterionVect()) {
     Perf b = getPerfOfCrit(prof, crit.getId());
     Perf b_below = getPerfOfCrit(prof_below, crit.getId());
     Perf b_above = getPerfOfCrit(prof_above, crit.getId());
 
-    std::unordered_map<std::string, float> ct_prof = ct[b.name_];
+    // only read until the move, which updates the table
+    std::unordered_map<std::string, float> &ct_prof = ct[b.name_];
 
-    std::unordered_map<float, float> below_des = this->computeBelowDesirability(
+    // the moves up are added to the moves down
+    Desirability desirability = this->computeBelowDesirability(
         model, crit.getId(), b, b_below, cat_below, cat_above, ct_prof,
-        altPerf_model);
-    std::unordered_map<float, float> above_des = this->computeAboveDesirability(
+        altPerf_model, resource);
+    Desirability above_des = this->computeAboveDesirability(
         model, crit.getId(), b, b_above, cat_below, cat_above, ct_prof,
-        altPerf_model);
-    std::unordered_map<float, float> desirability = below_des;
+        altPerf_model, resource);
     desirability.insert(above_des.begin(), above_des.end());
 
     std::pair<float, float> max = this->chooseMaxDesirability(desirability, b);
@@ -288,9 +306,11 @@ void ProfileUpdater::optimizeProfile(
     float value_max = max.second;
 
     if (value_max != 0) {
+      moves_proposed.add();
       std::random_device rd;
       float r = getRandomUniformFloat(rd());
       if (r <= value_max) {
+        moves_accepted.add();
         Perf b_new = Perf(b);
         b_new.value_ = key_max;
         this->updateTables(model, crit.getId(), b, b_new, ct, altPerf_model);
@@ -302,7 +322,8 @@ void ProfileUpdater::optimizeProfile(
 void ProfileUpdater::optimize(
     MRSortModel &model,
     std::unordered_map<std::string, std::unordered_map<std::string, float>> &ct,
-    AlternativesPerformance &altPerf_model) {
+    AlternativesPerformance &altPerf_model,
+    std::pmr::memory_resource *resource) {
   if (model.profiles.getMode() != "alt") {
     model.profiles.changeMode("alt");
   }
@@ -310,11 +331,14 @@ void ProfileUpdater::optimize(
     throw std::invalid_argument("Profile table is not ordered");
   }
   int i = 0;
-  for (std::vector<Perf> &profile : model.profiles.getPerformanceTable()) {
+  // a profile only changes while it is optimized, on the criterion it moves
+  // on, its row is read in place
+  for (const std::vector<Perf> &profile :
+       model.profiles.getPerformanceTable()) {
     Category cat_below = model.categories.getCategoryOfRank(i);
     Category cat_above = model.categories.getCategoryOfRank(i + 1);
     this->optimizeProfile(profile, cat_below, cat_above, model, ct,
-                          altPerf_model);
+                          altPerf_model, resource);
     i = i + 1;
   };
 }
@@ -322,7 +346,46 @@ void ProfileUpdater::optimize(
 void ProfileUpdater::updateProfiles(MRSortModel &model) {
   std::unordered_map<std::string, std::unordered_map<std::string, float>> ct =
       model.computeConcordanceTable(altPerf_data);
-  AlternativesPerformance altPerf_model =
-      model.categoryAssignments(altPerf_data);
-  this->optimize(model, ct, altPerf_model);
+  std::unique_ptr<AlternativesPerformance> altPerf_model =
+      this->acquireAssignmentTable(model);
+  this->optimize(model, ct, *altPerf_model);
+  this->releaseAssignmentTable(std::move(altPerf_model));
+}
+
+void ProfileUpdater::updateProfiles(MRSortModel &model, ScratchArena &arena) {
+  {
+    std::unordered_map<std::string, std::unordered_map<std::string, float>>
+        ct = model.computeConcordanceTable(altPerf_data);
+    std::unique_ptr<AlternativesPerformance> altPerf_model =
+        this->acquireAssignmentTable(model);
+    this->optimize(model, ct, *altPerf_model, arena.resource());
+    this->releaseAssignmentTable(std::move(altPerf_model));
+  }
+  arena.reset();
+}
+
+std::unique_ptr<AlternativesPerformance>
+ProfileUpdater::acquireAssignmentTable(MRSortModel &model) {
+  std::unique_ptr<AlternativesPerformance> altPerf_model;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!assignment_tables.empty()) {
+      altPerf_model = std::move(assignment_tables.back());
+      assignment_tables.pop_back();
+    }
+  }
+  if (altPerf_model) {
+    model.categoryAssignments(altPerf_data, *altPerf_model);
+  } else {
+    // first update of this thread, the dataset is copied once
+    altPerf_model = std::make_unique<AlternativesPerformance>(
+        model.categoryAssignments(altPerf_data));
+  }
+  return altPerf_model;
+}
+
+void ProfileUpdater::releaseAssignmentTable(
+    std::unique_ptr<AlternativesPerformance> altPerf_model) {
+  std::lock_guard<std::mutex> lock(mutex);
+  assignment_tables.push_back(std::move(altPerf_model));
 }
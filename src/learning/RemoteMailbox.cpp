@@ -0,0 +1,85 @@
+#include "../../include/learning/RemoteMailbox.h"
+#include "../../include/learning/WorkerProtocol.h"
+
+#include <chrono>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+RemoteMailbox::RemoteMailbox(Config &config, std::atomic<bool> *stop)
+    : conf(config), stop(stop), fd(-1), worker_id(-1), n_workers(0) {
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (conf.coordinator_socket.size() >= sizeof(addr.sun_path)) {
+    throw std::invalid_argument("Coordinator socket path is too long");
+  }
+  std::strcpy(addr.sun_path, conf.coordinator_socket.c_str());
+
+  // the coordinator may still be starting, retry for a few seconds
+  for (int attempt = 0; attempt < 50; attempt++) {
+    fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+      throw std::runtime_error("Cannot create socket");
+    }
+    if (::connect(fd, (sockaddr *)&addr, sizeof(addr)) == 0) {
+      break;
+    }
+    ::close(fd);
+    fd = -1;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+  if (fd < 0) {
+    throw std::runtime_error("Cannot connect to the coordinator at " +
+                             conf.coordinator_socket);
+  }
+
+  sendMessage(fd, MessageType::Hello);
+  std::string payload;
+  if (receiveMessage(fd, payload) != MessageType::Welcome) {
+    ::close(fd);
+    throw std::runtime_error("Unexpected answer of the coordinator");
+  }
+  std::istringstream(payload) >> worker_id >> n_workers;
+  conf.logger->info("Registered as worker " + std::to_string(worker_id) +
+                    " of " + std::to_string(n_workers));
+}
+
+RemoteMailbox::~RemoteMailbox() {
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+void RemoteMailbox::post(const std::vector<MRSortModel> &migrants) {
+  sendMessage(fd, MessageType::Post, encodeModels(migrants));
+  std::string payload;
+  receiveMessage(fd, payload);
+}
+
+std::vector<MRSortModel> RemoteMailbox::collect() {
+  sendMessage(fd, MessageType::Collect);
+  std::string payload;
+  if (receiveMessage(fd, payload) == MessageType::Stop) {
+    stop->store(true);
+    return std::vector<MRSortModel>();
+  }
+  return decodeModels(payload);
+}
+
+void RemoteMailbox::done(const MRSortModel &best_model) {
+  sendMessage(fd, MessageType::Done,
+              encodeModels(std::vector<MRSortModel>{best_model}));
+  std::string payload;
+  receiveMessage(fd, payload);
+  ::close(fd);
+  fd = -1;
+}
+
+int RemoteMailbox::getWorkerId() const { return worker_id; }
+
+int RemoteMailbox::getNumberWorkers() const { return n_workers; }
@@ -0,0 +1,44 @@
+#include "../../include/learning/ScratchArena.h"
+
+ScratchArena::ScratchArena(std::size_t initial_size)
+    : buffer(initial_size),
+      arena(std::make_unique<std::pmr::monotonic_buffer_resource>(
+          buffer.data(), buffer.size(), &overflow)) {}
+
+ScratchArena::~ScratchArena() {}
+
+std::pmr::memory_resource *ScratchArena::resource() { return arena.get(); }
+
+void ScratchArena::reset() {
+  // back to the start of the buffer, the memory taken from the heap is given
+  // back
+  arena->release();
+  if (overflow.allocated == 0) {
+    return;
+  }
+  std::size_t capacity = buffer.size() + overflow.allocated;
+  // the buffer must not be reallocated while the arena points to it
+  arena.reset();
+  buffer = std::vector<std::byte>(capacity);
+  overflow.allocated = 0;
+  arena = std::make_unique<std::pmr::monotonic_buffer_resource>(
+      buffer.data(), buffer.size(), &overflow);
+}
+
+std::size_t ScratchArena::getCapacity() const { return buffer.size(); }
+
+void *ScratchArena::Overflow::do_allocate(std::size_t bytes,
+                                          std::size_t alignment) {
+  allocated += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void ScratchArena::Overflow::do_deallocate(void *p, std::size_t bytes,
+                                           std::size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool ScratchArena::Overflow::do_is_equal(
+    const std::pmr::memory_resource &other) const noexcept {
+  return this == &other;
+}
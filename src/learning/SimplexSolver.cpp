@@ -0,0 +1,424 @@
+#include "../../include/learning/SimplexSolver.h"
+#include "../../include/app.h"
+#include "../../include/logging.h"
+#include "../../include/types/AlternativesPerformance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+namespace {
+// tolerance on the pivots, the reduced costs and the ratio test
+const double eps = 1e-9;
+// consecutive degenerate pivots before switching to the Bland rule
+const int max_degenerate_pivots = 50;
+// bound of the random perturbation of the right hand sides, far below delta
+const double perturbation = 1e-8;
+} // namespace
+
+SimplexSolver::SimplexSolver(AlternativesPerformance &ap, Config &conf,
+                             float delta)
+    : ap(ap), conf(conf), delta(delta), objective_value(0), iterations(0),
+      rows_metric(conf.metrics->histogram("lp.rows")),
+      iterations_metric(conf.metrics->histogram("lp.iterations")), n_core(0),
+      n_rows(0) {}
+
+double SimplexSolver::getObjectiveValue() const { return objective_value; }
+
+int SimplexSolver::getIterations() const { return iterations; }
+
+std::pair<float, std::vector<float>>
+SimplexSolver::solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
+                     std::vector<std::vector<std::vector<bool>>> y_matrix) {
+  std::vector<std::vector<bool>> x_rows, y_rows;
+  std::vector<int> x_multiplicity, y_multiplicity;
+  std::vector<std::vector<int>> x_row_of_alt, y_row_of_alt;
+  LPSolver::distinctRows(x_matrix, x_rows, x_multiplicity, x_row_of_alt);
+  LPSolver::distinctRows(y_matrix, y_rows, y_multiplicity, y_row_of_alt);
+
+  this->buildProblem(x_rows, x_multiplicity, y_rows, y_multiplicity);
+  this->optimize();
+
+  // objective of the solution in the problem without perturbation
+  objective_value = 0;
+  for (int r = 1; r < n_rows; r++) {
+    double gap = dev_sign[r] < 0 ? 0 : -delta;
+    for (int j = 0; j < n_core; j++) {
+      gap -= coefficients[r * n_core + j] * values[j];
+    }
+    objective_value += dev_cost[r] * std::max(-gap * dev_sign[r], 0.);
+  }
+  FASTPL_DEBUG(conf.logger, "Problem solved - {} rows, {} iterations.", n_rows,
+               iterations);
+  rows_metric.record(n_rows);
+  iterations_metric.record(iterations);
+
+  std::vector<float> weight_values;
+  for (int j = 0; j < n_core - 1; j++) {
+    weight_values.push_back(values[j]);
+  }
+  return std::make_pair((float)values[n_core - 1], weight_values);
+}
+
+void SimplexSolver::buildProblem(std::vector<std::vector<bool>> &x_rows,
+                                 std::vector<int> &x_multiplicity,
+                                 std::vector<std::vector<bool>> &y_rows,
+                                 std::vector<int> &y_multiplicity) {
+  const int n_crit = ap.getNumberCrit();
+  const int n_x = x_rows.size();
+  const int lambda = n_crit;
+  n_core = n_crit + 1;
+  n_rows = 1 + x_rows.size() + y_rows.size();
+
+  coefficients.assign(n_rows * n_core, 0);
+  rhs.assign(n_rows, 0);
+  dev_sign.assign(n_rows, 0);
+  dev_cost.assign(n_rows, 0);
+  lower.assign(n_core, 0);
+  upper.assign(n_core, 1);
+  lower[lambda] = 0.5;
+
+  // starting point: w_0 = 1 is basic in the row sum(w) = 1, the other weights
+  // are at 0 and lambda at 0.5
+  core_status.assign(n_core, -1);
+  core_status[0] = 0;
+  row_basic.assign(n_rows, -1);
+  for (int j = 0; j < n_crit; j++) {
+    coefficients[j] = 1;
+  }
+  rhs[0] = 1;
+
+  // The rows of the problem are highly degenerate: many comparison vectors
+  // have the same sum of weights at a vertex, which stalls the simplex in
+  // pivots without progress. A small perturbation of the right hand sides
+  // breaks these ties, its effect on the solution being below the precision
+  // of the weights.
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> noise(0, perturbation);
+  for (int r = 1; r < n_rows; r++) {
+    const bool is_x = r - 1 < n_x;
+    std::vector<bool> &comparison = is_x ? x_rows[r - 1] : y_rows[r - 1 - n_x];
+    double *row = &coefficients[r * n_core];
+
+    // x row: sum(w) - lambda - x + x' = 0
+    // y row: sum(w) - lambda + y - y' = -delta
+    for (int j = 0; j < n_crit; j++) {
+      if (comparison[j]) {
+        row[j] = 1;
+      }
+    }
+    row[lambda] = -1;
+    dev_sign[r] = is_x ? -1 : 1;
+    dev_cost[r] = is_x ? x_multiplicity[r - 1] : y_multiplicity[r - 1 - n_x];
+    rhs[r] = (is_x ? 0 : -delta) + noise(gen);
+
+    // the deviation variable absorbing the gap at the starting point is basic
+    const double gap = rhs[r] - (row[0] - lower[lambda]);
+    row_basic[r] = gap * dev_sign[r] >= 0 ? 0 : 1;
+  }
+}
+
+void SimplexSolver::factorize() {
+  basic_core.clear();
+  tight_rows.clear();
+  for (int j = 0; j < n_core; j++) {
+    if (core_status[j] == 0) {
+      basic_core.push_back(j);
+    }
+  }
+  for (int r = 0; r < n_rows; r++) {
+    if (row_basic[r] == -1) {
+      tight_rows.push_back(r);
+    }
+  }
+  const int size = basic_core.size();
+  if (tight_rows.size() != size) {
+    throw std::logic_error("Inconsistent simplex basis");
+  }
+
+  // Gauss-Jordan elimination of [M | I], M the basic core columns on the tight
+  // rows
+  std::vector<double> matrix(size * size);
+  inverse.assign(size * size, 0);
+  for (int i = 0; i < size; i++) {
+    for (int k = 0; k < size; k++) {
+      matrix[i * size + k] = coefficients[tight_rows[i] * n_core + basic_core[k]];
+    }
+    inverse[i * size + i] = 1;
+  }
+  for (int k = 0; k < size; k++) {
+    int pivot = k;
+    for (int i = k + 1; i < size; i++) {
+      if (std::abs(matrix[i * size + k]) > std::abs(matrix[pivot * size + k])) {
+        pivot = i;
+      }
+    }
+    if (std::abs(matrix[pivot * size + k]) < eps) {
+      throw std::logic_error("Singular simplex basis");
+    }
+    if (pivot != k) {
+      for (int c = 0; c < size; c++) {
+        std::swap(matrix[k * size + c], matrix[pivot * size + c]);
+        std::swap(inverse[k * size + c], inverse[pivot * size + c]);
+      }
+    }
+    const double pivot_value = matrix[k * size + k];
+    for (int c = 0; c < size; c++) {
+      matrix[k * size + c] /= pivot_value;
+      inverse[k * size + c] /= pivot_value;
+    }
+    for (int i = 0; i < size; i++) {
+      const double factor = matrix[i * size + k];
+      if (i == k || factor == 0) {
+        continue;
+      }
+      for (int c = 0; c < size; c++) {
+        matrix[i * size + c] -= factor * matrix[k * size + c];
+        inverse[i * size + c] -= factor * inverse[k * size + c];
+      }
+    }
+  }
+
+  // values: non basic core variables at their bound, the basic ones solve the
+  // tight rows and the basic deviations absorb the gap of the other rows
+  values.assign(n_core, 0);
+  for (int j = 0; j < n_core; j++) {
+    if (core_status[j] != 0) {
+      values[j] = core_status[j] < 0 ? lower[j] : upper[j];
+    }
+  }
+  std::vector<double> residual(size);
+  for (int i = 0; i < size; i++) {
+    const double *row = &coefficients[tight_rows[i] * n_core];
+    residual[i] = rhs[tight_rows[i]];
+    for (int j = 0; j < n_core; j++) {
+      residual[i] -= row[j] * values[j];
+    }
+  }
+  for (int k = 0; k < size; k++) {
+    double value = 0;
+    for (int i = 0; i < size; i++) {
+      value += inverse[k * size + i] * residual[i];
+    }
+    values[basic_core[k]] = value;
+  }
+  dev_values.assign(n_rows, 0);
+  duals.assign(n_rows, 0);
+  std::vector<double> core_duals(n_core, 0);
+  for (int r = 1; r < n_rows; r++) {
+    if (row_basic[r] == -1) {
+      continue;
+    }
+    const double *row = &coefficients[r * n_core];
+    const double sign = row_basic[r] == 0 ? dev_sign[r] : -dev_sign[r];
+    double gap = rhs[r];
+    for (int j = 0; j < n_core; j++) {
+      gap -= row[j] * values[j];
+    }
+    dev_values[r] = gap / sign;
+
+    // dual of a row with a basic deviation: cost of the deviation over its
+    // coefficient
+    duals[r] = (row_basic[r] == 0 ? 0 : dev_cost[r]) / sign;
+    if (duals[r] != 0) {
+      for (int j = 0; j < n_core; j++) {
+        core_duals[j] += duals[r] * row[j];
+      }
+    }
+  }
+  // duals of the tight rows, the reduced costs of the basic core variables
+  // being 0: M^T duals_T = -core_duals
+  for (int i = 0; i < size; i++) {
+    double dual = 0;
+    for (int k = 0; k < size; k++) {
+      dual -= inverse[k * size + i] * core_duals[basic_core[k]];
+    }
+    duals[tight_rows[i]] = dual;
+  }
+}
+
+void SimplexSolver::computeDirection(int entering,
+                                     std::vector<double> &core_direction,
+                                     std::vector<double> &dev_direction) {
+  const int size = basic_core.size();
+  // column of the entering variable on the tight rows
+  std::vector<double> column(size, 0);
+  int dev_row = -1;
+  double dev_coefficient = 0;
+  if (entering < n_core) {
+    for (int i = 0; i < size; i++) {
+      column[i] = coefficients[tight_rows[i] * n_core + entering];
+    }
+  } else {
+    dev_row = 1 + (entering - n_core) / 2;
+    dev_coefficient = (entering - n_core) % 2 == 0 ? dev_sign[dev_row]
+                                                   : -dev_sign[dev_row];
+    for (int i = 0; i < size; i++) {
+      if (tight_rows[i] == dev_row) {
+        column[i] = dev_coefficient;
+      }
+    }
+  }
+
+  core_direction.assign(size, 0);
+  for (int k = 0; k < size; k++) {
+    for (int i = 0; i < size; i++) {
+      core_direction[k] += inverse[k * size + i] * column[i];
+    }
+  }
+
+  dev_direction.assign(n_rows, 0);
+  for (int r = 1; r < n_rows; r++) {
+    if (row_basic[r] == -1) {
+      continue;
+    }
+    const double *row = &coefficients[r * n_core];
+    double value = 0;
+    if (entering < n_core) {
+      value = row[entering];
+    } else if (r == dev_row) {
+      value = dev_coefficient;
+    }
+    for (int k = 0; k < size; k++) {
+      value -= row[basic_core[k]] * core_direction[k];
+    }
+    dev_direction[r] =
+        value / (row_basic[r] == 0 ? dev_sign[r] : -dev_sign[r]);
+  }
+}
+
+void SimplexSolver::optimize() {
+  const int n_vars = n_core + 2 * (n_rows - 1);
+  const int max_iterations = 50 * (n_rows + n_core);
+  std::vector<double> core_direction, dev_direction;
+  int degenerate = 0;
+  for (iterations = 0;; iterations++) {
+    if (iterations >= max_iterations) {
+      conf.logger->warn("Solver couldn't find an optimal solution.");
+      throw std::logic_error("Solver couldn't find an optimal solution");
+    }
+    this->factorize();
+    const bool bland = degenerate >= max_degenerate_pivots;
+
+    // pricing: a non basic variable at its lower bound with a negative reduced
+    // cost, or at its upper bound with a positive one, improves the objective
+    int entering = -1;
+    double direction = 0;
+    double best = 0;
+    for (int v = 0; v < n_vars; v++) {
+      double reduced_cost;
+      double dir = 1;
+      if (v < n_core) {
+        if (core_status[v] == 0) {
+          continue;
+        }
+        reduced_cost = 0;
+        for (int r = 0; r < n_rows; r++) {
+          reduced_cost -= duals[r] * coefficients[r * n_core + v];
+        }
+        dir = core_status[v] < 0 ? 1 : -1;
+      } else {
+        const int r = 1 + (v - n_core) / 2;
+        const int dev = (v - n_core) % 2;
+        if (row_basic[r] == dev) {
+          continue;
+        }
+        const double sign = dev == 0 ? dev_sign[r] : -dev_sign[r];
+        reduced_cost = (dev == 0 ? 0 : dev_cost[r]) - duals[r] * sign;
+      }
+      const double gain = -dir * reduced_cost;
+      if (gain > eps && gain > best) {
+        entering = v;
+        direction = dir;
+        best = gain;
+        if (bland) {
+          break;
+        }
+      }
+    }
+    if (entering == -1) {
+      return;
+    }
+
+    // ratio test on the bounds of the basic core variables, the entering
+    // variable may reach its other bound first
+    this->computeDirection(entering, core_direction, dev_direction);
+    double theta = entering < n_core ? upper[entering] - lower[entering]
+                                     : std::numeric_limits<double>::infinity();
+    int leaving = -1;
+    double leaving_alpha = 0;
+    for (int k = 0; k < basic_core.size(); k++) {
+      const int j = basic_core[k];
+      const double alpha = direction * core_direction[k];
+      double limit;
+      if (alpha > eps) {
+        limit = std::max((values[j] - lower[j]) / alpha, 0.);
+      } else if (alpha < -eps) {
+        limit = std::max((upper[j] - values[j]) / -alpha, 0.);
+      } else {
+        continue;
+      }
+      if (limit < theta - eps ||
+          (leaving != -1 && limit <= theta + eps && j < leaving)) {
+        theta = limit;
+        leaving = j;
+        leaving_alpha = alpha;
+      }
+    }
+
+    // breakpoints of the basic deviations: when a deviation reaches 0, the
+    // step can go on with the other deviation of the row basic instead, the
+    // slope of the objective increasing by its cost (long step). The step
+    // stops at the breakpoint where the objective stops decreasing.
+    std::vector<std::pair<double, int>> breakpoints;
+    for (int r = 1; r < n_rows; r++) {
+      const double alpha = direction * dev_direction[r];
+      if (row_basic[r] != -1 && alpha > eps) {
+        const double limit = std::max(dev_values[r] / alpha, 0.);
+        if (limit < theta) {
+          breakpoints.push_back(std::make_pair(limit, r));
+        }
+      }
+    }
+    std::sort(breakpoints.begin(), breakpoints.end());
+    double slope = -best;
+    std::vector<int> crossed;
+    for (const std::pair<double, int> &breakpoint : breakpoints) {
+      const int r = breakpoint.second;
+      const double alpha = direction * dev_direction[r];
+      if (bland || slope + dev_cost[r] * alpha >= -eps) {
+        theta = breakpoint.first;
+        leaving = n_core + 2 * (r - 1) + row_basic[r];
+        leaving_alpha = alpha;
+        break;
+      }
+      slope += dev_cost[r] * alpha;
+      crossed.push_back(r);
+    }
+    if (std::isinf(theta)) {
+      throw std::logic_error("Unbounded linear problem");
+    }
+    degenerate = theta < eps ? degenerate + 1 : 0;
+
+    for (int r : crossed) {
+      row_basic[r] = 1 - row_basic[r];
+    }
+    if (leaving == -1) {
+      // bound flip, the basis is unchanged
+      core_status[entering] = -core_status[entering];
+      continue;
+    }
+    if (leaving < n_core) {
+      core_status[leaving] = leaving_alpha > 0 ? -1 : 1;
+    } else {
+      row_basic[1 + (leaving - n_core) / 2] = -1;
+    }
+    if (entering < n_core) {
+      core_status[entering] = 0;
+    } else {
+      row_basic[1 + (entering - n_core) / 2] = (entering - n_core) % 2;
+    }
+  }
+}
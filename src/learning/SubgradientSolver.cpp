@@ -0,0 +1,160 @@
+#include "../../include/learning/SubgradientSolver.h"
+#include "../../include/app.h"
+#include "../../include/logging.h"
+#include "../../include/types/AlternativesPerformance.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+// length of the first step, in the units of the weights
+const double initial_step = 0.1;
+} // namespace
+
+SubgradientSolver::SubgradientSolver(AlternativesPerformance &ap,
+                                     Config &conf, float delta)
+    : ap(ap), conf(conf), delta(delta), objective_value(0),
+      rows_metric(conf.metrics->histogram("lp.rows")), n_crit(0), n_rows(0) {
+  if (conf.subgradient_iterations < 1) {
+    throw std::invalid_argument(
+        "The number of subgradient iterations must be >= 1");
+  }
+}
+
+double SubgradientSolver::getObjectiveValue() const { return objective_value; }
+
+std::pair<float, std::vector<float>>
+SubgradientSolver::solve(std::vector<std::vector<std::vector<bool>>> x_matrix,
+                         std::vector<std::vector<std::vector<bool>>> y_matrix) {
+  std::vector<std::vector<bool>> x_rows, y_rows;
+  std::vector<int> x_multiplicity, y_multiplicity;
+  std::vector<std::vector<int>> x_row_of_alt, y_row_of_alt;
+  LPSolver::distinctRows(x_matrix, x_rows, x_multiplicity, x_row_of_alt);
+  LPSolver::distinctRows(y_matrix, y_rows, y_multiplicity, y_row_of_alt);
+  n_crit = ap.getNumberCrit();
+  this->buildProblem(x_rows, x_multiplicity, y_rows, y_multiplicity);
+
+  // starting point: equal weights, lambda in the middle of its range
+  std::vector<double> weights(n_crit, 1. / n_crit);
+  double lambda = 0.75;
+  std::vector<double> weight_gradient(n_crit);
+  double lambda_gradient;
+
+  std::vector<double> best_weights = weights;
+  double best_lambda = lambda;
+  objective_value =
+      this->evaluate(weights, lambda, weight_gradient, lambda_gradient);
+  for (int k = 0; k < conf.subgradient_iterations && objective_value > 0;
+       k++) {
+    double norm = lambda_gradient * lambda_gradient;
+    for (double g : weight_gradient) {
+      norm += g * g;
+    }
+    if (norm == 0) {
+      break;
+    }
+    // decreasing step along the normalized subgradient
+    const double step = initial_step / (std::sqrt(k + 1.) * std::sqrt(norm));
+    for (int j = 0; j < n_crit; j++) {
+      weights[j] -= step * weight_gradient[j];
+    }
+    SubgradientSolver::projectOnSimplex(weights);
+    lambda = std::min(std::max(lambda - step * lambda_gradient, 0.5), 1.);
+
+    const double value =
+        this->evaluate(weights, lambda, weight_gradient, lambda_gradient);
+    if (value < objective_value) {
+      objective_value = value;
+      best_weights = weights;
+      best_lambda = lambda;
+    }
+  }
+  FASTPL_DEBUG(conf.logger, "Problem solved - {} rows, objective {}", n_rows,
+               objective_value);
+  rows_metric.record(n_rows);
+
+  std::vector<float> weight_values(best_weights.begin(), best_weights.end());
+  return std::make_pair((float)best_lambda, weight_values);
+}
+
+void SubgradientSolver::buildProblem(std::vector<std::vector<bool>> &x_rows,
+                                     std::vector<int> &x_multiplicity,
+                                     std::vector<std::vector<bool>> &y_rows,
+                                     std::vector<int> &y_multiplicity) {
+  const int n_x = x_rows.size();
+  n_rows = n_x + y_rows.size();
+  columns.assign(n_crit * n_rows, 0);
+  row_sign.resize(n_rows);
+  row_offset.resize(n_rows);
+  row_cost.resize(n_rows);
+  for (int r = 0; r < n_rows; r++) {
+    const bool is_x = r < n_x;
+    std::vector<bool> &comparison = is_x ? x_rows[r] : y_rows[r - n_x];
+    for (int j = 0; j < n_crit; j++) {
+      columns[j * n_rows + r] = comparison[j];
+    }
+    // x row deviation: lambda - a.w, y row deviation: a.w - lambda + delta
+    row_sign[r] = is_x ? -1 : 1;
+    row_offset[r] = is_x ? 0 : delta;
+    row_cost[r] = is_x ? x_multiplicity[r] : y_multiplicity[r - n_x];
+  }
+}
+
+double SubgradientSolver::evaluate(const std::vector<double> &weights,
+                                   double lambda,
+                                   std::vector<double> &weight_gradient,
+                                   double &lambda_gradient) {
+  // concordance a_r.w of every row, one column at a time
+  std::vector<double> concordance(n_rows, 0);
+  for (int j = 0; j < n_crit; j++) {
+    const double w = weights[j];
+    const double *column = &columns[j * n_rows];
+    for (int r = 0; r < n_rows; r++) {
+      concordance[r] += w * column[r];
+    }
+  }
+
+  // deviation of each row, and its weight in the subgradient if it is positive
+  double value = 0;
+  lambda_gradient = 0;
+  std::vector<double> &slope = concordance;
+  for (int r = 0; r < n_rows; r++) {
+    const double deviation =
+        row_sign[r] * (concordance[r] - lambda) + row_offset[r];
+    if (deviation > 0) {
+      value += row_cost[r] * deviation;
+      slope[r] = row_cost[r] * row_sign[r];
+      lambda_gradient -= slope[r];
+    } else {
+      slope[r] = 0;
+    }
+  }
+  for (int j = 0; j < n_crit; j++) {
+    const double *column = &columns[j * n_rows];
+    double g = 0;
+    for (int r = 0; r < n_rows; r++) {
+      g += slope[r] * column[r];
+    }
+    weight_gradient[j] = g;
+  }
+  return value;
+}
+
+void SubgradientSolver::projectOnSimplex(std::vector<double> &w) {
+  // the projection is max(w_j - tau, 0), tau such that it sums to 1
+  std::vector<double> sorted = w;
+  std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+  double sum = 0, tau = 0;
+  for (int j = 0; j < sorted.size(); j++) {
+    sum += sorted[j];
+    const double candidate = (sum - 1) / (j + 1);
+    if (sorted[j] - candidate > 0) {
+      tau = candidate;
+    }
+  }
+  for (double &w_j : w) {
+    w_j = std::max(w_j - tau, 0.);
+  }
+}
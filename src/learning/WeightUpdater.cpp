@@ -1,14 +1,49 @@
 #include "../../include/learning/WeightUpdater.h"
-#include "../../include/learning/LinearSolver.h"
+#include "../../include/learning/LPSolverPool.h"
+#include "../../include/logging.h"
 #include "../../include/utils.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numeric>
+#include <random>
 #include <sstream>
+#include <unordered_set>
 
 WeightUpdater::WeightUpdater(AlternativesPerformance &ap, Config &conf)
-    : ap(ap), conf(conf), solver(ap, conf) {}
+    : solvers(std::make_shared<LPSolverPool>(ap, conf)), ap(ap), conf(conf),
+      solve_time(conf.metrics->histogram("lp.solve_us")) {
+  if (conf.lp_sample_size < 0) {
+    throw std::invalid_argument("The LP sample size must be >= 0");
+  }
+  if (conf.lp_sample_focus < 0 || conf.lp_sample_focus > 1) {
+    throw std::invalid_argument("The LP sample focus must be in [0, 1]");
+  }
+  if (conf.lp_sample_size > 0) {
+    if (ap.getMode() != "alt") {
+      throw std::invalid_argument(
+          "AlternativesPerformance's profile should be in alt mode.");
+    }
+    // the dataset does not change, its strata are computed once
+    std::map<int, std::vector<int>> alts_per_rank;
+    const auto &alts_pt = ap.getPerformanceTable();
+    for (int alt = 0; alt < alts_pt.size(); alt++) {
+      int rank = ap.getAlternativeAssignment(alts_pt[alt][0].name_).rank_;
+      alt_ranks.push_back(rank);
+      alts_per_rank[rank].push_back(alt);
+    }
+    for (std::pair<const int, std::vector<int>> &stratum : alts_per_rank) {
+      strata.push_back(std::move(stratum.second));
+    }
+  }
+}
 
 WeightUpdater::WeightUpdater(const WeightUpdater &wu)
-    : solver(wu.solver), ap(wu.ap), conf(wu.conf) {}
+    : solvers(wu.solvers), ap(wu.ap), conf(wu.conf), solve_time(wu.solve_time),
+      alt_ranks(wu.alt_ranks), strata(wu.strata) {}
 
 WeightUpdater::~WeightUpdater() {}
 
@@ -19,34 +54,162 @@ void WeightUpdater::updateWeightsAndLambda(MRSortModel &model) {
                                 "performance of this WeightUpdater");
   }
 
+  if (conf.lp_sample_size > 0) {
+    // only the rows of the sampled alternatives are computed
+    std::vector<int> sample = this->sampleAlternatives(model);
+    auto matrix_x = this->computeXMatrix(model, sample);
+    auto matrix_y = this->computeYMatrix(model, sample);
+    this->solveAndUpdate(model, matrix_x, matrix_y);
+    return;
+  }
+  auto matrix_x = this->computeXMatrix(model);
+  auto matrix_y = this->computeYMatrix(model);
+  this->solveAndUpdate(model, matrix_x, matrix_y);
+}
+
+void WeightUpdater::polishWeightsAndLambda(MRSortModel &model) {
+  if (!this->modelCheck(model)) {
+    throw std::invalid_argument("Model's profile doesn't suite the alternative "
+                                "performance of this WeightUpdater");
+  }
   auto matrix_x = this->computeXMatrix(model);
   auto matrix_y = this->computeYMatrix(model);
-  std::pair<float, std::vector<float>> res = solver.solve(matrix_x, matrix_y);
+  this->solveAndUpdate(model, matrix_x, matrix_y);
+}
+
+float WeightUpdater::concordanceMargin(MRSortModel &model, int alt) {
+  const auto &profs_pt = model.profiles.getPerformanceTable();
+  const std::vector<Perf> &perfs = ap.getPerformanceTable()[alt];
+  const std::vector<float> &weights = model.criteria.getWeights();
+  auto concordance = [&perfs, &weights](const std::vector<Perf> &prof) {
+    float sum = 0;
+    for (int j = 0; j < perfs.size(); j++) {
+      if (perfs[j].value_ >= prof[j].value_) {
+        sum += weights[j];
+      }
+    }
+    return sum;
+  };
+  // rows of the x and y matrices of the alternative, see computeXMatrix and
+  // computeYMatrix
+  int h = alt_ranks[alt];
+  int n_prof = profs_pt.size();
+  float margin = std::numeric_limits<float>::infinity();
+  if (h >= 1 && h < n_prof) {
+    margin = std::min(margin, concordance(profs_pt[h - 1]) - model.lambda);
+  }
+  if (h >= 0 && h < n_prof - 1) {
+    margin = std::min(margin, model.lambda - concordance(profs_pt[h]));
+  }
+  return margin;
+}
 
-  std::ostringstream ss;
-  ss << "Linear problem results - ";
+std::vector<int> WeightUpdater::sampleAlternatives(MRSortModel &model) {
+  int n_alt = ap.getNumberAlt();
+  std::vector<int> sample;
+  if (conf.lp_sample_size >= n_alt) {
+    sample.resize(n_alt);
+    std::iota(sample.begin(), sample.end(), 0);
+    return sample;
+  }
+  // models are updated concurrently, one generator per thread
+  static thread_local std::mt19937 gen(std::random_device{}());
+
+  // distance of each alternative to the threshold, only for the focus
+  std::vector<float> distances;
+  if (conf.lp_sample_focus > 0) {
+    distances.resize(n_alt);
+    for (int alt = 0; alt < n_alt; alt++) {
+      distances[alt] = std::abs(this->concordanceMargin(model, alt));
+    }
+  }
+
+  sample.reserve(conf.lp_sample_size + strata.size());
+  for (const std::vector<int> &stratum : strata) {
+    int size = stratum.size();
+    int quota = std::round(float(conf.lp_sample_size) * size / n_alt);
+    quota = std::min(std::max(quota, 1), size);
+    int n_focus = std::round(conf.lp_sample_focus * quota);
+
+    if (n_focus == 0) {
+      // Floyd's algorithm: quota distinct positions drawn without going
+      // through the stratum
+      std::unordered_set<int> picked;
+      for (int j = size - quota; j < size; j++) {
+        int t = std::uniform_int_distribution<int>(0, j)(gen);
+        if (!picked.insert(t).second) {
+          picked.insert(j);
+        }
+      }
+      for (int p : picked) {
+        sample.push_back(stratum[p]);
+      }
+      continue;
+    }
+
+    // closest to the threshold first, then a random draw among the others
+    std::vector<int> alts = stratum;
+    std::nth_element(
+        alts.begin(), alts.begin() + n_focus, alts.end(),
+        [&distances](int a, int b) { return distances[a] < distances[b]; });
+    for (int i = n_focus; i < quota; i++) {
+      std::uniform_int_distribution<int> pick(i, size - 1);
+      std::swap(alts[i], alts[pick(gen)]);
+    }
+    sample.insert(sample.end(), alts.begin(), alts.begin() + quota);
+  }
+  std::sort(sample.begin(), sample.end());
+  return sample;
+}
+
+void WeightUpdater::solveAndUpdate(
+    MRSortModel &model, std::vector<std::vector<std::vector<bool>>> &x_matrix,
+    std::vector<std::vector<std::vector<bool>>> &y_matrix) {
+  const auto start = std::chrono::steady_clock::now();
+  std::pair<float, std::vector<float>> res;
+  {
+    Tracer::Span span(*conf.tracer, "LPSolver::solve");
+    res = solvers->acquire()->solve(x_matrix, y_matrix);
+  }
+  solve_time.recordSeconds(
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start)
+          .count());
 
   // update lambda
   model.lambda = res.first;
-  ss << "Lambda: " << res.first;
   // update all weights in order
   model.criteria.setWeights(res.second);
-  for (int i = 0; i < res.second.size(); i++) {
-    ss << " - w" << i << ": " << model.criteria[i].getWeight();
+
+  // the message is only built when it is logged
+  if (FASTPL_SHOULD_DEBUG(conf.logger)) {
+    std::ostringstream ss;
+    ss << "Linear problem results - Lambda: " << res.first;
+    for (int i = 0; i < res.second.size(); i++) {
+      ss << " - w" << i << ": " << model.criteria.getWeights()[i];
+    }
+    FASTPL_DEBUG(conf.logger, ss.str());
   }
-  conf.logger->debug(ss.str());
 }
 
 std::vector<std::vector<std::vector<bool>>>
 WeightUpdater::computeXMatrix(MRSortModel &model) {
+  std::vector<int> alts(ap.getNumberAlt());
+  std::iota(alts.begin(), alts.end(), 0);
+  return this->computeXMatrix(model, alts);
+}
+
+std::vector<std::vector<std::vector<bool>>>
+WeightUpdater::computeXMatrix(MRSortModel &model,
+                              const std::vector<int> &alts) {
   std::vector<std::vector<std::vector<bool>>> x_matrix;
-  auto profs_pt = model.profiles.getPerformanceTable();
-  auto alts_pt = ap.getPerformanceTable();
-  auto alts_assign = ap.getAlternativesAssignments();
+  const auto &profs_pt = model.profiles.getPerformanceTable();
+  const auto &alts_pt = ap.getPerformanceTable();
 
   for (int h = 1; h < profs_pt.size(); h++) {
     std::vector<std::vector<bool>> x_h;
-    for (auto alt : alts_pt) {
+    x_h.reserve(alts.size());
+    for (int a : alts) {
+      const auto &alt = alts_pt[a];
       std::vector<bool> x_h_alt;
       // if alt is assigned to category h (otherwise, append empty vector)
       if (ap.getAlternativeAssignment(alt[0].name_).rank_ == h) {
@@ -55,23 +218,32 @@ WeightUpdater::computeXMatrix(MRSortModel &model) {
           x_h_alt.push_back(alt[j].value_ >= profs_pt[h - 1][j].value_);
         }
       }
-      x_h.push_back(x_h_alt);
+      x_h.push_back(std::move(x_h_alt));
     }
-    x_matrix.push_back(x_h);
+    x_matrix.push_back(std::move(x_h));
   }
   return x_matrix;
 }
 
 std::vector<std::vector<std::vector<bool>>>
 WeightUpdater::computeYMatrix(MRSortModel &model) {
+  std::vector<int> alts(ap.getNumberAlt());
+  std::iota(alts.begin(), alts.end(), 0);
+  return this->computeYMatrix(model, alts);
+}
+
+std::vector<std::vector<std::vector<bool>>>
+WeightUpdater::computeYMatrix(MRSortModel &model,
+                              const std::vector<int> &alts) {
 
   std::vector<std::vector<std::vector<bool>>> y_matrix;
-  auto profs_pt = model.profiles.getPerformanceTable();
-  auto alts_pt = ap.getPerformanceTable();
-  auto alts_assign = ap.getAlternativesAssignments();
+  const auto &profs_pt = model.profiles.getPerformanceTable();
+  const auto &alts_pt = ap.getPerformanceTable();
   for (int h = 0; h < profs_pt.size() - 1; h++) {
     std::vector<std::vector<bool>> y_h;
-    for (auto alt : alts_pt) {
+    y_h.reserve(alts.size());
+    for (int a : alts) {
+      const auto &alt = alts_pt[a];
       std::vector<bool> y_h_alt;
       // if alt is assigned to category h (otherwise, append empty vector)
       if (ap.getAlternativeAssignment(alt[0].name_).rank_ == h) {
@@ -80,9 +252,9 @@ WeightUpdater::computeYMatrix(MRSortModel &model) {
           y_h_alt.push_back(alt[j].value_ >= profs_pt[h][j].value_);
         }
       }
-      y_h.push_back(y_h_alt);
+      y_h.push_back(std::move(y_h_alt));
     }
-    y_matrix.push_back(y_h);
+    y_matrix.push_back(std::move(y_h));
   }
   return y_matrix;
 }
@@ -100,8 +272,8 @@ bool WeightUpdater::modelCheck(MRSortModel &model) {
   }
   // both are supposed to be in mode alt
 
-  std::vector<std::vector<Perf>> profs = model.profiles.getPerformanceTable();
-  auto ap_pt = ap.getPerformanceTable();
+  const auto &profs = model.profiles.getPerformanceTable();
+  const auto &ap_pt = ap.getPerformanceTable();
   for (int i = 0; i < ap.getNumberCrit(); i++) {
     if (profs[0][i].crit_ != ap_pt[0][i].crit_) {
       return false;
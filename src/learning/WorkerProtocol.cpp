@@ -0,0 +1,236 @@
+#include "../../include/learning/WorkerProtocol.h"
+#include "../../include/types/Categories.h"
+#include "../../include/types/Criteria.h"
+#include "../../include/types/Perf.h"
+#include "../../include/types/Profiles.h"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+void writeAll(int fd, const char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = ::send(fd, data, size, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      throw std::runtime_error("Socket write failed: " +
+                               std::string(std::strerror(errno)));
+    }
+    data += n;
+    size -= n;
+  }
+}
+
+void readAll(int fd, char *data, size_t size) {
+  while (size > 0) {
+    ssize_t n = ::recv(fd, data, size, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n == 0) {
+      throw std::runtime_error("Socket closed by peer");
+    }
+    if (n < 0) {
+      throw std::runtime_error("Socket read failed: " +
+                               std::string(std::strerror(errno)));
+    }
+    data += n;
+    size -= n;
+  }
+}
+
+/**
+ * checkId throws if an id cannot be written in the space delimited encoding
+ * of the models
+ *
+ * @param id id of a model, a criterion, a category or a performance
+ *
+ * @return id
+ */
+const std::string &checkId(const std::string &id) {
+  if (id.empty() || id.find_first_of(" \t\n\r\v\f") != std::string::npos) {
+    throw std::invalid_argument("Cannot encode the id \"" + id +
+                                "\": the ids must be non empty and without "
+                                "whitespace");
+  }
+  return id;
+}
+
+/**
+ * readCount reads a number of items of the encoded models. Each item takes
+ * at least one of the characters left, so that a malformed count is rejected
+ * before it sizes an allocation.
+ *
+ * @param in encoded models being read
+ * @param encoded_size size of the encoded models
+ *
+ * @return number of items
+ */
+size_t readCount(std::istringstream &in, size_t encoded_size) {
+  size_t count = 0;
+  in >> count;
+  if (!in) {
+    throw std::invalid_argument("Malformed encoded models");
+  }
+  std::streampos pos = in.tellg();
+  size_t left = pos < 0 ? 0 : encoded_size - static_cast<size_t>(pos);
+  if (count > left) {
+    throw std::invalid_argument("Malformed encoded models");
+  }
+  return count;
+}
+
+/**
+ * checkRead throws if a field of the encoded models could not be read
+ *
+ * @param in encoded models being read
+ */
+void checkRead(const std::istringstream &in) {
+  if (!in) {
+    throw std::invalid_argument("Malformed encoded models");
+  }
+}
+
+} // namespace
+
+void sendMessage(int fd, MessageType type, const std::string &payload) {
+  if (payload.size() > max_payload_size) {
+    throw std::length_error("Frame payload of " +
+                            std::to_string(payload.size()) +
+                            " bytes exceeds the maximum of " +
+                            std::to_string(max_payload_size));
+  }
+  char header[5];
+  header[0] = static_cast<char>(type);
+  uint32_t length = htonl(static_cast<uint32_t>(payload.size()));
+  std::memcpy(header + 1, &length, sizeof(length));
+  writeAll(fd, header, sizeof(header));
+  writeAll(fd, payload.data(), payload.size());
+}
+
+MessageType receiveMessage(int fd, std::string &payload) {
+  char header[5];
+  readAll(fd, header, sizeof(header));
+  uint32_t length;
+  std::memcpy(&length, header + 1, sizeof(length));
+  length = ntohl(length);
+  if (length > max_payload_size) {
+    throw std::length_error("Frame payload of " + std::to_string(length) +
+                            " bytes exceeds the maximum of " +
+                            std::to_string(max_payload_size));
+  }
+  payload.assign(length, '\0');
+  readAll(fd, &payload[0], payload.size());
+  return static_cast<MessageType>(header[0]);
+}
+
+std::string encodeModels(const std::vector<MRSortModel> &models) {
+  std::ostringstream out;
+  out.precision(std::numeric_limits<float>::max_digits10);
+  out << models.size() << "\n";
+  for (const MRSortModel &model : models) {
+    out << checkId(model.getId()) << " " << model.getScore() << " "
+        << model.lambda
+        << "\n";
+
+    std::vector<Criterion> crits = model.criteria.getCriterionVect();
+    out << crits.size();
+    for (const Criterion &crit : crits) {
+      out << " " << checkId(crit.getId()) << " " << crit.getDirection() << " "
+          << crit.getWeight();
+    }
+    out << "\n";
+
+    Categories categories = model.categories;
+    std::vector<std::string> cat_ids = categories.getIdCategories();
+    std::vector<int> cat_ranks = categories.getRankCategories();
+    out << cat_ids.size();
+    for (int k = 0; k < cat_ids.size(); k++) {
+      out << " " << checkId(cat_ids[k]) << " " << cat_ranks[k];
+    }
+    out << "\n";
+
+    std::vector<std::vector<Perf>> rows =
+        model.profiles.getPerformanceTable();
+    out << model.profiles.getMode() << " " << rows.size() << "\n";
+    for (const std::vector<Perf> &row : rows) {
+      out << row.size();
+      for (const Perf &perf : row) {
+        out << " " << checkId(perf.name_) << " " << checkId(perf.crit_) << " "
+            << perf.value_;
+      }
+      out << "\n";
+    }
+  }
+  return out.str();
+}
+
+std::vector<MRSortModel> decodeModels(const std::string &encoded) {
+  std::vector<MRSortModel> models;
+  if (encoded.empty()) {
+    return models;
+  }
+  std::istringstream in(encoded);
+  size_t n_models = readCount(in, encoded.size());
+  for (size_t m = 0; m < n_models; m++) {
+    std::string id;
+    float score, lambda;
+    in >> id >> score >> lambda;
+    checkRead(in);
+    size_t n_crit = readCount(in, encoded.size());
+    std::vector<Criterion> crit_vect;
+    for (size_t i = 0; i < n_crit; i++) {
+      std::string crit_id;
+      int direction;
+      float weight;
+      in >> crit_id >> direction >> weight;
+      checkRead(in);
+      crit_vect.push_back(Criterion(crit_id, direction, weight));
+    }
+
+    size_t n_cat = readCount(in, encoded.size());
+    std::vector<std::string> cat_ids(n_cat);
+    std::vector<int> cat_ranks(n_cat);
+    for (size_t k = 0; k < n_cat; k++) {
+      in >> cat_ids[k] >> cat_ranks[k];
+      checkRead(in);
+    }
+
+    std::string mode;
+    in >> mode;
+    checkRead(in);
+    size_t n_rows = readCount(in, encoded.size());
+    std::vector<std::vector<Perf>> rows(n_rows);
+    for (size_t r = 0; r < n_rows; r++) {
+      size_t row_size = readCount(in, encoded.size());
+      for (size_t c = 0; c < row_size; c++) {
+        std::string name, crit;
+        float value;
+        in >> name >> crit >> value;
+        checkRead(in);
+        rows[r].push_back(Perf(name, crit, value));
+      }
+    }
+
+    Criteria criteria(crit_vect);
+    Categories categories(cat_ids);
+    categories.setRankCategories(cat_ranks);
+    Profiles profiles(rows, mode);
+    // the model checks the number of profiles, ie rows in "alt" mode
+    profiles.changeMode("alt");
+    MRSortModel model(criteria, profiles, categories, lambda, id);
+    model.profiles.changeMode(mode);
+    model.setScore(score);
+    models.push_back(model);
+  }
+  return models;
+}
@@ -42,15 +42,48 @@ int main(int argc, char *argv[]) {
   std::string conf_info =
       "Config loaded: { log_level: " +
       yaml_config["log_level"].as<std::string>() +
-      ", log_path: " + app_conf.log_file + ", data_dir: " + app_conf.data_dir +
+      ", log_path: " + app_conf.log_file +
+      ", log_queue_size: " + std::to_string(app_conf.log_queue_size) +
+      ", data_dir: " + app_conf.data_dir +
       ", model_batch_size: " + std::to_string(app_conf.model_batch_size) +
       ", max_iterations: " + std::to_string(app_conf.max_iterations) +
       ", n_profile_update: " + std::to_string(app_conf.n_profile_update) +
+      ", target_accuracy: " + std::to_string(app_conf.target_accuracy) +
+      ", max_stale_iterations: " +
+      std::to_string(app_conf.max_stale_iterations) +
+      ", time_budget_seconds: " +
+      std::to_string(app_conf.time_budget_seconds) +
+      ", min_diversity: " + std::to_string(app_conf.min_diversity) +
+      ", checkpoint_interval_seconds: " +
+      std::to_string(app_conf.checkpoint_interval_seconds) +
+      ", rank_encoding: " + std::to_string(app_conf.rank_encoding) +
+      ", reduce_lp: " + std::to_string(app_conf.reduce_lp) +
+      ", lp_solver: " + app_conf.lp_solver + ", lp_dump: " + app_conf.lp_dump +
+      ", subgradient_iterations: " +
+      std::to_string(app_conf.subgradient_iterations) +
+      ", lp_sample_size: " + std::to_string(app_conf.lp_sample_size) +
+      ", lp_sample_focus: " + std::to_string(app_conf.lp_sample_focus) +
+      ", out_of_core_sample: " + std::to_string(app_conf.out_of_core_sample) +
+      ", n_threads: " + std::to_string(app_conf.n_threads) +
+      ", n_islands: " + std::to_string(app_conf.n_islands) +
+      ", migration_interval: " + std::to_string(app_conf.migration_interval) +
+      ", n_migrants: " + std::to_string(app_conf.n_migrants) +
+      ", coordinator_socket: " + app_conf.coordinator_socket +
+      ", n_workers: " + std::to_string(app_conf.n_workers) +
+      ", worker: " + std::to_string(app_conf.worker) +
+      ", batch: " + app_conf.batch +
+      ", n_jobs: " + std::to_string(app_conf.n_jobs) +
+      ", server: " + std::to_string(app_conf.server) +
+      ", server_socket: " + app_conf.server_socket +
+      ", save_metrics: " + std::to_string(app_conf.save_metrics) +
+      ", trace: " + std::to_string(app_conf.trace) +
       ", dataset: " + app_conf.dataset + ", output: " + app_conf.output + " }";
   app_conf.logger->info(conf_info.c_str());
 
   // launch the app
   int app_status = app.run();
+  // write the queued log messages
+  spdlog::shutdown();
 
   // return status: success or failure
   return app_status;
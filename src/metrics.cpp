@@ -0,0 +1,136 @@
+#include "../include/metrics.h"
+
+#include <fstream>
+#include <sstream>
+
+void Metrics::Counter::add(std::uint64_t n) {
+  value.fetch_add(n, std::memory_order_relaxed);
+}
+
+std::uint64_t Metrics::Counter::get() const {
+  return value.load(std::memory_order_relaxed);
+}
+
+int Metrics::Histogram::bucketOf(std::uint64_t value) {
+  int bucket = 0;
+  while (value > 0) {
+    value >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void Metrics::Histogram::record(std::uint64_t value) {
+  count.fetch_add(1, std::memory_order_relaxed);
+  sum.fetch_add(value, std::memory_order_relaxed);
+  buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+  std::uint64_t current = min.load(std::memory_order_relaxed);
+  while (value < current &&
+         !min.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+  current = max.load(std::memory_order_relaxed);
+  while (value > current &&
+         !max.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+void Metrics::Histogram::recordSeconds(double seconds) {
+  this->record(seconds > 0 ? std::uint64_t(seconds * 1e6) : 0);
+}
+
+std::uint64_t Metrics::Histogram::getCount() const {
+  return count.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Metrics::Histogram::getSum() const {
+  return sum.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Metrics::Histogram::getMin() const {
+  return this->getCount() == 0 ? 0 : min.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Metrics::Histogram::getMax() const {
+  return max.load(std::memory_order_relaxed);
+}
+
+std::uint64_t Metrics::Histogram::getBucketCount(int bucket) const {
+  return buckets[bucket].load(std::memory_order_relaxed);
+}
+
+Metrics::Metrics() {}
+
+Metrics::Counter &Metrics::counter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<Counter> &counter = counters[name];
+  if (counter == nullptr) {
+    counter.reset(new Counter());
+  }
+  return *counter;
+}
+
+Metrics::Histogram &Metrics::histogram(const std::string &name) {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::unique_ptr<Histogram> &histogram = histograms[name];
+  if (histogram == nullptr) {
+    histogram.reset(new Histogram());
+  }
+  return *histogram;
+}
+
+std::string Metrics::toJson() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::ostringstream ss;
+  ss << "{\n  \"counters\": {";
+  std::string sep = "\n";
+  for (auto &counter : counters) {
+    ss << sep << "    \"" << counter.first << "\": " << counter.second->get();
+    sep = ",\n";
+  }
+  ss << "\n  },\n  \"histograms\": {";
+  sep = "\n";
+  for (auto &histogram : histograms) {
+    const Histogram &h = *histogram.second;
+    std::uint64_t count = h.getCount();
+    ss << sep << "    \"" << histogram.first << "\": {\"count\": " << count
+       << ", \"sum\": " << h.getSum() << ", \"min\": " << h.getMin()
+       << ", \"max\": " << h.getMax() << ", \"mean\": "
+       << (count == 0 ? 0 : double(h.getSum()) / count);
+
+    // quantiles are given as the upper bound of their bucket
+    std::uint64_t cumulated = 0;
+    const double quantiles[] = {0.5, 0.9, 0.99};
+    const char *quantile_names[] = {"p50", "p90", "p99"};
+    int q = 0;
+    std::ostringstream buckets;
+    std::string bucket_sep = "";
+    for (int b = 0; b < Histogram::n_buckets; b++) {
+      std::uint64_t bucket_count = h.getBucketCount(b);
+      if (bucket_count == 0) {
+        continue;
+      }
+      // bucket b holds the values up to 2^b - 1
+      std::uint64_t upper = b == 64 ? UINT64_MAX : (std::uint64_t(1) << b) - 1;
+      cumulated += bucket_count;
+      while (q < 3 && cumulated >= quantiles[q] * count) {
+        ss << ", \"" << quantile_names[q] << "\": " << upper;
+        q++;
+      }
+      buckets << bucket_sep << "\"" << upper << "\": " << bucket_count;
+      bucket_sep = ", ";
+    }
+    ss << ", \"buckets\": {" << buckets.str() << "}}";
+    sep = ",\n";
+  }
+  ss << "\n  }\n}\n";
+  return ss.str();
+}
+
+bool Metrics::save(const std::string &file_name) const {
+  std::ofstream file(file_name);
+  if (!file) {
+    return false;
+  }
+  file << this->toJson();
+  return bool(file);
+}
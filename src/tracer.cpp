@@ -0,0 +1,136 @@
+#include "../include/tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+std::atomic<std::uint64_t> next_tracer_id(1);
+} // namespace
+
+Tracer::Tracer(int capacity)
+    : id(next_tracer_id++), capacity(capacity),
+      epoch(std::chrono::steady_clock::now()) {
+  if (capacity < 1) {
+    throw std::invalid_argument("The capacity of the tracer must be >= 1");
+  }
+}
+
+void Tracer::enable(bool enabled) {
+  this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+std::int64_t Tracer::now() const {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now() - epoch)
+      .count();
+}
+
+std::shared_ptr<Tracer::Buffer> Tracer::acquireBuffer() {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (std::shared_ptr<Buffer> &buffer : buffers) {
+    bool in_use = false;
+    if (buffer->in_use.compare_exchange_strong(in_use, true)) {
+      return buffer;
+    }
+  }
+  std::shared_ptr<Buffer> buffer = std::make_shared<Buffer>();
+  buffer->tid = buffers.size();
+  buffers.push_back(buffer);
+  return buffer;
+}
+
+void Tracer::record(const char *name, int model, std::int64_t start,
+                    std::int64_t duration) {
+  // buffer of the calling thread, given back to its tracer when the thread
+  // exits. The buffer outlives the tracer if needed.
+  struct ThreadBuffer {
+    std::uint64_t tracer_id = 0;
+    std::shared_ptr<Buffer> buffer;
+    ~ThreadBuffer() {
+      if (buffer != nullptr) {
+        buffer->in_use.store(false);
+      }
+    }
+  };
+  static thread_local ThreadBuffer thread_buffer;
+  if (thread_buffer.tracer_id != id) {
+    if (thread_buffer.buffer != nullptr) {
+      thread_buffer.buffer->in_use.store(false);
+    }
+    thread_buffer.buffer = this->acquireBuffer();
+    thread_buffer.tracer_id = id;
+  }
+
+  // single writer: only the owning thread records in the buffer
+  Buffer &buffer = *thread_buffer.buffer;
+  std::uint64_t n = buffer.n_recorded.load(std::memory_order_relaxed);
+  if (n < capacity) {
+    buffer.events.push_back(Event{name, model, start, duration});
+  } else {
+    buffer.events[n % capacity] = Event{name, model, start, duration};
+  }
+  buffer.n_recorded.store(n + 1, std::memory_order_release);
+}
+
+std::uint64_t Tracer::getNumberSpans() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::uint64_t n_spans = 0;
+  for (const std::shared_ptr<Buffer> &buffer : buffers) {
+    n_spans += std::min<std::uint64_t>(
+        buffer->n_recorded.load(std::memory_order_acquire), capacity);
+  }
+  return n_spans;
+}
+
+std::uint64_t Tracer::getNumberDropped() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::uint64_t n_dropped = 0;
+  for (const std::shared_ptr<Buffer> &buffer : buffers) {
+    std::uint64_t n = buffer->n_recorded.load(std::memory_order_acquire);
+    n_dropped += n > capacity ? n - capacity : 0;
+  }
+  return n_dropped;
+}
+
+std::string Tracer::toJson() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  std::ostringstream ss;
+  ss << std::fixed;
+  ss.precision(3);
+  ss << "{\"traceEvents\": [";
+  std::string sep = "\n";
+  std::uint64_t n_dropped = 0;
+  for (const std::shared_ptr<Buffer> &buffer : buffers) {
+    std::uint64_t n = buffer->n_recorded.load(std::memory_order_acquire);
+    // oldest span first
+    std::uint64_t first = n > capacity ? n - capacity : 0;
+    n_dropped += first;
+    for (std::uint64_t i = first; i < n; i++) {
+      const Event &event = buffer->events[i % capacity];
+      // timestamps in microseconds
+      ss << sep << "{\"name\": \"" << event.name
+         << "\", \"ph\": \"X\", \"pid\": 0, \"tid\": " << buffer->tid
+         << ", \"ts\": " << event.start / 1000. << ", \"dur\": "
+         << event.duration / 1000.;
+      if (event.model >= 0) {
+        ss << ", \"args\": {\"model\": " << event.model << "}";
+      }
+      ss << "}";
+      sep = ",\n";
+    }
+  }
+  ss << "\n], \"displayTimeUnit\": \"ms\", \"otherData\": {\"dropped_spans\": "
+     << n_dropped << "}}\n";
+  return ss.str();
+}
+
+bool Tracer::save(const std::string &file_name) const {
+  std::ofstream file(file_name);
+  if (!file) {
+    return false;
+  }
+  file << this->toJson();
+  return bool(file);
+}
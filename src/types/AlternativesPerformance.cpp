@@ -1,11 +1,16 @@
 #include "../../include/types/AlternativesPerformance.h"
 #include "../../include/types/Category.h"
 #include "../../include/utils.h"
+#include <string_view>
 #include <typeinfo>
+#include <unordered_set>
+#include <utility>
 
 Category default_cat;
 std::unordered_map<std::string, Category> default_map;
 
+std::atomic<long> AlternativesPerformance::n_copies_(0);
+
 AlternativesPerformance::AlternativesPerformance(
     std::vector<std::vector<Perf>> &perf_vect,
     std::unordered_map<std::string, Category> &alt_assignment)
@@ -20,13 +25,7 @@ AlternativesPerformance::AlternativesPerformance(
       alt_assignment_[altName] = default_cat;
     }
   } else {
-    // Check if the alternatives are in the performance table
-    for (std::pair<std::string, Category> element : alt_assignment) {
-      if (!this->isAltInTable(element.first)) {
-        throw std::invalid_argument("The alternatives in the map should be "
-                                    "present in the performance table.");
-      }
-    }
+    this->checkAssignments(alt_assignment);
     alt_assignment_ = alt_assignment;
   }
 }
@@ -45,13 +44,7 @@ AlternativesPerformance::AlternativesPerformance(
       alt_assignment_[altName] = default_cat;
     }
   } else {
-    // Check if the alternatives are in the performance table
-    for (std::pair<std::string, Category> element : alt_assignment) {
-      if (!this->isAltInTable(element.first)) {
-        throw std::invalid_argument("The alternatives in the map should be "
-                                    "present in the performance table.");
-      }
-    }
+    this->checkAssignments(alt_assignment);
     alt_assignment_ = alt_assignment;
   }
 }
@@ -60,6 +53,7 @@ AlternativesPerformance::AlternativesPerformance(
     const PerformanceTable &perf_table,
     std::unordered_map<std::string, Category> &alt_assignment)
     : PerformanceTable(perf_table) {
+  n_copies_.fetch_add(1, std::memory_order_relaxed);
   if (alt_assignment.empty()) {
     if (mode_ != "alt") {
       throw std::domain_error("Performance table mode should be alt to "
@@ -70,26 +64,48 @@ AlternativesPerformance::AlternativesPerformance(
       alt_assignment_[altName] = default_cat;
     }
   } else {
-    // Check if the alternatives are in the performance table
-    for (std::pair<std::string, Category> element : alt_assignment) {
-      if (!this->isAltInTable(element.first)) {
-        throw std::invalid_argument(
-            "The alternatives in the map should be present "
-            "in the performance table.");
-      }
-    }
+    this->checkAssignments(alt_assignment);
     alt_assignment_ = alt_assignment;
   }
 }
 
+AlternativesPerformance::AlternativesPerformance(
+    const PerformanceTable &perf_table,
+    std::unordered_map<std::string, Category> &&alt_assignment, Trusted)
+    : PerformanceTable(perf_table), alt_assignment_(std::move(alt_assignment)) {
+  n_copies_.fetch_add(1, std::memory_order_relaxed);
+}
+
 AlternativesPerformance::AlternativesPerformance(
     const AlternativesPerformance &alt)
     : PerformanceTable(alt) {
+  n_copies_.fetch_add(1, std::memory_order_relaxed);
   alt_assignment_ = alt.alt_assignment_;
 }
 
+AlternativesPerformance::AlternativesPerformance(
+    AlternativesPerformance &&alt) noexcept = default;
+
+AlternativesPerformance &
+AlternativesPerformance::operator=(const AlternativesPerformance &alt) {
+  if (this != &alt) {
+    PerformanceTable::operator=(alt);
+    alt_assignment_ = alt.alt_assignment_;
+    n_copies_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return *this;
+}
+
+AlternativesPerformance &
+AlternativesPerformance::operator=(AlternativesPerformance &&alt) noexcept =
+    default;
+
 AlternativesPerformance::~AlternativesPerformance() {}
 
+long AlternativesPerformance::getNumberCopies() {
+  return n_copies_.load(std::memory_order_relaxed);
+}
+
 std::ostream &operator<<(std::ostream &out,
                          const AlternativesPerformance &alt) {
   out << "AlternativesPerformance( PerformanceTable[ ";
@@ -111,32 +127,30 @@ std::ostream &operator<<(std::ostream &out,
   return out;
 }
 
-std::unordered_map<std::string, Category>
+const std::unordered_map<std::string, Category> &
 AlternativesPerformance::getAlternativesAssignments() const {
   return alt_assignment_;
 }
 
 void AlternativesPerformance::setAlternativesAssignments(
     std::unordered_map<std::string, Category> &alt_assignment) {
-  // Check if the alternatives are in the performance table
-  for (std::pair<std::string, Category> element : alt_assignment) {
-    if (!this->isAltInTable(element.first)) {
-      throw std::invalid_argument(
-          "The alternatives in the map should be present "
-          "in the performance table.");
-    }
-  }
+  this->checkAssignments(alt_assignment);
   alt_assignment_ = alt_assignment;
 }
 
-Category
-AlternativesPerformance::getAlternativeAssignment(std::string altName) const {
+const Category &AlternativesPerformance::getAlternativeAssignment(
+    const std::string &altName) const {
   return alt_assignment_.find(altName)->second;
 }
 
-void AlternativesPerformance::setAlternativeAssignment(std::string altName,
-                                                       Category &cat) {
-  if (this->isAltInTable(altName)) {
+void AlternativesPerformance::setAlternativeAssignment(
+    const std::string &altName, Category &cat) {
+  // an alternative already assigned is in the table, the table is only
+  // searched for the others
+  auto it = alt_assignment_.find(altName);
+  if (it != alt_assignment_.end()) {
+    it->second = cat;
+  } else if (this->isAltInTable(altName)) {
     alt_assignment_[altName] = cat;
   } else {
     throw std::invalid_argument("The alternatives in the map should be present "
@@ -171,4 +185,28 @@ std::pair<float, float> AlternativesPerformance::getBoundaries() {
   // return upper (resp. lower) bound which is a bit higher (resp. lower) than
   // the max (resp. min)
   return std::pair<float, float>(min - 0.1, max + 0.1);
-}
\ No newline at end of file
+}
+
+void AlternativesPerformance::checkAssignments(
+    const std::unordered_map<std::string, Category> &alt_assignment) const {
+  // the names of the table are hashed once instead of searching the table for
+  // each alternative of the map
+  std::unordered_set<std::string_view> alt_names;
+  if (mode_ == "alt") {
+    alt_names.reserve(pt_.size());
+    for (const std::vector<Perf> &p : pt_) {
+      alt_names.insert(p[0].name_);
+    }
+  } else if (!pt_.empty()) {
+    alt_names.reserve(pt_[0].size());
+    for (const Perf &perf : pt_[0]) {
+      alt_names.insert(perf.name_);
+    }
+  }
+  for (const auto &element : alt_assignment) {
+    if (alt_names.find(element.first) == alt_names.end()) {
+      throw std::invalid_argument("The alternatives in the map should be "
+                                  "present in the performance table.");
+    }
+  }
+}
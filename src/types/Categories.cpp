@@ -27,9 +27,13 @@ Categories::Categories(const Categories &categories) {
   }
 }
 
-Category Categories::operator[](int index) { return categories_vector_[index]; }
+Categories::Categories(Categories &&categories) noexcept = default;
 
-Category Categories::operator[](int index) const {
+Categories &Categories::operator=(const Categories &categories) = default;
+
+Categories &Categories::operator=(Categories &&categories) noexcept = default;
+
+const Category &Categories::operator[](int index) const {
   return categories_vector_[index];
 }
 
@@ -0,0 +1,368 @@
+#include "../../include/types/ColumnarDataset.h"
+#include "../../include/types/Category.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <unordered_set>
+
+// Layout of the columnar file, in native byte order:
+// - magic (8 bytes), n_alt (uint64), n_crit (uint32), n_cat (uint32), size of
+//   the names (uint64)
+// - ids of the criteria then of the categories by rank, each as a length
+//   (uint32) followed by its characters
+// - offsets of the names (n_alt + 1 uint64, aligned on 8 bytes), then the
+//   names
+// - ranks of the expected categories (n_alt int32, aligned on 64 bytes)
+// - one column of n_alt floats per criterion, each aligned on 64 bytes
+namespace {
+const char columnar_magic[8] = {'F', 'P', 'L', 'C', 'O', 'L', 'S', '1'};
+
+std::uint64_t align(std::uint64_t offset, std::uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+void writePadding(std::ofstream &file, std::uint64_t &offset,
+                  std::uint64_t alignment) {
+  std::uint64_t aligned = align(offset, alignment);
+  for (; offset < aligned; offset++) {
+    file.put(0);
+  }
+}
+
+template <typename T>
+void writeValue(std::ofstream &file, std::uint64_t &offset, T value) {
+  file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  offset += sizeof(T);
+}
+
+void writeString(std::ofstream &file, std::uint64_t &offset,
+                 const std::string &str) {
+  writeValue<std::uint32_t>(file, offset, str.size());
+  file.write(str.data(), str.size());
+  offset += str.size();
+}
+} // namespace
+
+void ColumnarDataset::write(const AlternativesPerformance &ap,
+                            const std::string &file_name) {
+  // only a dataset in crit mode is copied, to be read alternative by
+  // alternative
+  std::unique_ptr<AlternativesPerformance> alt_copy;
+  const AlternativesPerformance *alt_ap = &ap;
+  if (ap.getMode() != "alt") {
+    alt_copy = std::make_unique<AlternativesPerformance>(ap);
+    alt_copy->changeMode("alt");
+    alt_ap = alt_copy.get();
+  }
+  const std::vector<std::vector<Perf>> &pt = alt_ap->getPerformanceTable();
+  const std::unordered_map<std::string, Category> &assignments =
+      alt_ap->getAlternativesAssignments();
+  std::uint64_t n_alt = pt.size();
+  std::uint32_t n_crit = n_alt > 0 ? pt[0].size() : 0;
+
+  std::vector<std::int32_t> ranks;
+  std::vector<std::string> cat_ids;
+  std::uint64_t names_size = 0;
+  for (const std::vector<Perf> &alt : pt) {
+    if (alt.size() != n_crit) {
+      throw std::invalid_argument(
+          "All the alternatives must have the same number of criteria");
+    }
+    names_size += alt[0].name_.size();
+    auto it = assignments.find(alt[0].name_);
+    if (it == assignments.end() || it->second.rank_ < 0) {
+      ranks.push_back(-1);
+      continue;
+    }
+    ranks.push_back(it->second.rank_);
+    if (cat_ids.size() <= it->second.rank_) {
+      cat_ids.resize(it->second.rank_ + 1);
+    }
+    cat_ids[it->second.rank_] = it->second.category_id_;
+  }
+
+  std::ofstream file(file_name, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Cannot write the columnar dataset " + file_name);
+  }
+  std::uint64_t offset = 0;
+  file.write(columnar_magic, sizeof(columnar_magic));
+  offset += sizeof(columnar_magic);
+  writeValue<std::uint64_t>(file, offset, n_alt);
+  writeValue<std::uint32_t>(file, offset, n_crit);
+  writeValue<std::uint32_t>(file, offset, cat_ids.size());
+  writeValue<std::uint64_t>(file, offset, names_size);
+  for (std::uint32_t j = 0; j < n_crit; j++) {
+    writeString(file, offset, pt[0][j].crit_);
+  }
+  for (std::string &cat_id : cat_ids) {
+    writeString(file, offset, cat_id);
+  }
+
+  writePadding(file, offset, 8);
+  std::uint64_t name_offset = 0;
+  writeValue<std::uint64_t>(file, offset, name_offset);
+  for (const std::vector<Perf> &alt : pt) {
+    name_offset += alt[0].name_.size();
+    writeValue<std::uint64_t>(file, offset, name_offset);
+  }
+  for (const std::vector<Perf> &alt : pt) {
+    file.write(alt[0].name_.data(), alt[0].name_.size());
+    offset += alt[0].name_.size();
+  }
+
+  writePadding(file, offset, 64);
+  for (std::int32_t rank : ranks) {
+    writeValue<std::int32_t>(file, offset, rank);
+  }
+  for (std::uint32_t j = 0; j < n_crit; j++) {
+    writePadding(file, offset, 64);
+    for (const std::vector<Perf> &alt : pt) {
+      if (alt[j].crit_ != pt[0][j].crit_) {
+        throw std::invalid_argument(
+            "All the alternatives must have the criteria in the same order");
+      }
+      writeValue<float>(file, offset, alt[j].value_);
+    }
+  }
+  if (!file) {
+    throw std::runtime_error("Cannot write the columnar dataset " + file_name);
+  }
+}
+
+ColumnarDataset::ColumnarDataset(const std::string &file_name)
+    : file_name(file_name), fd(-1), data(nullptr), size(0), n_alt(0),
+      n_crit(0) {
+  fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Cannot open " + file_name + ": " +
+                             std::strerror(errno));
+  }
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot stat " + file_name + ": " +
+                             std::strerror(errno));
+  }
+  size = st.st_size;
+  if (size > 0) {
+    data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      data = nullptr;
+      ::close(fd);
+      throw std::runtime_error("Cannot map " + file_name + ": " +
+                               std::strerror(errno));
+    }
+  }
+
+  try {
+    this->readLayout();
+  } catch (...) {
+    this->unmap();
+    throw;
+  }
+}
+
+void ColumnarDataset::readLayout() {
+  // checks that every part of the layout is in the file
+  const char *bytes = static_cast<const char *>(data);
+  std::uint64_t offset = 0;
+  auto reserve = [&](std::uint64_t length) {
+    if (length > size || offset > size - length) {
+      throw std::invalid_argument("Truncated columnar dataset " + file_name);
+    }
+    const char *ptr = bytes + offset;
+    offset += length;
+    return ptr;
+  };
+  auto readString = [&]() {
+    std::uint32_t length;
+    std::memcpy(&length, reserve(sizeof(length)), sizeof(length));
+    return std::string(reserve(length), length);
+  };
+  if (size < sizeof(columnar_magic) ||
+      std::memcmp(bytes, columnar_magic, sizeof(columnar_magic)) != 0) {
+    throw std::invalid_argument("Not a columnar dataset: " + file_name);
+  }
+  reserve(sizeof(columnar_magic));
+  std::uint64_t n_alt_u;
+  std::uint32_t n_crit_u, n_cat;
+  std::uint64_t names_size;
+  std::memcpy(&n_alt_u, reserve(sizeof(n_alt_u)), sizeof(n_alt_u));
+  std::memcpy(&n_crit_u, reserve(sizeof(n_crit_u)), sizeof(n_crit_u));
+  std::memcpy(&n_cat, reserve(sizeof(n_cat)), sizeof(n_cat));
+  std::memcpy(&names_size, reserve(sizeof(names_size)), sizeof(names_size));
+  n_alt = n_alt_u;
+  n_crit = n_crit_u;
+  for (int j = 0; j < n_crit; j++) {
+    crit_ids.push_back(readString());
+  }
+  for (std::uint32_t c = 0; c < n_cat; c++) {
+    cat_ids.push_back(readString());
+  }
+  offset = align(offset, 8);
+  name_offsets = reinterpret_cast<const std::uint64_t *>(
+      reserve((n_alt_u + 1) * sizeof(std::uint64_t)));
+  names = reserve(names_size);
+  offset = align(offset, 64);
+  ranks = reinterpret_cast<const std::int32_t *>(
+      reserve(n_alt_u * sizeof(std::int32_t)));
+  for (int j = 0; j < n_crit; j++) {
+    offset = align(offset, 64);
+    columns.push_back(
+        reinterpret_cast<const float *>(reserve(n_alt_u * sizeof(float))));
+  }
+}
+
+void ColumnarDataset::unmap() {
+  if (data != nullptr) {
+    ::munmap(data, size);
+    data = nullptr;
+  }
+  if (fd >= 0) {
+    ::close(fd);
+    fd = -1;
+  }
+}
+
+ColumnarDataset::~ColumnarDataset() { this->unmap(); }
+
+std::int64_t ColumnarDataset::getNumberAlt() const { return n_alt; }
+
+int ColumnarDataset::getNumberCrit() const { return n_crit; }
+
+const std::vector<std::string> &ColumnarDataset::getCriteriaIds() const {
+  return crit_ids;
+}
+
+std::string ColumnarDataset::getAltName(std::int64_t alt) const {
+  return std::string(names + name_offsets[alt],
+                     name_offsets[alt + 1] - name_offsets[alt]);
+}
+
+const float *ColumnarDataset::getColumn(int crit) const {
+  return columns[crit];
+}
+
+const std::int32_t *ColumnarDataset::getRanks() const { return ranks; }
+
+std::vector<std::int64_t> ColumnarDataset::sample(std::int64_t n_sample,
+                                                  unsigned long int seed) const {
+  std::vector<std::int64_t> alts;
+  if (n_sample >= n_alt) {
+    for (std::int64_t i = 0; i < n_alt; i++) {
+      alts.push_back(i);
+    }
+    return alts;
+  }
+  // Floyd's algorithm, the memory only depends on the size of the sample
+  std::mt19937_64 gen(seed);
+  std::unordered_set<std::int64_t> drawn;
+  for (std::int64_t j = n_alt - n_sample; j < n_alt; j++) {
+    std::int64_t t = std::uniform_int_distribution<std::int64_t>(0, j)(gen);
+    if (!drawn.insert(t).second) {
+      drawn.insert(j);
+    }
+  }
+  alts.assign(drawn.begin(), drawn.end());
+  std::sort(alts.begin(), alts.end());
+  return alts;
+}
+
+AlternativesPerformance
+ColumnarDataset::materialize(const std::vector<std::int64_t> &alts) const {
+  std::vector<std::vector<Perf>> perf_vect;
+  std::unordered_map<std::string, Category> assignments;
+  for (std::int64_t alt : alts) {
+    if (alt < 0 || alt >= n_alt) {
+      throw std::invalid_argument("Alternative index out of the dataset");
+    }
+    std::string name = this->getAltName(alt);
+    std::vector<Perf> perfs;
+    for (int j = 0; j < n_crit; j++) {
+      perfs.push_back(Perf(name, crit_ids[j], columns[j][alt]));
+    }
+    perf_vect.push_back(perfs);
+    if (ranks[alt] >= 0 && ranks[alt] < cat_ids.size()) {
+      assignments[name] = Category(cat_ids[ranks[alt]], ranks[alt]);
+    }
+  }
+  return AlternativesPerformance(perf_vect, assignments);
+}
+
+float ColumnarDataset::computeAccuracy(MRSortModel &model,
+                                       int block_size) const {
+  if (block_size < 1) {
+    throw std::invalid_argument("The block size must be >= 1");
+  }
+  if (model.profiles.getMode() != "alt") {
+    throw std::invalid_argument("Model's profile should be in alt mode.");
+  }
+  const std::vector<Criterion> &criteria = model.criteria.getCriterionVect();
+  std::vector<std::vector<Perf>> profiles_pt =
+      model.profiles.getPerformanceTable();
+  bool aligned = criteria.size() == n_crit;
+  for (int j = 0; aligned && j < n_crit; j++) {
+    aligned = criteria[j].getId() == crit_ids[j];
+  }
+  for (std::vector<Perf> &prof : profiles_pt) {
+    for (int j = 0; aligned && j < n_crit; j++) {
+      aligned = prof.size() == n_crit && prof[j].crit_ == crit_ids[j];
+    }
+  }
+  if (!aligned) {
+    throw std::invalid_argument(
+        "The model must have the criteria of the dataset, in the same order");
+  }
+  const std::vector<float> &weights = model.criteria.getWeights();
+  int n_prof = profiles_pt.size();
+
+  // the columns are read once, in order
+  if (data != nullptr) {
+    ::posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+  }
+  std::vector<float> concordance(block_size);
+  std::vector<int> block_ranks(block_size);
+  std::int64_t acc = 0;
+  for (std::int64_t start = 0; start < n_alt; start += block_size) {
+    int n = std::min<std::int64_t>(block_size, n_alt - start);
+    std::fill(block_ranks.begin(), block_ranks.begin() + n, 0);
+    // the highest profile with a concordance >= lambda gives the category,
+    // as in MRSortModel::categoryAssignment
+    for (int h = 0; h < n_prof; h++) {
+      std::fill(concordance.begin(), concordance.begin() + n, 0.f);
+      for (int j = 0; j < n_crit; j++) {
+        const float *column = columns[j] + start;
+        const float b = profiles_pt[h][j].value_;
+        const float w = weights[j];
+        for (int a = 0; a < n; a++) {
+          concordance[a] += column[a] > b ? w : 0.f;
+        }
+      }
+      for (int a = 0; a < n; a++) {
+        if (concordance[a] >= model.lambda) {
+          block_ranks[a] = h + 1;
+        }
+      }
+    }
+    for (int a = 0; a < n; a++) {
+      if (block_ranks[a] == ranks[start + a]) {
+        acc++;
+      }
+    }
+  }
+  if (data != nullptr) {
+    ::posix_madvise(data, size, POSIX_MADV_NORMAL);
+  }
+  return float(acc) / float(n_alt);
+}
@@ -7,17 +7,12 @@
 #include <string>
 #include <vector>
 
-Criteria::Criteria(std::vector<Criterion> &criterion_vect) {
-  std::vector<std::string> crit_id_vect;
-  for (Criterion crit : criterion_vect) {
-    // ensure there is no criterion with duplicated name
-    if (std::find(crit_id_vect.begin(), crit_id_vect.end(), crit.getId()) !=
-        crit_id_vect.end()) {
-      throw std::invalid_argument("Each criterion must have different ids.");
-    }
-    crit_id_vect.push_back(crit.getId());
-
-    criterion_vect_.push_back(Criterion(crit));
+Criteria::Criteria(std::vector<Criterion> &criterion_vect)
+    : criterion_vect_(criterion_vect) {
+  this->indexCriteria();
+  // ensure there is no criterion with duplicated name
+  if (index_.size() != criterion_vect_.size()) {
+    throw std::invalid_argument("Each criterion must have different ids.");
   }
 }
 
@@ -25,20 +20,24 @@ Criteria::Criteria(int nb_of_criteria, std::string prefix) {
   for (int i = 0; i < nb_of_criteria; i++) {
     criterion_vect_.push_back(Criterion(prefix + std::to_string(i)));
   }
+  this->indexCriteria();
 }
 
-Criteria::Criteria(const Criteria &crits) {
-  // deep copy
-  for (int i = 0; i < crits.criterion_vect_.size(); i++) {
-    criterion_vect_.push_back(Criterion(crits.criterion_vect_[i]));
-  }
-}
+Criteria::Criteria(const Criteria &crits)
+    : criterion_vect_(crits.criterion_vect_), weights_(crits.weights_),
+      index_(crits.index_) {}
+
+Criteria::Criteria(Criteria &&crits) noexcept = default;
+
+Criteria &Criteria::operator=(const Criteria &crits) = default;
+
+Criteria &Criteria::operator=(Criteria &&crits) noexcept = default;
 
 Criteria::~Criteria() {}
 
 std::ostream &operator<<(std::ostream &out, const Criteria &crits) {
   out << "Criteria(";
-  for (Criterion crit : crits.criterion_vect_) {
+  for (const Criterion &crit : crits.criterion_vect_) {
     out << crit << ", ";
   }
   out << ")";
@@ -46,57 +45,53 @@ std::ostream &operator<<(std::ostream &out, const Criteria &crits) {
 }
 
 void Criteria::setCriterionVect(std::vector<Criterion> &criterion_vect) {
-  criterion_vect_.clear();
-  // deep copy
-  for (int i = 0; i < criterion_vect.size(); i++) {
-    criterion_vect_.push_back(Criterion(criterion_vect[i]));
-  }
+  criterion_vect_ = criterion_vect;
+  this->indexCriteria();
 }
 
-std::vector<Criterion> Criteria::getCriterionVect() const {
+const std::vector<Criterion> &Criteria::getCriterionVect() const {
   return criterion_vect_;
 };
 
+void Criteria::indexCriteria() {
+  weights_.clear();
+  index_.clear();
+  for (int i = 0; i < criterion_vect_.size(); i++) {
+    weights_.push_back(criterion_vect_[i].getWeight());
+    index_.emplace(criterion_vect_[i].getId(), i);
+  }
+}
+
 float Criteria::getMinWeight() {
   if (criterion_vect_.size() == 0) {
     return 0;
   }
-  float min = criterion_vect_[0].getWeight();
-  for (Criterion crit : criterion_vect_) {
-    if (crit.getWeight() < min) {
-      min = crit.getWeight();
-    }
-  }
-  return min;
+  return *std::min_element(weights_.begin(), weights_.end());
 }
 
 float Criteria::getMaxWeight() {
   if (criterion_vect_.size() == 0) {
     return 0;
   }
-  float max = criterion_vect_[0].getWeight();
-  for (Criterion crit : criterion_vect_) {
-    if (crit.getWeight() > max) {
-      max = crit.getWeight();
-    }
-  }
-  return max;
+  return *std::max_element(weights_.begin(), weights_.end());
 }
 
 float Criteria::getSumWeight() {
-  float sum = 0;
-  for (Criterion crit : criterion_vect_) {
-    sum += crit.getWeight();
-  }
-  return sum;
+  return std::accumulate(weights_.begin(), weights_.end(), 0.0f);
 }
 
-std::vector<float> Criteria::getWeights() const {
-  std::vector<float> weights;
-  for (Criterion c : criterion_vect_) {
-    weights.push_back(c.getWeight());
+const std::vector<float> &Criteria::getWeights() const { return weights_; }
+
+int Criteria::getIndex(const std::string &name) const {
+  auto it = index_.find(name);
+  if (it == index_.end()) {
+    throw std::invalid_argument("Criterion not found in this Criteria vector");
   }
-  return weights;
+  return it->second;
+}
+
+float Criteria::getWeight(const std::string &name) const {
+  return weights_[this->getIndex(name)];
 }
 
 void Criteria::setWeights(std::vector<float> newWeigths) {
@@ -107,17 +102,16 @@ void Criteria::setWeights(std::vector<float> newWeigths) {
   }
   for (int i = 0; i < criterion_vect_.size(); i++) {
     criterion_vect_[i].setWeight(newWeigths[i]);
+    weights_[i] = newWeigths[i];
   }
 }
 
 void Criteria::normalizeWeights() {
   float sum = Criteria::getSumWeight();
-  std::vector<float> weights = Criteria::getWeights();
+  std::vector<float> weights = weights_;
   std::transform(weights.begin(), weights.end(), weights.begin(),
                  [&sum](float &c) { return c / sum; });
-  for (int i = 0; i < weights.size(); i++) {
-    criterion_vect_[i].setWeight(weights[i]);
-  }
+  Criteria::setWeights(weights);
 }
 
 // TODO Generation is not completely uniform here, might need to find an other
@@ -134,12 +128,7 @@ void Criteria::generateRandomCriteriaWeights(unsigned long int seed) {
 }
 
 Criterion Criteria::operator[](std::string name) const {
-  for (Criterion c : criterion_vect_) {
-    if (c.getId() == name) {
-      return c;
-    }
-  }
-  throw std::invalid_argument("Criterion not found in this Criteria vector");
+  return criterion_vect_[this->getIndex(name)];
 }
 
 Criterion Criteria::operator[](int index) { return criterion_vect_[index]; }
@@ -378,8 +378,7 @@ AlternativesPerformance DataGenerator::loadDataset(std::string fileName) {
       vecPerformances.push_back(createVectorPerf(altId, criteria, altPerf));
     }
   }
-  return AlternativesPerformance(PerformanceTable(vecPerformances),
-                                 altAssignments);
+  return AlternativesPerformance(vecPerformances, altAssignments);
 }
 
 void DataGenerator::saveDataset(std::string fileName,
@@ -430,14 +429,14 @@ void DataGenerator::saveDataset(std::string fileName,
       .set_value(std::to_string(nb_alternatives).c_str());
 
   // looping over alternatives
-  for (std::vector<Perf> &p : altPerf.getPerformanceTable()) {
+  for (const std::vector<Perf> &p : altPerf.getPerformanceTable()) {
     pugi::xml_node alternative_node = dataset_node.append_child("alternative");
     // getting alternative id
     alternative_node.append_child(pugi::node_pcdata)
         .set_value(p[0].name_.c_str());
 
     // looping over performance values of specific alternative
-    for (Perf &perf : p) {
+    for (const Perf &perf : p) {
       // for each criteria give its correspondant performace
       pugi::xml_node alternative_criteria_node =
           alternative_node.append_child(perf.crit_.c_str());
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <map>
 #include <string>
+#include <utility>
 
 Categories default_cats;
 
@@ -45,15 +46,21 @@ MRSortModel::MRSortModel(const MRSortModel &mrsort)
   id_ = mrsort.id_;
 }
 
-Category
-MRSortModel::categoryAssignment(std::vector<Perf> &alt,
-                                std::vector<std::vector<Perf>> &profiles_pt) {
+MRSortModel::MRSortModel(MRSortModel &&mrsort) noexcept = default;
+
+MRSortModel &MRSortModel::operator=(const MRSortModel &mrsort) = default;
+
+MRSortModel &MRSortModel::operator=(MRSortModel &&mrsort) noexcept = default;
+
+Category MRSortModel::categoryAssignment(
+    const std::vector<Perf> &alt,
+    const std::vector<std::vector<Perf>> &profiles_pt, bool aligned) {
   bool assigned = false;
   Category cat_assignment;
   // For all alt, looping over all profiles in descending order
   for (int h = (profiles_pt.size() - 1); h >= 0; h--) {
     // compute the concordance value:
-    float c = computeConcordance(profiles_pt[h], alt);
+    float c = computeConcordance(profiles_pt[h], alt, aligned);
     // if the value of the concordance is greater than the threshold, assign
     // the category h to the alt.
     // As we are going in descending order, the category assigned is the
@@ -79,30 +86,84 @@ AlternativesPerformance MRSortModel::categoryAssignments(PerformanceTable &pt) {
         "Performance table set in wrong mode, should be alt.");
   }
   std::unordered_map<std::string, Category> cat_assignments;
-  std::vector<std::vector<Perf>> profiles_pt = profiles.getPerformanceTable();
+  const std::vector<std::vector<Perf>> &profiles_pt =
+      profiles.getPerformanceTable();
+  bool aligned = this->isAligned(profiles_pt, pt);
   // Looping over all alternatives
-  for (std::vector<Perf> &alt : pt.getPerformanceTable()) {
-    cat_assignments[alt[0].name_] = categoryAssignment(alt, profiles_pt);
+  for (const std::vector<Perf> &alt : pt.getPerformanceTable()) {
+    cat_assignments[alt[0].name_] =
+        categoryAssignment(alt, profiles_pt, aligned);
   }
-  return AlternativesPerformance(pt, cat_assignments);
+  // the alternatives are the ones of pt
+  return AlternativesPerformance(pt, std::move(cat_assignments),
+                                 PerformanceTable::Trusted());
 }
 
-float MRSortModel::computeConcordance(std::vector<Perf> &prof,
-                                      std::vector<Perf> &alt) {
+void MRSortModel::categoryAssignments(PerformanceTable &pt,
+                                      AlternativesPerformance &altPerf_model) {
+  if (pt.getMode() != "alt") {
+    throw std::invalid_argument(
+        "Performance table set in wrong mode, should be alt.");
+  }
+  const std::vector<std::vector<Perf>> &profiles_pt =
+      profiles.getPerformanceTable();
+  bool aligned = this->isAligned(profiles_pt, pt);
+  for (const std::vector<Perf> &alt : pt.getPerformanceTable()) {
+    Category cat = categoryAssignment(alt, profiles_pt, aligned);
+    altPerf_model.setAlternativeAssignment(alt[0].name_, cat);
+  }
+}
+
+float MRSortModel::computeConcordance(const std::vector<Perf> &prof,
+                                      const std::vector<Perf> &alt,
+                                      bool aligned) {
   float c = 0;
-  for (Perf &perf_j : alt) {
-    for (Perf &prof_i : prof) {
+  if (aligned) {
+    const std::vector<float> &weights = criteria.getWeights();
+    for (int j = 0; j < alt.size(); j++) {
+      if (alt[j].value_ > prof[j].value_) {
+        c = c + weights[j];
+      }
+    }
+    return c;
+  }
+  for (const Perf &perf_j : alt) {
+    for (const Perf &prof_i : prof) {
       // If the value of the alt on criterion j is greater than the one of
       // the profile h, add the weight of the criterion j to the concordance
       // value.
       if ((prof_i.crit_ == perf_j.crit_) && (perf_j.value_ > prof_i.value_)) {
-        c = c + criteria[perf_j.crit_].getWeight();
+        c = c + criteria.getWeight(perf_j.crit_);
       }
     }
   }
   return c;
 }
 
+bool MRSortModel::isAligned(const std::vector<Perf> &row) const {
+  const std::vector<Criterion> &crits = criteria.getCriterionVect();
+  if (row.size() != crits.size()) {
+    return false;
+  }
+  for (int j = 0; j < row.size(); j++) {
+    if (row[j].crit_ != crits[j].getId()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool MRSortModel::isAligned(const std::vector<std::vector<Perf>> &profiles_pt,
+                            const PerformanceTable &pt) const {
+  for (const std::vector<Perf> &prof : profiles_pt) {
+    if (!this->isAligned(prof)) {
+      return false;
+    }
+  }
+  const std::vector<std::vector<Perf>> &alts = pt.getPerformanceTable();
+  return alts.empty() || this->isAligned(alts[0]);
+}
+
 std::unordered_map<std::string, std::unordered_map<std::string, float>>
 MRSortModel::computeConcordanceTable(PerformanceTable &pt) {
   if (pt.getMode() != "alt") {
@@ -110,15 +171,18 @@ MRSortModel::computeConcordanceTable(PerformanceTable &pt) {
         "Performance table set in wrong mode, should be alt.");
   }
   std::unordered_map<std::string, std::unordered_map<std::string, float>> ct;
-  std::vector<std::vector<Perf>> profiles_pt = profiles.getPerformanceTable();
+  const std::vector<std::vector<Perf>> &profiles_pt =
+      profiles.getPerformanceTable();
+  bool aligned = this->isAligned(profiles_pt, pt);
   // Looping over all profiles
   for (int h = 0; h < profiles_pt.size(); h++) {
     std::unordered_map<std::string, float> prof_concordances;
     // Looping over all alternatives
-    for (std::vector<Perf> &alt : pt.getPerformanceTable()) {
-      prof_concordances[alt[0].name_] = computeConcordance(profiles_pt[h], alt);
+    for (const std::vector<Perf> &alt : pt.getPerformanceTable()) {
+      prof_concordances[alt[0].name_] =
+          computeConcordance(profiles_pt[h], alt, aligned);
     }
-    ct[profiles_pt[h][0].name_] = prof_concordances;
+    ct[profiles_pt[h][0].name_] = std::move(prof_concordances);
   }
   return ct;
 }
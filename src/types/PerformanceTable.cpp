@@ -8,6 +8,8 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 
 #include <chrono>
@@ -22,22 +24,25 @@ PerformanceTable::PerformanceTable(std::vector<std::vector<Perf>> &perf_vect,
     throw std::invalid_argument("Mode must be alt or crit.");
   }
   mode_ = mode;
+  // ids already seen, hashed: the names are not copied, they live in perf_vect
+  std::unordered_set<std::string_view> row_ids;
+  row_ids.reserve(perf_vect.size());
+  pt_.reserve(perf_vect.size());
+  const std::vector<Perf> &first = perf_vect[0];
   if (mode == "alt") {
-    std::vector<std::string> perf_id_vect;
-    std::vector<std::string> crit_vect = getCriterionIds(perf_vect[0]);
-
     for (std::vector<Perf> &p : perf_vect) {
       // ensure there is no performance with dupplicated name
-
-      if (std::find(perf_id_vect.begin(), perf_id_vect.end(), p[0].name_) !=
-          perf_id_vect.end()) {
+      if (!row_ids.insert(p[0].name_).second) {
         throw std::invalid_argument(
             "Each performance must have different ids.");
       }
-      perf_id_vect.push_back(p[0].name_);
 
       // ensure all the performance are based on the same set of criterion
-      if (getCriterionIds(p) != crit_vect) {
+      bool same_crits = p.size() == first.size();
+      for (int j = 0; same_crits && j < p.size(); j++) {
+        same_crits = p[j].crit_ == first[j].crit_;
+      }
+      if (!same_crits) {
         throw std::invalid_argument(
             "Each performance must be based on the same "
             "set of criterion, in the same order.");
@@ -45,20 +50,18 @@ PerformanceTable::PerformanceTable(std::vector<std::vector<Perf>> &perf_vect,
       pt_.push_back(p);
     }
   } else {
-    std::vector<std::string> crit_id_vect;
-    std::vector<std::string> altIdVec = getNameIds(perf_vect[0]);
-
     for (std::vector<Perf> &p : perf_vect) {
       // ensure there is no criteria id with duplicated name
-
-      if (std::find(crit_id_vect.begin(), crit_id_vect.end(), p[0].crit_) !=
-          crit_id_vect.end()) {
+      if (!row_ids.insert(p[0].crit_).second) {
         throw std::invalid_argument("Each row must have different criterias.");
       }
-      crit_id_vect.push_back(p[0].crit_);
 
       // ensure all the performance are based on the same set of criterion
-      if (getNameIds(p) != altIdVec) {
+      bool same_alts = p.size() == first.size();
+      for (int j = 0; same_alts && j < p.size(); j++) {
+        same_alts = p[j].name_ == first[j].name_;
+      }
+      if (!same_alts) {
         throw std::invalid_argument(
             "Each criteria row must be based on the same "
             "set of alternative ids, in the same order.");
@@ -79,18 +82,16 @@ PerformanceTable::PerformanceTable(int nb_of_perfs, Criteria &crits,
   }
 }
 
-PerformanceTable::PerformanceTable(const PerformanceTable &perfs) {
-  // deep copy
-  for (std::vector<Perf> p : perfs.pt_) {
-    std::vector<Perf> perf_vect;
-    for (Perf perf : p) {
-      perf_vect.push_back(Perf(perf));
-    }
-    pt_.push_back(perf_vect);
-  }
-  mode_ = perfs.mode_;
-  sorted_ = perfs.sorted_;
-}
+PerformanceTable::PerformanceTable(const PerformanceTable &perfs)
+    : pt_(perfs.pt_), mode_(perfs.mode_), sorted_(perfs.sorted_) {}
+
+PerformanceTable::PerformanceTable(PerformanceTable &&perfs) noexcept = default;
+
+PerformanceTable &
+PerformanceTable::operator=(const PerformanceTable &perfs) = default;
+
+PerformanceTable &
+PerformanceTable::operator=(PerformanceTable &&perfs) noexcept = default;
 
 PerformanceTable::~PerformanceTable() {}
 
@@ -107,19 +108,20 @@ std::ostream &operator<<(std::ostream &out, const PerformanceTable &perfs) {
   return out;
 }
 
-std::vector<Perf> PerformanceTable::operator[](std::string name) {
+const std::vector<Perf> &
+PerformanceTable::operator[](const std::string &name) const {
   // supposing the pt is consistent:
   // if in mode alt, each row contains 1 and only 1 (alternative or profile)
   // if in mode crit, each row contains 1 and only 1 criterion
   if (mode_ == "alt") {
-    for (std::vector<Perf> &p : pt_) {
+    for (const std::vector<Perf> &p : pt_) {
       if (p[0].name_ == name) {
         return p;
       }
     }
     throw std::invalid_argument("Row not found in performance table");
   } else if (mode_ == "crit") {
-    for (std::vector<Perf> &p : pt_) {
+    for (const std::vector<Perf> &p : pt_) {
       if (p[0].crit_ == name) {
         return p;
       }
@@ -180,7 +182,8 @@ Perf PerformanceTable::getPerf(std::string name, std::string crit) {
   }
 }
 
-std::vector<std::vector<Perf>> PerformanceTable::getPerformanceTable() const {
+const std::vector<std::vector<Perf>> &
+PerformanceTable::getPerformanceTable() const {
   return pt_;
 }
 
@@ -262,7 +265,7 @@ std::vector<Perf> PerformanceTable::getAltBetweenSorted(std::string critId,
   if (mode_ != "crit") {
     throw std::invalid_argument("Performance table mode must be crit.");
   } else {
-    std::vector<Perf> pv = this->operator[](critId);
+    const std::vector<Perf> &pv = this->operator[](critId);
     auto lower_b = std::lower_bound(
         pv.begin(), pv.end(), inf,
         [](const Perf &a, const float b) { return a.value_ < b; });
@@ -290,15 +293,15 @@ std::vector<Perf> PerformanceTable::getAltBetween(std::string critId, float inf,
     return v;
   }
   if (mode_ == "crit") {
-    std::vector<Perf> pv = this->operator[](critId);
-    for (Perf &perf : pv) {
+    const std::vector<Perf> &pv = this->operator[](critId);
+    for (const Perf &perf : pv) {
       if (perf.value_ >= inf and perf.value_ <= sup) {
         v.push_back(perf);
       }
     }
   } else if (mode_ == "alt") {
-    for (std::vector<Perf> &p : pt_) {
-      for (Perf &perf : p) {
+    for (const std::vector<Perf> &p : pt_) {
+      for (const Perf &perf : p) {
         if (perf.crit_ == critId and perf.value_ >= inf and
             perf.value_ <= sup) {
           v.push_back(perf);
@@ -375,8 +378,20 @@ std::vector<Perf> PerformanceTable::getWorstPerfByCrit(Criteria &crits) {
   return worst_pv;
 }
 
-bool PerformanceTable::isAltInTable(std::string altName) {
-  for (std::vector<Perf> &p : pt_) {
+bool PerformanceTable::isAltInTable(const std::string &altName) const {
+  if (mode_ == "crit") {
+    // each row holds all the alternatives
+    if (pt_.empty()) {
+      return false;
+    }
+    for (const Perf &perf : pt_[0]) {
+      if (perf.name_ == altName) {
+        return true;
+      }
+    }
+    return false;
+  }
+  for (const std::vector<Perf> &p : pt_) {
     if (p[0].name_ == altName) {
       return (true);
     }
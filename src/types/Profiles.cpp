@@ -7,6 +7,7 @@
 #include <random>
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 Profiles::Profiles(std::vector<std::vector<Perf>> &perf_vect, std::string mode)
@@ -36,6 +37,15 @@ Profiles::Profiles(const Profiles &profiles) : PerformanceTable(profiles) {
   sorted_ = 1;
 }
 
+Profiles::Profiles(Profiles &&profiles) noexcept
+    : PerformanceTable(std::move(profiles)) {
+  sorted_ = 1;
+}
+
+Profiles &Profiles::operator=(const Profiles &profiles) = default;
+
+Profiles &Profiles::operator=(Profiles &&profiles) noexcept = default;
+
 std::ostream &operator<<(std::ostream &out, const Profiles &profs) {
   out << "Profiles[ " << std::endl;
   for (std::vector<Perf> p : profs.pt_) {
@@ -121,26 +131,18 @@ Profiles::getBelowAndAboveProfile(std::string profName, float worst_value,
   for (int i = 0; i < n_crit; i++) {
     top.push_back(Perf("top", pt_[0][i].crit_, best_value));
   }
-  std::vector<Perf> below;
-  std::vector<Perf> above;
   if (mode_ == "alt") {
     if (pt_.size() == 1) {
-      return std::make_pair(base, top);
+      return std::make_pair(std::move(base), std::move(top));
     }
     for (int h = 0; h < pt_.size(); h++) {
       if (pt_[h][0].name_ == profName) {
         if (h == 0) {
-          below = base;
-          above = pt_[h + 1];
-          return std::make_pair(below, above);
+          return std::make_pair(std::move(base), pt_[h + 1]);
         } else if (h == pt_.size() - 1) {
-          below = pt_[h - 1];
-          above = top;
-          return std::make_pair(below, above);
+          return std::make_pair(pt_[h - 1], std::move(top));
         } else {
-          below = pt_[h - 1];
-          above = pt_[h + 1];
-          return std::make_pair(below, above);
+          return std::make_pair(pt_[h - 1], pt_[h + 1]);
         }
       }
     }
@@ -0,0 +1,115 @@
+#include "../include/app.h"
+#include "../include/batch.h"
+#include "gtest/gtest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+void writeBatchManifest(Config &conf, std::string file_name,
+                        std::string content) {
+  std::ofstream manifest(conf.data_dir + file_name);
+  manifest << content;
+}
+
+TEST(TestBatch, TestManifest) {
+  Config conf = getTestConf();
+  conf.max_iterations = 10;
+  writeBatchManifest(conf, "test_batch_manifest.yaml",
+                     "jobs:\n"
+                     "  - dataset: in1dataset.xml\n"
+                     "    output: test_batch_in1model.xml\n"
+                     "  - dataset: in7dataset.xml\n"
+                     "    output: test_batch_in7model.xml\n"
+                     "    overrides:\n"
+                     "      max_iterations: 2\n"
+                     "      trace: true\n"
+                     "  - dataset: in4dataset.xml\n"
+                     "    output: test_batch_in4model.xml\n");
+  Batch batch = Batch(conf, "test_batch_manifest.yaml");
+  std::remove((conf.data_dir + "test_batch_manifest.yaml").c_str());
+
+  const std::vector<Batch::Job> &jobs = batch.getJobs();
+  ASSERT_EQ(jobs.size(), 3);
+  // largest dataset first
+  EXPECT_EQ(jobs[0].dataset, "in7dataset.xml");
+  EXPECT_EQ(jobs[1].dataset, "in1dataset.xml");
+  EXPECT_EQ(jobs[2].dataset, "in4dataset.xml");
+  EXPECT_GE(jobs[0].size, jobs[1].size);
+  EXPECT_GE(jobs[1].size, jobs[2].size);
+
+  EXPECT_EQ(jobs[0].config.dataset, "in7dataset.xml");
+  EXPECT_EQ(jobs[0].config.output, "test_batch_in7model.xml");
+  EXPECT_EQ(jobs[0].config.max_iterations, 2);
+  EXPECT_TRUE(jobs[0].config.trace);
+  EXPECT_TRUE(jobs[0].config.tracer->isEnabled());
+  EXPECT_EQ(jobs[1].config.max_iterations, 10);
+  EXPECT_FALSE(jobs[1].config.trace);
+  // the metrics of a job are its own
+  EXPECT_NE(jobs[0].config.metrics, conf.metrics);
+  EXPECT_NE(jobs[0].config.metrics, jobs[1].config.metrics);
+}
+
+TEST(TestBatch, TestManifestErrors) {
+  Config conf = getTestConf();
+  EXPECT_THROW(Batch(conf, "test_batch_no_manifest.yaml"),
+               std::invalid_argument);
+
+  writeBatchManifest(conf, "test_batch_manifest_errors.yaml",
+                     "datasets:\n  - in1dataset.xml\n");
+  EXPECT_THROW(Batch(conf, "test_batch_manifest_errors.yaml"),
+               std::invalid_argument);
+
+  writeBatchManifest(conf, "test_batch_manifest_errors.yaml",
+                     "jobs:\n  - dataset: in1dataset.xml\n");
+  EXPECT_THROW(Batch(conf, "test_batch_manifest_errors.yaml"),
+               std::invalid_argument);
+
+  writeBatchManifest(conf, "test_batch_manifest_errors.yaml",
+                     "jobs:\n"
+                     "  - dataset: in1dataset.xml\n"
+                     "    output: test_batch_in1model.xml\n");
+  conf.n_jobs = 0;
+  EXPECT_THROW(Batch(conf, "test_batch_manifest_errors.yaml"),
+               std::invalid_argument);
+  std::remove((conf.data_dir + "test_batch_manifest_errors.yaml").c_str());
+}
+
+TEST(TestBatch, TestRun) {
+  Config conf = getTestConf();
+  conf.model_batch_size = 4;
+  conf.max_iterations = 2;
+  conf.n_profile_update = 2;
+  conf.save_metrics = false;
+  conf.n_jobs = 2;
+  writeBatchManifest(conf, "test_batch_manifest_run.yaml",
+                     "jobs:\n"
+                     "  - dataset: in1dataset.xml\n"
+                     "    output: test_batch_in1model.xml\n"
+                     "  - dataset: in4dataset.xml\n"
+                     "    output: test_batch_in4model.xml\n"
+                     "    overrides:\n"
+                     "      save_metrics: true\n"
+                     "  - dataset: no_dataset.xml\n"
+                     "    output: test_batch_nomodel.xml\n");
+  Batch batch = Batch(conf, "test_batch_manifest_run.yaml");
+  std::remove((conf.data_dir + "test_batch_manifest_run.yaml").c_str());
+
+  // the job without dataset fails, the others are learned anyway
+  EXPECT_EQ(batch.run(), 1);
+  EXPECT_TRUE(
+      std::filesystem::exists(conf.data_dir + "test_batch_in1model.xml"));
+  EXPECT_TRUE(
+      std::filesystem::exists(conf.data_dir + "test_batch_in4model.xml"));
+  EXPECT_FALSE(std::filesystem::exists(conf.data_dir +
+                                       "test_batch_in1model.xml.metrics.json"));
+  EXPECT_TRUE(std::filesystem::exists(conf.data_dir +
+                                      "test_batch_in4model.xml.metrics.json"));
+  EXPECT_FALSE(
+      std::filesystem::exists(conf.data_dir + "test_batch_nomodel.xml"));
+
+  std::remove((conf.data_dir + "test_batch_in1model.xml").c_str());
+  std::remove((conf.data_dir + "test_batch_in4model.xml").c_str());
+  std::remove((conf.data_dir + "test_batch_in4model.xml.metrics.json").c_str());
+}
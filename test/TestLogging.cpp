@@ -0,0 +1,47 @@
+#include "../include/logging.h"
+#include "gtest/gtest.h"
+#include "spdlog/sinks/ostream_sink.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+std::shared_ptr<spdlog::logger> getLoggingTestLogger(std::ostringstream &out) {
+  std::shared_ptr<spdlog::logger> logger = std::make_shared<spdlog::logger>(
+      "logging_test_logger",
+      std::make_shared<spdlog::sinks::ostream_sink_st>(out));
+  logger->set_pattern("%l %v");
+  return logger;
+}
+
+int countLoggingTestCalls(int &n_calls) { return ++n_calls; }
+
+TEST(TestLogging, TestFormat) {
+  std::ostringstream out;
+  std::shared_ptr<spdlog::logger> logger = getLoggingTestLogger(out);
+  logger->set_level(spdlog::level::debug);
+  FASTPL_DEBUG(logger, "accuracy of model {}: {}", 3, 0.5);
+  FASTPL_INFO(logger, "{} migrants received", 2);
+  EXPECT_EQ(out.str(), "debug accuracy of model 3: 0.5\ninfo 2 migrants "
+                       "received\n");
+}
+
+TEST(TestLogging, TestLazyArguments) {
+  std::ostringstream out;
+  std::shared_ptr<spdlog::logger> logger = getLoggingTestLogger(out);
+  logger->set_level(spdlog::level::info);
+  int n_calls = 0;
+  // the arguments of a filtered message are not evaluated
+  FASTPL_DEBUG(logger, "call {}", countLoggingTestCalls(n_calls));
+  EXPECT_FALSE(FASTPL_SHOULD_DEBUG(logger));
+  EXPECT_EQ(n_calls, 0);
+  EXPECT_EQ(out.str(), "");
+
+  FASTPL_WARN(logger, "call {}", countLoggingTestCalls(n_calls));
+  EXPECT_EQ(n_calls, 1);
+  EXPECT_EQ(out.str(), "warning call 1\n");
+
+  logger->set_level(spdlog::level::debug);
+  EXPECT_EQ(FASTPL_SHOULD_DEBUG(logger),
+            SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG);
+}
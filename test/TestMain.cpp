@@ -1,15 +1,32 @@
 #include "types/TestDataGenerator.cpp"
 
+#include "TestBatch.cpp"
+#include "TestLogging.cpp"
+#include "TestMetrics.cpp"
+#include "TestTracer.cpp"
 #include "TestUtils.cpp"
+#include "learning/TestAssignmentKernel.cpp"
+#include "learning/TestConvergenceController.cpp"
+#include "learning/TestCoordinator.cpp"
+#include "learning/TestModelCheckpointer.cpp"
 #include "learning/TestHeuristicPipeline.cpp"
 #include "learning/TestInitializeProfile.cpp"
+#include "learning/TestIslandPipeline.cpp"
+#include "learning/TestLPSolverPool.cpp"
+#include "learning/TestLearningServer.cpp"
 #include "learning/TestLinearSolver.cpp"
+#include "learning/TestMigrationMailbox.cpp"
 #include "learning/TestProfileUpdater.cpp"
+#include "learning/TestScratchArena.cpp"
+#include "learning/TestSimplexSolver.cpp"
+#include "learning/TestSubgradientSolver.cpp"
 #include "learning/TestWeightUpdater.cpp"
+#include "learning/TestWorkerProtocol.cpp"
 
 #include "types/TestAlternativesPerformance.cpp"
 #include "types/TestCategories.cpp"
 #include "types/TestCategory.cpp"
+#include "types/TestColumnarDataset.cpp"
 #include "types/TestCriteria.cpp"
 #include "types/TestCriterion.cpp"
 #include "types/TestMRSortModel.cpp"
@@ -0,0 +1,106 @@
+#include "../include/metrics.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(TestMetrics, TestCounter) {
+  Metrics metrics;
+  Metrics::Counter &counter = metrics.counter("events");
+  EXPECT_EQ(counter.get(), 0);
+  counter.add();
+  counter.add(4);
+  EXPECT_EQ(counter.get(), 5);
+  // the same name gives the same counter
+  EXPECT_EQ(&metrics.counter("events"), &counter);
+  EXPECT_EQ(metrics.counter("events").get(), 5);
+}
+
+TEST(TestMetrics, TestCounterThreads) {
+  Metrics metrics;
+  Metrics::Counter &counter = metrics.counter("events");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&counter]() {
+      for (int i = 0; i < 10000; i++) {
+        counter.add();
+      }
+    }));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(counter.get(), 40000);
+}
+
+TEST(TestMetrics, TestHistogramBuckets) {
+  EXPECT_EQ(Metrics::Histogram::bucketOf(0), 0);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(1), 1);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(2), 2);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(3), 2);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(4), 3);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(1023), 10);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(1024), 11);
+  EXPECT_EQ(Metrics::Histogram::bucketOf(UINT64_MAX), 64);
+}
+
+TEST(TestMetrics, TestHistogram) {
+  Metrics metrics;
+  Metrics::Histogram &histogram = metrics.histogram("latency_us");
+  EXPECT_EQ(histogram.getCount(), 0);
+  EXPECT_EQ(histogram.getMin(), 0);
+  EXPECT_EQ(histogram.getMax(), 0);
+
+  histogram.record(5);
+  histogram.record(6);
+  histogram.record(100);
+  histogram.recordSeconds(0.002);
+  EXPECT_EQ(histogram.getCount(), 4);
+  EXPECT_EQ(histogram.getSum(), 2111);
+  EXPECT_EQ(histogram.getMin(), 5);
+  EXPECT_EQ(histogram.getMax(), 2000);
+  EXPECT_EQ(histogram.getBucketCount(3), 2);
+  EXPECT_EQ(histogram.getBucketCount(7), 1);
+  EXPECT_EQ(histogram.getBucketCount(11), 1);
+  EXPECT_EQ(&metrics.histogram("latency_us"), &histogram);
+}
+
+TEST(TestMetrics, TestToJson) {
+  Metrics metrics;
+  metrics.counter("b.events").add(3);
+  metrics.counter("a.events").add(2);
+  Metrics::Histogram &histogram = metrics.histogram("latency_us");
+  for (int i = 0; i < 10; i++) {
+    histogram.record(i < 9 ? 2 : 100);
+  }
+  metrics.histogram("empty_us");
+
+  std::string json = metrics.toJson();
+  // sorted by name
+  EXPECT_LT(json.find("\"a.events\": 2"), json.find("\"b.events\": 3"));
+  EXPECT_NE(json.find("\"empty_us\": {\"count\": 0, \"sum\": 0, \"min\": 0, "
+                      "\"max\": 0, \"mean\": 0, \"buckets\": {}}"),
+            std::string::npos);
+  EXPECT_NE(json.find("\"latency_us\": {\"count\": 10, \"sum\": 118, \"min\": "
+                      "2, \"max\": 100, \"mean\": 11.8, \"p50\": 3, \"p90\": "
+                      "3, \"p99\": 127, \"buckets\": {\"3\": 9, \"127\": 1}}"),
+            std::string::npos);
+}
+
+TEST(TestMetrics, TestSave) {
+  Metrics metrics;
+  metrics.counter("events").add();
+  std::string file_name = "../data/tests/test_metrics.json";
+  EXPECT_TRUE(metrics.save(file_name));
+  std::ifstream file(file_name);
+  std::stringstream content;
+  content << file.rdbuf();
+  EXPECT_EQ(content.str(), metrics.toJson());
+  std::remove(file_name.c_str());
+
+  EXPECT_FALSE(metrics.save("../data/no_such_directory/metrics.json"));
+}
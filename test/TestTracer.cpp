@@ -0,0 +1,97 @@
+#include "../include/tracer.h"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(TestTracer, TestDisabled) {
+  Tracer tracer = Tracer();
+  EXPECT_FALSE(tracer.isEnabled());
+  { Tracer::Span span(tracer, "phase", 0); }
+  EXPECT_EQ(tracer.getNumberSpans(), 0);
+  EXPECT_EQ(tracer.toJson(), "{\"traceEvents\": [\n], \"displayTimeUnit\": "
+                             "\"ms\", \"otherData\": {\"dropped_spans\": 0}}\n");
+}
+
+TEST(TestTracer, TestSpans) {
+  Tracer tracer = Tracer();
+  tracer.enable();
+  {
+    Tracer::Span outer(tracer, "outer", 3);
+    { Tracer::Span inner(tracer, "inner"); }
+  }
+  EXPECT_EQ(tracer.getNumberSpans(), 2);
+  std::string json = tracer.toJson();
+  // spans are recorded when they end
+  EXPECT_LT(json.find("\"name\": \"inner\", \"ph\": \"X\", \"pid\": 0, "
+                      "\"tid\": 0"),
+            json.find("\"name\": \"outer\", \"ph\": \"X\", \"pid\": 0, "
+                      "\"tid\": 0"));
+  EXPECT_NE(json.find("\"args\": {\"model\": 3}"), std::string::npos);
+  EXPECT_EQ(json.find("\"args\": {\"model\": -1}"), std::string::npos);
+
+  tracer.enable(false);
+  { Tracer::Span span(tracer, "ignored"); }
+  EXPECT_EQ(tracer.getNumberSpans(), 2);
+}
+
+TEST(TestTracer, TestRingBuffer) {
+  Tracer tracer = Tracer(3);
+  tracer.enable();
+  const char *names[] = {"s0", "s1", "s2", "s3", "s4"};
+  for (const char *name : names) {
+    Tracer::Span span(tracer, name);
+  }
+  EXPECT_EQ(tracer.getNumberSpans(), 3);
+  EXPECT_EQ(tracer.getNumberDropped(), 2);
+  std::string json = tracer.toJson();
+  // the oldest spans are overwritten, the others are kept in order
+  EXPECT_EQ(json.find("\"s1\""), std::string::npos);
+  EXPECT_LT(json.find("\"s2\""), json.find("\"s3\""));
+  EXPECT_LT(json.find("\"s3\""), json.find("\"s4\""));
+  EXPECT_NE(json.find("\"dropped_spans\": 2"), std::string::npos);
+
+  EXPECT_THROW(Tracer(0), std::invalid_argument);
+}
+
+TEST(TestTracer, TestThreads) {
+  Tracer tracer = Tracer();
+  tracer.enable();
+  // threads running at the same time get their own buffer
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&tracer, t]() {
+      for (int i = 0; i < 100; i++) {
+        Tracer::Span span(tracer, "phase", t);
+      }
+    }));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(tracer.getNumberSpans(), 400);
+  std::string json = tracer.toJson();
+  EXPECT_EQ(json.find("\"tid\": 4"), std::string::npos);
+
+  // the buffer of an exited thread is reused
+  std::thread([&tracer]() { Tracer::Span span(tracer, "phase"); }).join();
+  EXPECT_EQ(tracer.getNumberSpans(), 401);
+  EXPECT_EQ(tracer.toJson().find("\"tid\": 4"), std::string::npos);
+}
+
+TEST(TestTracer, TestSave) {
+  Tracer tracer = Tracer();
+  tracer.enable();
+  { Tracer::Span span(tracer, "phase"); }
+  std::string file_name = "../data/tests/test_trace.json";
+  EXPECT_TRUE(tracer.save(file_name));
+  std::ifstream file(file_name);
+  std::stringstream content;
+  content << file.rdbuf();
+  EXPECT_EQ(content.str(), tracer.toJson());
+  std::remove(file_name.c_str());
+}
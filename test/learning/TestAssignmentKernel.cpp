@@ -0,0 +1,137 @@
+#include "../../include/learning/AssignmentKernel.h"
+#include "../../include/types/AlternativesPerformance.h"
+#include "../../include/types/Criteria.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// random model and dataset, the expected categories of the dataset being the
+// assignments of the model
+void checkKernelAssignments(int n_cat, int n_crit,
+                            bool rank_encoding = false) {
+  MRSortModel model = MRSortModel(n_cat, n_crit);
+  model.profiles.changeMode("alt");
+  Criteria crits = Criteria(n_crit, "crit");
+  PerformanceTable pt = PerformanceTable(100, crits);
+  pt.generateRandomPerfValues(n_cat * 100 + n_crit);
+  AlternativesPerformance model_ap = model.categoryAssignments(pt);
+  std::unordered_map<std::string, Category> assignments =
+      model_ap.getAlternativesAssignments();
+  AlternativesPerformance ap = AlternativesPerformance(pt, assignments);
+
+  AssignmentKernel kernel = AssignmentKernel(ap, rank_encoding);
+  EXPECT_EQ(kernel.getCodeBits(), rank_encoding ? 16 : 0);
+  EXPECT_TRUE(kernel.isCompatible(model));
+  std::vector<int> ranks = kernel.assign(model);
+  std::vector<std::vector<Perf>> alts = ap.getPerformanceTable();
+  ASSERT_EQ(ranks.size(), alts.size());
+  for (int a = 0; a < alts.size(); a++) {
+    EXPECT_EQ(ranks[a], assignments[alts[a][0].name_].rank_);
+  }
+  EXPECT_FLOAT_EQ(kernel.computeAccuracy(model), 1);
+
+  // an other model gives the same accuracy as the generic assignment
+  MRSortModel other = MRSortModel(n_cat, n_crit);
+  other.profiles.changeMode("alt");
+  std::unordered_map<std::string, Category> other_assignments =
+      other.categoryAssignments(pt).getAlternativesAssignments();
+  int acc = 0;
+  for (std::pair<const std::string, Category> &e : other_assignments) {
+    if (e.second.rank_ == assignments[e.first].rank_) {
+      acc++;
+    }
+  }
+  EXPECT_FLOAT_EQ(kernel.computeAccuracy(other), acc / 100.);
+}
+
+TEST(TestAssignmentKernel, TestSpecializedSizes) {
+  EXPECT_TRUE(AssignmentKernel::isSpecialized(4, 2));
+  EXPECT_TRUE(AssignmentKernel::isSpecialized(16, 5));
+  EXPECT_FALSE(AssignmentKernel::isSpecialized(3, 2));
+  EXPECT_FALSE(AssignmentKernel::isSpecialized(8, 6));
+  checkKernelAssignments(2, 4);
+  checkKernelAssignments(3, 7);
+  checkKernelAssignments(5, 16);
+}
+
+TEST(TestAssignmentKernel, TestGenericSizes) {
+  checkKernelAssignments(2, 2);
+  checkKernelAssignments(6, 5);
+  checkKernelAssignments(3, 20);
+}
+
+TEST(TestAssignmentKernel, TestRankEncoding) {
+  checkKernelAssignments(2, 4, true);
+  checkKernelAssignments(5, 16, true);
+  checkKernelAssignments(3, 20, true);
+}
+
+TEST(TestAssignmentKernel, TestRankEncodingTies) {
+  // profiles equal to performances of the dataset, alternatives sharing values
+  Criteria crits = Criteria(4, "crit");
+  crits.setWeights(std::vector<float>{0.25, 0.25, 0.25, 0.25});
+  std::vector<float> prof0 = {0.2, 0.2, 0.4, 0.4};
+  std::vector<float> prof1 = {0.6, 0.6, 0.8, 0.8};
+  std::vector<std::vector<Perf>> prof_vect;
+  prof_vect.push_back(createVectorPerf("prof0", crits, prof0));
+  prof_vect.push_back(createVectorPerf("prof1", crits, prof1));
+  Profiles profiles = Profiles(prof_vect, "alt");
+  Categories categories = Categories(3);
+  MRSortModel model = MRSortModel(crits, profiles, categories, 0.5);
+
+  std::vector<std::vector<float>> values = {{0.2, 0.2, 0.4, 0.4},
+                                            {0.4, 0.4, 0.4, 0.2},
+                                            {0.6, 0.8, 0.8, 0.4},
+                                            {0.8, 0.8, 0.4, 0.2},
+                                            {1, 1, 1, 1}};
+  std::vector<std::vector<Perf>> alt_vect;
+  for (int a = 0; a < values.size(); a++) {
+    alt_vect.push_back(
+        createVectorPerf("a" + std::to_string(a), crits, values[a]));
+  }
+  PerformanceTable pt = PerformanceTable(alt_vect);
+  std::unordered_map<std::string, Category> assignments =
+      model.categoryAssignments(pt).getAlternativesAssignments();
+  AlternativesPerformance ap = AlternativesPerformance(pt, assignments);
+
+  AssignmentKernel kernel = AssignmentKernel(ap, true);
+  std::vector<int> expected = {0, 1, 1, 2, 2};
+  EXPECT_EQ(kernel.assign(model), expected);
+  EXPECT_EQ(kernel.assign(model), AssignmentKernel(ap).assign(model));
+  EXPECT_FLOAT_EQ(kernel.computeAccuracy(model), 1);
+}
+
+TEST(TestAssignmentKernel, TestIncompatibleModel) {
+  Criteria crits = Criteria(4, "crit");
+  PerformanceTable pt = PerformanceTable(10, crits);
+  AlternativesPerformance ap = AlternativesPerformance(pt);
+  AssignmentKernel kernel = AssignmentKernel(ap);
+
+  MRSortModel model = MRSortModel(3, 5);
+  model.profiles.changeMode("alt");
+  EXPECT_FALSE(kernel.isCompatible(model));
+  EXPECT_THROW(kernel.assign(model), std::invalid_argument);
+
+  // profiles must be in alt mode
+  MRSortModel crit_model = MRSortModel(3, 4);
+  crit_model.profiles.changeMode("crit");
+  EXPECT_FALSE(kernel.isCompatible(crit_model));
+}
+
+TEST(TestAssignmentKernel, TestDoesNotCopyDataset) {
+  Criteria crits = Criteria(4, "crit");
+  PerformanceTable pt = PerformanceTable(10, crits);
+  AlternativesPerformance ap = AlternativesPerformance(pt);
+
+  long n_copies = AlternativesPerformance::getNumberCopies();
+  AssignmentKernel kernel = AssignmentKernel(ap, true);
+  EXPECT_EQ(AlternativesPerformance::getNumberCopies() - n_copies, 0);
+
+  // a dataset in crit mode is copied once to read it by alternative
+  ap.changeMode("crit");
+  n_copies = AlternativesPerformance::getNumberCopies();
+  AssignmentKernel crit_kernel = AssignmentKernel(ap);
+  EXPECT_EQ(AlternativesPerformance::getNumberCopies() - n_copies, 1);
+}
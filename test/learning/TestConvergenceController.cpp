@@ -0,0 +1,110 @@
+#include "../../include/config.h"
+#include "../../include/learning/ConvergenceController.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+#include <chrono>
+#include <thread>
+#include <utility>
+
+Config getConvergenceTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  return conf;
+}
+
+std::vector<MRSortModel> getConvergenceTestModels(int n_models) {
+  std::vector<MRSortModel> models;
+  for (int k = 0; k < n_models; k++) {
+    models.push_back(MRSortModel(2, 3, "model" + std::to_string(k)));
+  }
+  return models;
+}
+
+TEST(TestConvergenceController, TestTargetAccuracy) {
+  Config conf = getConvergenceTestConf();
+  conf.target_accuracy = 0.9;
+  ConvergenceController cc = ConvergenceController(conf);
+  std::vector<MRSortModel> models = getConvergenceTestModels(4);
+
+  EXPECT_FALSE(cc.update(models, 0.5));
+  EXPECT_FALSE(cc.update(models, 0.89));
+  EXPECT_TRUE(cc.update(models, 0.9));
+  EXPECT_NE(cc.getStopReason(), "");
+}
+
+TEST(TestConvergenceController, TestTargetAccuracyDisabled) {
+  Config conf = getConvergenceTestConf();
+  conf.target_accuracy = 0;
+  ConvergenceController cc = ConvergenceController(conf);
+  std::vector<MRSortModel> models = getConvergenceTestModels(4);
+
+  EXPECT_FALSE(cc.update(models, 0));
+  EXPECT_FALSE(cc.update(models, 0.5));
+  EXPECT_FALSE(cc.update(models, 1));
+  EXPECT_EQ(cc.getStopReason(), "");
+}
+
+TEST(TestConvergenceController, TestStaleIterations) {
+  Config conf = getConvergenceTestConf();
+  conf.max_stale_iterations = 2;
+  ConvergenceController cc = ConvergenceController(conf);
+  std::vector<MRSortModel> models = getConvergenceTestModels(4);
+
+  EXPECT_FALSE(cc.update(models, 0.5));
+  EXPECT_FALSE(cc.update(models, 0.5));
+  EXPECT_EQ(cc.getStaleIterations(), 1);
+  // improvement resets the counter
+  EXPECT_FALSE(cc.update(models, 0.6));
+  EXPECT_EQ(cc.getStaleIterations(), 0);
+  EXPECT_FALSE(cc.update(models, 0.6));
+  EXPECT_TRUE(cc.update(models, 0.6));
+  EXPECT_EQ(cc.getStaleIterations(), 2);
+
+  // start resets the state
+  cc.start();
+  EXPECT_EQ(cc.getStaleIterations(), 0);
+  EXPECT_EQ(cc.getStopReason(), "");
+}
+
+TEST(TestConvergenceController, TestTimeBudget) {
+  Config conf = getConvergenceTestConf();
+  ConvergenceController cc = ConvergenceController(conf);
+  std::vector<MRSortModel> models = getConvergenceTestModels(4);
+  // no budget by default
+  EXPECT_FALSE(cc.isTimeBudgetExhausted());
+
+  conf.time_budget_seconds = 0.01;
+  cc.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_TRUE(cc.isTimeBudgetExhausted());
+  EXPECT_TRUE(cc.update(models, 0.5));
+}
+
+TEST(TestConvergenceController, TestDiversity) {
+  Config conf = getConvergenceTestConf();
+  ConvergenceController cc = ConvergenceController(conf);
+  std::vector<MRSortModel> models = getConvergenceTestModels(4);
+  std::vector<float> weights = {0.2, 0.3, 0.5};
+  for (MRSortModel &model : models) {
+    model.criteria.setWeights(weights);
+    model.lambda = 0.6;
+  }
+  EXPECT_FLOAT_EQ(cc.computeDiversity(models, 4), 0);
+
+  std::vector<float> other_weights = {0.5, 0.3, 0.2};
+  models[1].criteria.setWeights(other_weights);
+  // centroid of the 2 first models: {0.35, 0.3, 0.35, 0.6}
+  EXPECT_FLOAT_EQ(cc.computeDiversity(models, 2), 0.3);
+
+  // the 2 first models are the kept half of the population
+  conf.min_diversity = 0.5;
+  EXPECT_TRUE(cc.update(models, 0.5));
+  conf.min_diversity = 0.1;
+  EXPECT_FALSE(cc.update(models, 0.5));
+}
@@ -0,0 +1,133 @@
+#include "../../include/config.h"
+#include "../../include/learning/Coordinator.h"
+#include "../../include/learning/HeuristicPipeline.h"
+#include "../../include/learning/RemoteMailbox.h"
+#include "../../include/utils.h"
+#include "gtest/gtest.h"
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <utility>
+
+Config getCoordinatorTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  conf.model_batch_size = 4;
+  conf.max_iterations = 10;
+  conf.migration_interval = 1;
+  conf.n_migrants = 1;
+  conf.n_workers = 2;
+  conf.coordinator_socket =
+      "/tmp/fastpl-test-" + std::to_string(getpid()) + ".sock";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  return conf;
+}
+
+AlternativesPerformance getCoordinatorTestDataset() {
+  Criteria criteria = Criteria(3);
+  Categories categories = Categories(2);
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  return AlternativesPerformance(perf_vect, truth);
+}
+
+TEST(TestCoordinator, TestWrongNumberWorkers) {
+  Config conf = getCoordinatorTestConf();
+  conf.n_workers = 0;
+  EXPECT_THROW(Coordinator coordinator(conf), std::invalid_argument);
+}
+
+TEST(TestCoordinator, TestRingAndStop) {
+  Config conf = getCoordinatorTestConf();
+  Coordinator coordinator(conf);
+  MRSortModel best = MRSortModel(2, 3);
+  std::thread server([&coordinator, &best]() { best = coordinator.serve(); });
+
+  std::atomic<bool> stop0(false);
+  std::atomic<bool> stop1(false);
+  RemoteMailbox worker0(conf, &stop0);
+  RemoteMailbox worker1(conf, &stop1);
+  EXPECT_EQ(worker0.getWorkerId(), 0);
+  EXPECT_EQ(worker1.getWorkerId(), 1);
+  EXPECT_EQ(worker1.getNumberWorkers(), 2);
+
+  // migrants of worker 0 go to worker 1 only, and once
+  std::vector<MRSortModel> migrants;
+  migrants.push_back(MRSortModel(2, 3, "migrant"));
+  worker0.post(migrants);
+  EXPECT_TRUE(worker0.collect().empty());
+  std::vector<MRSortModel> arrivals = worker1.collect();
+  ASSERT_EQ(arrivals.size(), 1);
+  EXPECT_EQ(arrivals[0].getId(), "migrant");
+  EXPECT_TRUE(worker1.collect().empty());
+
+  // worker 1 reaches the target accuracy, worker 0 is stopped
+  MRSortModel model1 = MRSortModel(2, 3, "model1");
+  model1.setScore(1);
+  worker1.done(model1);
+  EXPECT_TRUE(worker0.collect().empty());
+  EXPECT_TRUE(stop0.load());
+  MRSortModel model0 = MRSortModel(2, 3, "model0");
+  model0.setScore(0.5);
+  worker0.done(model0);
+
+  server.join();
+  EXPECT_EQ(best.getId(), "model1");
+  EXPECT_EQ(best.getScore(), 1);
+}
+
+TEST(TestCoordinator, TestWorkerProcesses) {
+  Config conf = getCoordinatorTestConf();
+  Coordinator coordinator(conf);
+
+  // the workers are launched once the coordinator listens
+  std::vector<pid_t> workers;
+  for (int k = 0; k < conf.n_workers; k++) {
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+      int status = 0;
+      try {
+        AlternativesPerformance ap = getCoordinatorTestDataset();
+        std::atomic<bool> stop(false);
+        RemoteMailbox mailbox = RemoteMailbox(conf, &stop);
+        HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+        hp.setIsland(mailbox.getWorkerId(), &mailbox, &mailbox, &stop);
+        mailbox.done(hp.start());
+      } catch (...) {
+        status = 1;
+      }
+      // leave without running the remaining tests in the child
+      _exit(status);
+    }
+    workers.push_back(pid);
+  }
+
+  MRSortModel best = coordinator.serve();
+  for (pid_t pid : workers) {
+    int status;
+    waitpid(pid, &status, 0);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+  }
+  EXPECT_GE(best.getScore(), 0);
+  EXPECT_LE(best.getScore(), 1);
+}
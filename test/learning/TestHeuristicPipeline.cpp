@@ -1,6 +1,7 @@
 #include "../../include/config.h"
 #include "../../include/learning/HeuristicPipeline.h"
 #include "gtest/gtest.h"
+#include <random>
 #include <sstream>
 #include <utility>
 
@@ -187,4 +188,251 @@ TEST(TestHeuristicPipeline, TestPipeline) {
   hp.start();
 
   EXPECT_EQ(hp.models[0].getScore(), 1);
-}
\ No newline at end of file
+}
+
+TEST(TestHeuristicPipeline, TestPipelineTargetAccuracyDisabled) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(0);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  conf.target_accuracy = 0;
+  conf.max_iterations = 3;
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  hp.start();
+
+  // the run is not stopped by the disabled target
+  EXPECT_EQ(conf.metrics->counter("pipeline.iterations").get(),
+            conf.max_iterations);
+}
+
+TEST(TestHeuristicPipeline, TestWrongNumberThreads) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  conf.n_threads = 0;
+  EXPECT_THROW(HeuristicPipeline hp(conf, ap), std::invalid_argument);
+}
+
+TEST(TestHeuristicPipeline, TestPipelineMultiThreads) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  conf.n_threads = 3;
+
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  MRSortModel best_model = hp.start();
+
+  EXPECT_EQ(hp.models.size(), conf.model_batch_size);
+  EXPECT_EQ(best_model.getScore(), 1);
+}
+
+TEST(TestHeuristicPipeline, TestPipelineSampledLP) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  // the weights are learned on 2 alternatives of cat1 and the one of cat0,
+  // the best model is polished on the 4 of them
+  conf.lp_sample_size = 2;
+  conf.lp_sample_focus = 0.5;
+
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  MRSortModel best_model = hp.start();
+
+  // the polished model is only kept if it does not lower the accuracy
+  EXPECT_GE(best_model.getScore(), hp.models[0].getScore());
+  float sum = 0;
+  for (int i = 0; i < 3; i++) {
+    sum += best_model.criteria[i].getWeight();
+  }
+  EXPECT_NEAR(sum, 1, 1e-5);
+}
+
+TEST(TestHeuristicPipeline, TestPipelineMetrics) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  conf.n_threads = 2;
+  conf.n_profile_update = 3;
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  hp.start();
+
+  Metrics &metrics = *conf.metrics;
+  std::uint64_t n_iterations = metrics.counter("pipeline.iterations").get();
+  EXPECT_GE(n_iterations, 1);
+  EXPECT_LE(n_iterations, conf.max_iterations);
+  // every model is initialized at the first iteration, then the worst half
+  EXPECT_EQ(metrics.counter("pipeline.models_reinitialized").get(),
+            5 + 3 * (n_iterations - 1));
+  EXPECT_EQ(metrics.histogram("pipeline.init_us").getCount(),
+            5 + 3 * (n_iterations - 1));
+
+  // one weight update and n_profile_update profile updates per model
+  std::uint64_t n_updates = 5 * n_iterations;
+  EXPECT_EQ(metrics.histogram("pipeline.weight_update_us").getCount(),
+            n_updates);
+  EXPECT_EQ(metrics.histogram("lp.solve_us").getCount(), n_updates);
+  EXPECT_EQ(metrics.histogram("lp.rows").getCount(), n_updates);
+  EXPECT_EQ(metrics.histogram("pipeline.profile_update_us").getCount(),
+            3 * n_updates);
+  EXPECT_GE(metrics.histogram("pipeline.accuracy_us").getCount(),
+            5 * n_updates);
+  EXPECT_LE(metrics.counter("profile_update.moves_accepted").get(),
+            metrics.counter("profile_update.moves_proposed").get());
+}
+
+TEST(TestHeuristicPipeline, TestPipelineTrace) {
+  Criteria criteria = getHeuristicTestCriteria();
+  Categories categories = getHeuristicTestCategories();
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  Config conf = getHeuristicTestConf();
+  conf.n_threads = 2;
+  conf.max_iterations = 2;
+  conf.tracer->enable();
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  hp.start();
+
+  std::string json = conf.tracer->toJson();
+  for (std::string name :
+       {"initializeProfiles", "updateWeightsAndLambda", "LPSolver::solve",
+        "updateProfiles", "computeAccuracy", "orderModels"}) {
+    EXPECT_NE(json.find("\"name\": \"" + name + "\""), std::string::npos);
+  }
+  EXPECT_NE(json.find("\"args\": {\"model\": 4}"), std::string::npos);
+  EXPECT_EQ(conf.tracer->getNumberDropped(), 0);
+}
+
+TEST(TestHeuristicPipeline, TestPipelineDoesNotCopyDataset) {
+  int n_alt = 200;
+  int n_crit = 5;
+  std::vector<Criterion> crit_vect;
+  for (int j = 0; j < n_crit; j++) {
+    crit_vect.push_back(Criterion("crit" + std::to_string(j), -1, 0.2));
+  }
+  Criteria criteria = Criteria(crit_vect);
+  Categories categories = Categories(3);
+
+  std::vector<std::vector<Perf>> perf_vect;
+  std::unordered_map<std::string, Category> truth;
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<float> distribution(0, 1);
+  for (int i = 0; i < n_alt; i++) {
+    std::vector<float> values;
+    float sum = 0;
+    for (int j = 0; j < n_crit; j++) {
+      values.push_back(distribution(gen));
+      sum += values.back();
+    }
+    std::string name = "alt" + std::to_string(i);
+    perf_vect.push_back(createVectorPerf(name, criteria, values));
+    int rank = sum < 2.3 ? 0 : sum < 2.7 ? 1 : 2;
+    truth[name] = categories.getCategoryOfRank(rank);
+  }
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, truth);
+
+  // the only copies are the assignment tables of the profile updates, made by
+  // the first update of each thread and reused by the later iterations
+  for (int n_threads : {1, 2}) {
+    for (int max_iterations : {1, 3}) {
+      Config conf = getHeuristicTestConf();
+      conf.n_threads = n_threads;
+      conf.max_iterations = max_iterations;
+      long n_copies = AlternativesPerformance::getNumberCopies();
+      HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+      hp.start();
+      long copies = AlternativesPerformance::getNumberCopies() - n_copies;
+      EXPECT_GE(copies, 1);
+      EXPECT_LE(copies, n_threads);
+      if (n_threads == 1) {
+        EXPECT_EQ(copies, 1);
+      }
+    }
+  }
+}
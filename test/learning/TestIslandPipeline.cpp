@@ -0,0 +1,127 @@
+#include "../../include/config.h"
+#include "../../include/learning/IslandPipeline.h"
+#include "../../include/utils.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <utility>
+
+Config getIslandTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  conf.model_batch_size = 4;
+  conf.max_iterations = 10;
+  conf.n_islands = 3;
+  conf.migration_interval = 1;
+  conf.n_migrants = 1;
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  return conf;
+}
+
+AlternativesPerformance getIslandTestDataset() {
+  Criteria criteria = Criteria(3);
+  Categories categories = Categories(2);
+  std::vector<std::vector<Perf>> perf_vect;
+  std::vector<float> alt0 = {0.9, 0.6, 0.5};
+  std::vector<float> alt1 = {0.9, 0.05, 0.35};
+  std::vector<float> alt2 = {0.7, 1, 0.5};
+  std::vector<float> alt3 = {0.5, 0, 0.6};
+  perf_vect.push_back(createVectorPerf("alt0", criteria, alt0));
+  perf_vect.push_back(createVectorPerf("alt1", criteria, alt1));
+  perf_vect.push_back(createVectorPerf("alt2", criteria, alt2));
+  perf_vect.push_back(createVectorPerf("alt3", criteria, alt3));
+
+  std::unordered_map<std::string, Category> truth;
+  truth["alt0"] = categories.getCategoryOfRank(1);
+  truth["alt1"] = categories.getCategoryOfRank(1);
+  truth["alt2"] = categories.getCategoryOfRank(1);
+  truth["alt3"] = categories.getCategoryOfRank(0);
+  return AlternativesPerformance(perf_vect, truth);
+}
+
+TEST(TestIslandPipeline, TestMigrate) {
+  Config conf = getIslandTestConf();
+  AlternativesPerformance ap = getIslandTestDataset();
+  MigrationMailbox inbox;
+  MigrationMailbox outbox;
+  std::atomic<bool> stop(false);
+  HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+  hp.setIsland(0, &inbox, &outbox, &stop);
+  for (int k = 0; k < 4; k++) {
+    hp.models.push_back(MRSortModel(2, 3, "model" + std::to_string(k)));
+    hp.models[k].setScore(0.8 - 0.2 * k);
+  }
+  std::vector<MRSortModel> arrivals;
+  arrivals.push_back(MRSortModel(2, 3, "migrant"));
+  arrivals[0].setScore(0.7);
+  inbox.post(arrivals);
+
+  hp.migrate();
+  // the best model is sent
+  std::vector<MRSortModel> sent = outbox.collect();
+  EXPECT_EQ(sent.size(), 1);
+  EXPECT_EQ(sent[0].getId(), "model0");
+  // the migrant replaced the worst kept model and the models are sorted
+  EXPECT_EQ(hp.models.size(), 4);
+  EXPECT_EQ(hp.models[0].getId(), "model0");
+  EXPECT_EQ(hp.models[1].getId(), "migrant");
+  EXPECT_EQ(hp.models[2].getId(), "model2");
+  EXPECT_EQ(hp.models[3].getId(), "model3");
+}
+
+TEST(TestIslandPipeline, TestWrongNumberIslands) {
+  Config conf = getIslandTestConf();
+  conf.n_islands = 0;
+  AlternativesPerformance ap = getIslandTestDataset();
+  try {
+    IslandPipeline ip = IslandPipeline(conf, ap);
+    FAIL() << "should have thrown invalid argument.";
+  } catch (std::invalid_argument const &err) {
+    EXPECT_EQ(err.what(), std::string("The number of islands must be >= 1"));
+  } catch (...) {
+    FAIL() << "should have thrown invalid argument.";
+  }
+}
+
+TEST(TestIslandPipeline, TestWrongMigrationParameters) {
+  Config conf = getIslandTestConf();
+  AlternativesPerformance ap = getIslandTestDataset();
+  conf.migration_interval = 0;
+  try {
+    IslandPipeline ip = IslandPipeline(conf, ap);
+    FAIL() << "should have thrown invalid argument.";
+  } catch (std::invalid_argument const &err) {
+    EXPECT_EQ(err.what(), std::string("The migration interval must be >= 1"));
+  } catch (...) {
+    FAIL() << "should have thrown invalid argument.";
+  }
+
+  conf.migration_interval = 1;
+  conf.n_migrants = -1;
+  try {
+    HeuristicPipeline hp = HeuristicPipeline(conf, ap);
+    FAIL() << "should have thrown invalid argument.";
+  } catch (std::invalid_argument const &err) {
+    EXPECT_EQ(err.what(), std::string("The number of migrants must be >= 0"));
+  } catch (...) {
+    FAIL() << "should have thrown invalid argument.";
+  }
+}
+
+// Accuracy might change after changing algorithms
+TEST(TestIslandPipeline, TestPipeline) {
+  Config conf = getIslandTestConf();
+  AlternativesPerformance ap = getIslandTestDataset();
+  IslandPipeline ip = IslandPipeline(conf, ap);
+  EXPECT_EQ(ip.getNumberIslands(), 3);
+
+  MRSortModel best = ip.start();
+  EXPECT_EQ(best.getScore(), 1);
+  for (int k = 0; k < ip.getNumberIslands(); k++) {
+    EXPECT_EQ(ip.getIsland(k).models.size(), conf.model_batch_size);
+  }
+}
@@ -0,0 +1,101 @@
+#include "../../include/config.h"
+#include "../../include/learning/LPSolverPool.h"
+#include "../../include/learning/WeightUpdater.h"
+#include "../../include/types/AlternativesPerformance.h"
+#include "../../include/types/Criteria.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+Config getPoolTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  spdlog::set_level(spdlog::level::debug);
+  return conf;
+}
+
+TEST(TestLPSolverPool, TestReuseSolver) {
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  Config conf = getPoolTestConf();
+  LPSolverPool pool = LPSolverPool(ap, conf);
+  EXPECT_EQ(pool.getNumberSolvers(), 0);
+
+  LPSolver *first;
+  {
+    LPSolverPool::Lease lease = pool.acquire();
+    first = lease.get();
+  }
+  LPSolverPool::Lease lease = pool.acquire();
+  EXPECT_EQ(lease.get(), first);
+  EXPECT_EQ(pool.getNumberSolvers(), 1);
+}
+
+TEST(TestLPSolverPool, TestConcurrentLeases) {
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  Config conf = getPoolTestConf();
+  LPSolverPool pool = LPSolverPool(ap, conf);
+
+  LPSolverPool::Lease lease0 = pool.acquire();
+  LPSolverPool::Lease lease1 = pool.acquire();
+  EXPECT_NE(lease0.get(), lease1.get());
+  EXPECT_EQ(pool.getNumberSolvers(), 2);
+}
+
+TEST(TestLPSolverPool, TestSharedWeightUpdater) {
+  std::vector<std::vector<Perf>> perf_vect;
+  Criteria crits = Criteria(2, "crit");
+  std::vector<float> vec0 = {0.8, 0.6};
+  std::vector<float> vec1 = {1, 0.5};
+  std::vector<float> vec2 = {0.2, 0.4};
+  perf_vect.push_back(createVectorPerf("a0", crits, vec0));
+  perf_vect.push_back(createVectorPerf("a1", crits, vec1));
+  perf_vect.push_back(createVectorPerf("a2", crits, vec2));
+  std::unordered_map<std::string, Category> map{{"a0", Category("cat1", 1)},
+                                                {"a1", Category("cat1", 1)},
+                                                {"a2", Category("cat0", 0)}};
+  AlternativesPerformance ap = AlternativesPerformance(perf_vect, map);
+
+  std::vector<float> prof0 = {0.3, 0.4};
+  std::vector<float> prof1 = {0.7, 0.5};
+  std::vector<std::vector<Perf>> prof_vect;
+  prof_vect.push_back(createVectorPerf("cat0", crits, prof0));
+  prof_vect.push_back(createVectorPerf("cat1", crits, prof1));
+  Profiles profs = Profiles(prof_vect, "alt");
+  Categories cats = Categories(std::vector<std::string>{"cat0", "cat1", "cat2"});
+  MRSortModel model = MRSortModel(crits, profs, cats, 0.6);
+
+  Config conf = getPoolTestConf();
+  conf.lp_solver = "SIMPLEX";
+  WeightUpdater wu = WeightUpdater(ap, conf);
+  MRSortModel expected = model;
+  wu.updateWeightsAndLambda(expected);
+
+  // the threads update their models through the same weight updater
+  std::vector<MRSortModel> models(4, model);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.push_back(std::thread([&wu, &models, t]() {
+      for (int i = 0; i < 5; i++) {
+        wu.updateWeightsAndLambda(models[t]);
+      }
+    }));
+  }
+  for (std::thread &t : threads) {
+    t.join();
+  }
+  for (MRSortModel &m : models) {
+    EXPECT_EQ(m.lambda, expected.lambda);
+    EXPECT_EQ(m.criteria[0].getWeight(), expected.criteria[0].getWeight());
+    EXPECT_EQ(m.criteria[1].getWeight(), expected.criteria[1].getWeight());
+  }
+}
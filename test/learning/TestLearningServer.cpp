@@ -0,0 +1,178 @@
+#include "../../include/config.h"
+#include "../../include/learning/LearningServer.h"
+#include "../../include/learning/WorkerProtocol.h"
+#include "gtest/gtest.h"
+#include <cstring>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+Config getLearningServerTestConf() {
+  Config conf = getTestConf();
+  conf.save_metrics = false;
+  conf.n_jobs = 2;
+  conf.server_socket =
+      "/tmp/fastpl-test-server-" + std::to_string(getpid()) + ".sock";
+  return conf;
+}
+
+int connectLearningServer(Config &conf) {
+  sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  std::strcpy(addr.sun_path, conf.server_socket.c_str());
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (::connect(fd, (sockaddr *)&addr, sizeof(addr)) < 0) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+MessageType requestLearningServer(int fd, MessageType type,
+                                  const std::string &request,
+                                  std::string &answer) {
+  sendMessage(fd, type, request);
+  return receiveMessage(fd, answer);
+}
+
+TEST(TestLearningServer, TestWrongNumberJobs) {
+  Config conf = getLearningServerTestConf();
+  conf.n_jobs = 0;
+  EXPECT_THROW(LearningServer server(conf), std::invalid_argument);
+}
+
+TEST(TestLearningServer, TestRequests) {
+  Config conf = getLearningServerTestConf();
+  LearningServer server(conf);
+  std::thread serving([&server]() { server.serve(); });
+  int fd = connectLearningServer(conf);
+  ASSERT_GE(fd, 0);
+
+  std::string answer;
+  std::string learn_request = "dataset: in1dataset.xml\n"
+                              "output: test_server_model.xml\n"
+                              "model_batch_size: 4\n"
+                              "max_iterations: 2\n";
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Learn, learn_request,
+                                  answer),
+            MessageType::Model);
+  EXPECT_NE(answer.find("<model>"), std::string::npos);
+  // learning again with other parameters does not parse the dataset again
+  learn_request += "n_profile_update: 2\n";
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Learn, learn_request,
+                                  answer),
+            MessageType::Model);
+  EXPECT_EQ(server.getNumberLoads(), 1);
+
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Predict,
+                                  "model: test_server_model.xml\n"
+                                  "dataset: in1dataset.xml\n",
+                                  answer),
+            MessageType::Assignments);
+  std::istringstream assignments(answer);
+  std::string alt, cat;
+  int n_alt = 0;
+  while (assignments >> alt >> cat) {
+    n_alt++;
+  }
+  EXPECT_GT(n_alt, 0);
+
+  // a failed request does not close the connection
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Predict,
+                                  "model: no_model.xml\n"
+                                  "dataset: in1dataset.xml\n",
+                                  answer),
+            MessageType::Error);
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Learn,
+                                  "dataset: in1dataset.xml\n", answer),
+            MessageType::Error);
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Learn,
+                                  "dataset: no_dataset.xml\n"
+                                  "output: test_server_model.xml\n",
+                                  answer),
+            MessageType::Error);
+
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Shutdown, "", answer),
+            MessageType::Ack);
+  serving.join();
+  ::close(fd);
+  std::remove((conf.data_dir + "test_server_model.xml").c_str());
+}
+
+TEST(TestLearningServer, TestRejectedRequests) {
+  Config conf = getLearningServerTestConf();
+  LearningServer server(conf);
+  struct stat st;
+  ASSERT_EQ(::stat(conf.server_socket.c_str(), &st), 0);
+  EXPECT_EQ(st.st_mode & 0777, 0600);
+  std::thread serving([&server]() { server.serve(); });
+  int fd = connectLearningServer(conf);
+  ASSERT_GE(fd, 0);
+
+  std::string answer;
+  std::string dataset = "dataset: in1dataset.xml\n";
+  std::string output = "output: test_server_model.xml\n";
+  std::vector<std::string> requests = {
+      dataset + output + "data_dir: /tmp/\n",
+      dataset + output + "n_jobs: 4\n",
+      dataset + output + "server_socket: /tmp/other.sock\n",
+      dataset + "output: ../test_server_model.xml\n",
+      dataset + "output: /tmp/test_server_model.xml\n",
+      "dataset: /etc/hosts\n" + output,
+      dataset + output + "lp_dump: ../../lp.mps\n",
+      dataset + output + "n_threads: 1000\n",
+      dataset + output + "n_islands: 1000\n"};
+  for (const std::string &request : requests) {
+    EXPECT_EQ(requestLearningServer(fd, MessageType::Learn, request, answer),
+              MessageType::Error)
+        << request;
+  }
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Predict,
+                                  "model: test_server_model.xml\n"
+                                  "dataset: ../tests/in1dataset.xml\n",
+                                  answer),
+            MessageType::Error);
+  EXPECT_EQ(server.getNumberLoads(), 0);
+
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Shutdown, "", answer),
+            MessageType::Ack);
+  serving.join();
+  ::close(fd);
+}
+
+TEST(TestLearningServer, TestIdleClientDoesNotHoldThread) {
+  Config conf = getLearningServerTestConf();
+  conf.n_jobs = 1;
+  LearningServer server(conf);
+  std::thread serving([&server]() { server.serve(); });
+  // connected first but sends nothing
+  int idle_fd = connectLearningServer(conf);
+  ASSERT_GE(idle_fd, 0);
+  int fd = connectLearningServer(conf);
+  ASSERT_GE(fd, 0);
+
+  std::string answer;
+  std::string predict_request = "model: no_model.xml\n"
+                                "dataset: in1dataset.xml\n";
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Predict, predict_request,
+                                  answer),
+            MessageType::Error);
+  EXPECT_EQ(requestLearningServer(idle_fd, MessageType::Predict,
+                                  predict_request, answer),
+            MessageType::Error);
+  // the connection is still served after its first request
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Predict, predict_request,
+                                  answer),
+            MessageType::Error);
+
+  EXPECT_EQ(requestLearningServer(fd, MessageType::Shutdown, "", answer),
+            MessageType::Ack);
+  serving.join();
+  ::close(idle_fd);
+  ::close(fd);
+}
@@ -1,9 +1,13 @@
+#include "../../benchmark/PairedRowsSolver.h"
 #include "../../include/config.h"
 #include "../../include/learning/LinearSolver.h"
 #include "../../include/types/AlternativesPerformance.h"
 #include "../../include/types/Criteria.h"
 #include "ortools/linear_solver/linear_solver.h"
 #include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <memory>
 #include <sstream>
 #include <utility>
 
@@ -23,6 +27,7 @@ Config getSolverTestConf() {
 TEST(TestLinearSolver, TestInitializeSolver) {
   Criteria crits = Criteria(2);
   Config conf;
+  conf.reduce_lp = false;
   AlternativesPerformance ap = AlternativesPerformance(4, crits);
   LinearSolver ls = LinearSolver(ap, conf);
   ls.initializeSolver();
@@ -30,8 +35,8 @@ TEST(TestLinearSolver, TestInitializeSolver) {
   operations_research::MPSolver *solver = ls.getSolver();
   // 1 (lambda) + 2 (weights) + 4 * 4 (xp, x, yp, y)
   EXPECT_EQ(solver->NumVariables(), 19);
-  // sum of weight = 1 : two ineauqlities
-  EXPECT_EQ(solver->NumConstraints(), 2);
+  // sum of weight = 1 : a single equality row
+  EXPECT_EQ(solver->NumConstraints(), 1);
 }
 
 TEST(TestLinearSolver, TestUpdateConstraints) {
@@ -50,13 +55,15 @@ TEST(TestLinearSolver, TestUpdateConstraints) {
       {{false, true, true}, {}, {true, false, true}}};
   Criteria crits = Criteria(3);
   Config conf;
+  conf.reduce_lp = false;
   AlternativesPerformance ap = AlternativesPerformance(3, crits);
   LinearSolver ls = LinearSolver(ap, conf);
 
   ls.updateConstraints(matrix_x, matrix_y);
 
   operations_research::MPSolver *solver = ls.getSolver();
-  EXPECT_EQ(solver->NumConstraints(), 14);
+  // 1 (sum of weights) + 3 (x rows) + 3 (y rows)
+  EXPECT_EQ(solver->NumConstraints(), 7);
   auto weights = ls.getWeights();
   auto x_ap = ls.getXap();
   auto y_ap = ls.getYap();
@@ -64,76 +71,60 @@ TEST(TestLinearSolver, TestUpdateConstraints) {
   auto y_a = ls.getYa();
   auto csts = solver->constraints();
 
-  // sum_weights_m : - w0 - w1 - w2
-  auto sum_weights_m = csts[0];
-  EXPECT_EQ(sum_weights_m->GetCoefficient(weights[0]), -1);
-  EXPECT_EQ(sum_weights_m->GetCoefficient(weights[1]), -1);
-  EXPECT_EQ(sum_weights_m->GetCoefficient(weights[2]), -1);
+  // sum_weights : w0 + w1 + w2 = 1
+  auto sum_weights = csts[0];
+  EXPECT_EQ(sum_weights->GetCoefficient(weights[0]), 1);
+  EXPECT_EQ(sum_weights->GetCoefficient(weights[1]), 1);
+  EXPECT_EQ(sum_weights->GetCoefficient(weights[2]), 1);
+  EXPECT_EQ(sum_weights->lb(), 1);
+  EXPECT_EQ(sum_weights->ub(), 1);
 
-  // sum_weights_p : w0 + w1 + w2
-  auto sum_weights_p = csts[1];
-  EXPECT_EQ(sum_weights_p->GetCoefficient(weights[0]), 1);
-  EXPECT_EQ(sum_weights_p->GetCoefficient(weights[1]), 1);
-  EXPECT_EQ(sum_weights_p->GetCoefficient(weights[2]), 1);
-
-  // cst_x_b0_a0_- : w0 + w1 - x0 + xp0
-  auto cst_x_b0_a0 = csts[2];
+  // cst_x_b0_a0 : w0 + w1 - lambda - x0 + xp0 = 0
+  auto cst_x_b0_a0 = csts[1];
   EXPECT_EQ(cst_x_b0_a0->GetCoefficient(weights[0]), 1);
   EXPECT_EQ(cst_x_b0_a0->GetCoefficient(weights[1]), 1);
   EXPECT_EQ(cst_x_b0_a0->GetCoefficient(weights[2]), 0);
   EXPECT_EQ(cst_x_b0_a0->GetCoefficient(x_a[0]), -1);
   EXPECT_EQ(cst_x_b0_a0->GetCoefficient(x_ap[0]), 1);
+  EXPECT_EQ(cst_x_b0_a0->lb(), 0);
+  EXPECT_EQ(cst_x_b0_a0->ub(), 0);
 
-  // cst_x_b0_a0_+ :- w0 - w1 + x0 - xp0
-  auto cst_x_b0_a0_m = csts[3];
-  EXPECT_EQ(cst_x_b0_a0_m->GetCoefficient(weights[0]), -1);
-  EXPECT_EQ(cst_x_b0_a0_m->GetCoefficient(weights[1]), -1);
-  EXPECT_EQ(cst_x_b0_a0_m->GetCoefficient(weights[2]), 0);
-  EXPECT_EQ(cst_x_b0_a0_m->GetCoefficient(x_a[0]), 1);
-  EXPECT_EQ(cst_x_b0_a0_m->GetCoefficient(x_ap[0]), -1);
-
-  // cst_x_b0_a1_- : w1 - x1 + xp1
-  auto cst_x_b0_a1 = csts[4];
+  // cst_x_b0_a1 : w1 - lambda - x1 + xp1 = 0
+  auto cst_x_b0_a1 = csts[2];
   EXPECT_EQ(cst_x_b0_a1->GetCoefficient(weights[0]), 0);
   EXPECT_EQ(cst_x_b0_a1->GetCoefficient(weights[1]), 1);
   EXPECT_EQ(cst_x_b0_a1->GetCoefficient(weights[2]), 0);
   EXPECT_EQ(cst_x_b0_a1->GetCoefficient(x_a[1]), -1);
   EXPECT_EQ(cst_x_b0_a1->GetCoefficient(x_ap[1]), 1);
 
-  // cst_x_b1_a2_- : w0 + w1 + w2 - x2 + xp2
-  auto cst_x_b1_a2 = csts[6];
+  // cst_x_b1_a2 : w0 + w1 + w2 - lambda - x2 + xp2 = 0
+  auto cst_x_b1_a2 = csts[3];
   EXPECT_EQ(cst_x_b1_a2->GetCoefficient(weights[0]), 1);
   EXPECT_EQ(cst_x_b1_a2->GetCoefficient(weights[1]), 1);
   EXPECT_EQ(cst_x_b1_a2->GetCoefficient(weights[2]), 1);
   EXPECT_EQ(cst_x_b1_a2->GetCoefficient(x_a[2]), -1);
   EXPECT_EQ(cst_x_b1_a2->GetCoefficient(x_ap[2]), 1);
 
-  // cst_y_b0_a1_- : w2 + y0 - yp0
-  auto cst_y_b0_a1 = csts[8];
-  EXPECT_EQ(cst_y_b0_a1->GetCoefficient(weights[0]), 0);
-  EXPECT_EQ(cst_y_b0_a1->GetCoefficient(weights[1]), 0);
-  EXPECT_EQ(cst_y_b0_a1->GetCoefficient(weights[2]), 1);
-  EXPECT_EQ(cst_y_b0_a1->GetCoefficient(y_a[0]), 1);
-  EXPECT_EQ(cst_y_b0_a1->GetCoefficient(y_ap[0]), -1);
-
-  // cst_y_b0_a1_+ : - w2 - y0 + yp0
-  auto cst_y_b0_a1_p = csts[9];
-  EXPECT_EQ(cst_y_b0_a1_p->GetCoefficient(weights[0]), 0);
-  EXPECT_EQ(cst_y_b0_a1_p->GetCoefficient(weights[1]), 0);
-  EXPECT_EQ(cst_y_b0_a1_p->GetCoefficient(weights[2]), -1);
-  EXPECT_EQ(cst_y_b0_a1_p->GetCoefficient(y_a[0]), -1);
-  EXPECT_EQ(cst_y_b0_a1_p->GetCoefficient(y_ap[0]), 1);
-
-  // cst_y_b1_a0_- : w1 + w2 + y0 - yp0
-  auto cst_y_b1_a0 = csts[10];
+  // cst_y_b0_a0 : w2 - lambda + y0 - yp0 = -delta
+  auto cst_y_b0_a0 = csts[4];
+  EXPECT_EQ(cst_y_b0_a0->GetCoefficient(weights[0]), 0);
+  EXPECT_EQ(cst_y_b0_a0->GetCoefficient(weights[1]), 0);
+  EXPECT_EQ(cst_y_b0_a0->GetCoefficient(weights[2]), 1);
+  EXPECT_EQ(cst_y_b0_a0->GetCoefficient(y_a[0]), 1);
+  EXPECT_EQ(cst_y_b0_a0->GetCoefficient(y_ap[0]), -1);
+  EXPECT_FLOAT_EQ(cst_y_b0_a0->lb(), -0.000001);
+  EXPECT_FLOAT_EQ(cst_y_b0_a0->ub(), -0.000001);
+
+  // cst_y_b1_a0 : w1 + w2 - lambda + y0 - yp0 = -delta
+  auto cst_y_b1_a0 = csts[5];
   EXPECT_EQ(cst_y_b1_a0->GetCoefficient(weights[0]), 0);
   EXPECT_EQ(cst_y_b1_a0->GetCoefficient(weights[1]), 1);
   EXPECT_EQ(cst_y_b1_a0->GetCoefficient(weights[2]), 1);
   EXPECT_EQ(cst_y_b1_a0->GetCoefficient(y_a[0]), 1);
   EXPECT_EQ(cst_y_b1_a0->GetCoefficient(y_ap[0]), -1);
 
-  // cst_y_b1_a2_- : w0 + w2 + y2 - yp2
-  auto cst_y_b1_a2 = csts[12];
+  // cst_y_b1_a2 : w0 + w2 - lambda + y2 - yp2 = -delta
+  auto cst_y_b1_a2 = csts[6];
   EXPECT_EQ(cst_y_b1_a2->GetCoefficient(weights[0]), 1);
   EXPECT_EQ(cst_y_b1_a2->GetCoefficient(weights[1]), 0);
   EXPECT_EQ(cst_y_b1_a2->GetCoefficient(weights[2]), 1);
@@ -142,7 +133,7 @@ TEST(TestLinearSolver, TestUpdateConstraints) {
 
   // check that everything from previous resolution was cleared
   ls.updateConstraints(matrix_x, matrix_y);
-  EXPECT_EQ(solver->NumConstraints(), 14);
+  EXPECT_EQ(solver->NumConstraints(), 7);
   EXPECT_EQ(solver->NumVariables(), 16);
 }
 
@@ -162,6 +153,9 @@ TEST(TestLinearSolver, TestSolve) {
       {{false, true, true}, {}, {true, false, true}}};
   Criteria crits = Criteria(3);
   Config conf = getSolverTestConf();
+  // alternative a0 appears in two y rows and shares its variables between them,
+  // which the reduced problem does not
+  conf.reduce_lp = false;
   AlternativesPerformance ap = AlternativesPerformance(3, crits);
   LinearSolver ls = LinearSolver(ap, conf);
 
@@ -170,4 +164,201 @@ TEST(TestLinearSolver, TestSolve) {
   EXPECT_EQ(res.second[0], 1);
   EXPECT_EQ(res.second[1], 0);
   EXPECT_EQ(res.second[2], 0);
-}
\ No newline at end of file
+}
+
+TEST(TestLinearSolver, TestUpdateSampledConstraints) {
+  // matrices of a sample of 2 of the 10 alternatives of the dataset
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{}, {false, true, true}}};
+  Criteria crits = Criteria(3);
+  Config conf;
+  conf.reduce_lp = false;
+  AlternativesPerformance ap = AlternativesPerformance(10, crits);
+  LinearSolver ls = LinearSolver(ap, conf);
+
+  ls.updateConstraints(matrix_x, matrix_y);
+
+  operations_research::MPSolver *solver = ls.getSolver();
+  // 1 (lambda) + 3 (weights) + 2 * 4 (xp, x, yp, y), whatever the size of the
+  // dataset
+  EXPECT_EQ(solver->NumVariables(), 12);
+  EXPECT_EQ(ls.getXap().size(), 2);
+  EXPECT_EQ(solver->NumConstraints(), 3);
+}
+
+TEST(TestLinearSolver, TestInitializeReducedSolver) {
+  Criteria crits = Criteria(2);
+  Config conf = getSolverTestConf();
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  LinearSolver ls = LinearSolver(ap, conf);
+  ls.initializeSolver();
+
+  operations_research::MPSolver *solver = ls.getSolver();
+  // 1 (lambda) + 2 (weights), rows variables are added with the rows
+  EXPECT_EQ(solver->NumVariables(), 3);
+  EXPECT_EQ(solver->NumConstraints(), 1);
+}
+
+TEST(TestLinearSolver, TestUpdateReducedConstraints) {
+  // x rows: w0 + w1 (3 alternatives), w2 (1 alternative)
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {true, true, false}, {}, {}},
+      {{}, {}, {true, true, false}, {false, false, true}}};
+  // y rows: w2 (3 alternatives)
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{false, false, true}, {false, false, true}, {}, {}},
+      {{}, {}, {false, false, true}, {}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSolverTestConf();
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  LinearSolver ls = LinearSolver(ap, conf);
+
+  ls.updateConstraints(matrix_x, matrix_y);
+
+  operations_research::MPSolver *solver = ls.getSolver();
+  // 1 (sum of weights) + 2 (x rows) + 1 (y row)
+  EXPECT_EQ(solver->NumConstraints(), 4);
+  // 1 (lambda) + 3 (weights) + 2 * 2 (x, xp) + 2 * 1 (y, yp)
+  EXPECT_EQ(solver->NumVariables(), 10);
+
+  auto x_ap = ls.getXap();
+  auto y_ap = ls.getYap();
+  ASSERT_EQ(x_ap.size(), 2);
+  ASSERT_EQ(y_ap.size(), 1);
+  EXPECT_EQ(solver->Objective().GetCoefficient(x_ap[0]), 3);
+  EXPECT_EQ(solver->Objective().GetCoefficient(x_ap[1]), 1);
+  EXPECT_EQ(solver->Objective().GetCoefficient(y_ap[0]), 3);
+
+  // cst_x_r1 : w2 - lambda - x1 + xp1 = 0
+  auto weights = ls.getWeights();
+  auto x_a = ls.getXa();
+  auto cst_x_r1 = solver->constraints()[2];
+  EXPECT_EQ(cst_x_r1->GetCoefficient(weights[0]), 0);
+  EXPECT_EQ(cst_x_r1->GetCoefficient(weights[1]), 0);
+  EXPECT_EQ(cst_x_r1->GetCoefficient(weights[2]), 1);
+  EXPECT_EQ(cst_x_r1->GetCoefficient(x_a[1]), -1);
+  EXPECT_EQ(cst_x_r1->GetCoefficient(x_ap[1]), 1);
+
+  // mapping of the alternatives to the rows
+  std::vector<std::vector<int>> x_rows{{0, 0, -1, -1}, {-1, -1, 0, 1}};
+  std::vector<std::vector<int>> y_rows{{0, 0, -1, -1}, {-1, -1, 0, -1}};
+  EXPECT_EQ(ls.getXRows(), x_rows);
+  EXPECT_EQ(ls.getYRows(), y_rows);
+}
+
+TEST(TestLinearSolver, TestReducedSolveSameObjective) {
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {true, true, false}, {}, {}},
+      {{}, {}, {true, false, false}, {false, true, true}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{false, false, true}, {false, false, true}, {}, {}},
+      {{}, {}, {true, true, false}, {}}};
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+
+  Config full_conf = getSolverTestConf();
+  full_conf.reduce_lp = false;
+  LinearSolver full = LinearSolver(ap, full_conf);
+  full.solve(matrix_x, matrix_y);
+
+  Config reduced_conf = getSolverTestConf();
+  LinearSolver reduced = LinearSolver(ap, reduced_conf);
+  reduced.solve(matrix_x, matrix_y);
+
+  EXPECT_LT(reduced.getSolver()->NumConstraints(),
+            full.getSolver()->NumConstraints());
+  EXPECT_NEAR(reduced.getSolver()->Objective().Value(),
+              full.getSolver()->Objective().Value(), 1e-5);
+}
+
+TEST(TestLinearSolver, TestEqualityRowsSameWeights) {
+  // fixtures of TestSolve and TestReducedSolveSameObjective
+  std::vector<std::vector<std::vector<std::vector<bool>>>> matrices_x{
+      {{{true, true, false}, {false, true, false}, {}},
+       {{}, {}, {true, true, true}}},
+      {{{true, true, false}, {true, true, false}, {}, {}},
+       {{}, {}, {true, false, false}, {false, true, true}}}};
+  std::vector<std::vector<std::vector<std::vector<bool>>>> matrices_y{
+      {{{false, false, true}, {}, {}},
+       {{false, true, true}, {}, {true, false, true}}},
+      {{{false, false, true}, {false, false, true}, {}, {}},
+       {{}, {}, {true, true, false}, {}}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSolverTestConf();
+  conf.reduce_lp = false;
+
+  for (int k = 0; k < matrices_x.size(); k++) {
+    int n_alt = matrices_x[k][0].size();
+    AlternativesPerformance ap = AlternativesPerformance(n_alt, crits);
+    LinearSolver ls = LinearSolver(ap, conf);
+    auto res = ls.solve(matrices_x[k], matrices_y[k]);
+    auto paired =
+        solvePairedRows(matrices_x[k], matrices_y[k], 3, n_alt, 0.000001);
+
+    EXPECT_EQ(paired.status, operations_research::MPSolver::OPTIMAL);
+    EXPECT_NEAR(res.first, paired.lambda, 1e-6);
+    for (int crit = 0; crit < 3; crit++) {
+      EXPECT_NEAR(res.second[crit], paired.weights[crit], 1e-6);
+    }
+  }
+}
+
+TEST(TestLinearSolver, TestUnnamedModel) {
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {false, true, false}, {}},
+      {{}, {}, {true, true, true}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{false, false, true}, {}, {}},
+      {{false, true, true}, {}, {true, false, true}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSolverTestConf();
+  AlternativesPerformance ap = AlternativesPerformance(3, crits);
+  LinearSolver ls = LinearSolver(ap, conf);
+
+  ls.updateConstraints(matrix_x, matrix_y);
+  // OR-Tools may give its own names, but none of the ones built by lpName
+  std::vector<std::string> names;
+  for (auto var : ls.getSolver()->variables()) {
+    names.push_back(var->name());
+  }
+  for (auto cst : ls.getSolver()->constraints()) {
+    names.push_back(cst->name());
+  }
+  for (const std::string &name : names) {
+    EXPECT_NE(name, "w0");
+    EXPECT_NE(name, "xp1");
+    EXPECT_NE(name, "lambda");
+    EXPECT_NE(name, "weight_constraint");
+    EXPECT_NE(name.rfind("cst_", 0), 0) << name;
+  }
+}
+
+TEST(TestLinearSolver, TestDumpModel) {
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {false, true, false}, {}},
+      {{}, {}, {true, true, true}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{false, false, true}, {}, {}},
+      {{false, true, true}, {}, {true, false, true}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSolverTestConf();
+  conf.data_dir = "../logs/";
+  conf.lp_dump = "test_lp_dump.mps";
+  AlternativesPerformance ap = AlternativesPerformance(3, crits);
+  LinearSolver ls = LinearSolver(ap, conf);
+
+  ls.solve(matrix_x, matrix_y);
+  auto vars = ls.getSolver()->variables();
+  EXPECT_EQ(vars[0]->name(), "w0");
+  EXPECT_EQ(ls.getXap()[1]->name(), "xp1");
+
+  std::ifstream dump("../logs/test_lp_dump.mps");
+  ASSERT_TRUE(dump.good());
+  std::string content((std::istreambuf_iterator<char>(dump)),
+                      std::istreambuf_iterator<char>());
+  EXPECT_FALSE(content.empty());
+  dump.close();
+  std::remove("../logs/test_lp_dump.mps");
+}
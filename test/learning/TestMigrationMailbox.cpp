@@ -0,0 +1,63 @@
+#include "../../include/learning/MigrationMailbox.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+#include <thread>
+#include <utility>
+
+TEST(TestMigrationMailbox, TestCollectEmpty) {
+  MigrationMailbox mailbox = MigrationMailbox();
+  EXPECT_TRUE(mailbox.collect().empty());
+}
+
+TEST(TestMigrationMailbox, TestPostCollect) {
+  MigrationMailbox mailbox;
+  std::vector<MRSortModel> migrants;
+  migrants.push_back(MRSortModel(2, 3, "model0"));
+  migrants.push_back(MRSortModel(2, 3, "model1"));
+  mailbox.post(migrants);
+
+  std::vector<MRSortModel> arrivals = mailbox.collect();
+  EXPECT_EQ(arrivals.size(), 2);
+  EXPECT_EQ(arrivals[0].getId(), "model0");
+  EXPECT_EQ(arrivals[1].getId(), "model1");
+  // a batch is collected only once
+  EXPECT_TRUE(mailbox.collect().empty());
+}
+
+TEST(TestMigrationMailbox, TestPostReplacesUncollected) {
+  MigrationMailbox mailbox;
+  std::vector<MRSortModel> old_migrants;
+  old_migrants.push_back(MRSortModel(2, 3, "old"));
+  std::vector<MRSortModel> new_migrants;
+  new_migrants.push_back(MRSortModel(2, 3, "new"));
+  mailbox.post(old_migrants);
+  mailbox.post(new_migrants);
+
+  std::vector<MRSortModel> arrivals = mailbox.collect();
+  EXPECT_EQ(arrivals.size(), 1);
+  EXPECT_EQ(arrivals[0].getId(), "new");
+}
+
+TEST(TestMigrationMailbox, TestConcurrentPostCollect) {
+  MigrationMailbox mailbox;
+  std::vector<MRSortModel> migrants;
+  migrants.push_back(MRSortModel(2, 3, "model"));
+  int n_posts = 1000;
+  std::thread sender([&mailbox, &migrants, n_posts]() {
+    for (int i = 0; i < n_posts; i++) {
+      mailbox.post(migrants);
+    }
+  });
+  int n_collected = 0;
+  for (int i = 0; i < n_posts; i++) {
+    std::vector<MRSortModel> arrivals = mailbox.collect();
+    if (!arrivals.empty()) {
+      EXPECT_EQ(arrivals[0].getId(), "model");
+      n_collected++;
+    }
+  }
+  sender.join();
+  n_collected += mailbox.collect().size();
+  EXPECT_GE(n_collected, 1);
+  EXPECT_LE(n_collected, n_posts);
+}
@@ -0,0 +1,69 @@
+#include "../../include/config.h"
+#include "../../include/learning/ModelCheckpointer.h"
+#include "../../include/types/DataGenerator.h"
+#include "../../include/utils.h"
+#include "gtest/gtest.h"
+#include <tuple>
+#include <utility>
+
+Config getCheckpointerTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  return conf;
+}
+
+TEST(TestModelCheckpointer, TestIsDue) {
+  Config conf = getCheckpointerTestConf();
+  ModelCheckpointer checkpointer = ModelCheckpointer(conf);
+  // disabled by default
+  EXPECT_FALSE(checkpointer.isDue());
+
+  conf.checkpoint_interval_seconds = 0.000001;
+  // no output to write to
+  EXPECT_FALSE(checkpointer.isDue());
+
+  conf.output = "test_checkpoint_model.xml";
+  EXPECT_TRUE(checkpointer.isDue());
+
+  conf.checkpoint_interval_seconds = 3600;
+  EXPECT_FALSE(checkpointer.isDue());
+}
+
+TEST(TestModelCheckpointer, TestSave) {
+  Config conf = getCheckpointerTestConf();
+  conf.output = "test_checkpoint_model.xml";
+  conf.checkpoint_interval_seconds = 3600;
+  ModelCheckpointer checkpointer = ModelCheckpointer(conf);
+
+  MRSortModel model = MRSortModel(3, 2);
+  model.profiles.changeMode("alt");
+  model.lambda = 0.75;
+  checkpointer.save(model);
+  // the saved model is a copy, changing it before the write has no effect
+  model.lambda = 0.5;
+  checkpointer.wait();
+  EXPECT_EQ(checkpointer.getNumberCheckpoints(), 1);
+
+  EXPECT_TRUE(fileExists(conf.data_dir + conf.output));
+  EXPECT_FALSE(fileExists(conf.data_dir + conf.output + ".tmp"));
+  DataGenerator dg = DataGenerator(conf);
+  std::tuple<float, Criteria, PerformanceTable> saved =
+      dg.loadModel(conf.output);
+  EXPECT_FLOAT_EQ(std::get<0>(saved), 0.75);
+
+  checkpointer.save(model);
+  checkpointer.wait();
+  EXPECT_EQ(checkpointer.getNumberCheckpoints(), 2);
+  EXPECT_FALSE(checkpointer.isDue());
+  saved = dg.loadModel(conf.output);
+  EXPECT_FLOAT_EQ(std::get<0>(saved), 0.5);
+
+  std::string path_to_remove = conf.data_dir + conf.output;
+  std::remove(path_to_remove.c_str());
+}
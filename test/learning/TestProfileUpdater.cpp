@@ -1,5 +1,6 @@
 #include "../../include/app.h"
 #include "../../include/learning/ProfileUpdater.h"
+#include "../../include/learning/ScratchArena.h"
 #include "gtest/gtest.h"
 #include <algorithm>
 #include <sstream>
@@ -104,7 +105,7 @@ TEST(TestProfileUpdater, TestComputeAboveDesirability) {
   Category cat = categories.getCategoryOfRank(0);
   Category cat_above = categories.getCategoryOfRank(1);
 
-  std::unordered_map<float, float> above_des =
+  ProfileUpdater::Desirability above_des =
       profUpdater.computeAboveDesirability(model, "crit0", b0_c0, b1_c0, cat,
                                            cat_above, ct_b0, altPerf_model);
   EXPECT_FLOAT_EQ(
@@ -112,7 +113,7 @@ TEST(TestProfileUpdater, TestComputeAboveDesirability) {
 
   Perf b0_c3 = Perf("b0", "crit3", 0.3);
   Perf b1_c3 = Perf("b1", "crit3", 0.6);
-  std::unordered_map<float, float> above_des_bis =
+  ProfileUpdater::Desirability above_des_bis =
       profUpdater.computeAboveDesirability(model, "crit3", b0_c3, b1_c3, cat,
                                            cat_above, ct_b0, altPerf_model);
   EXPECT_FLOAT_EQ(
@@ -137,7 +138,7 @@ TEST(TestProfileUpdater, TestComputeBelowDesirability) {
   Category cat = categories.getCategoryOfRank(0);
   Category cat_above = categories.getCategoryOfRank(1);
 
-  std::unordered_map<float, float> below_des =
+  ProfileUpdater::Desirability below_des =
       profUpdater.computeBelowDesirability(model, "crit1", b0_c1, base, cat,
                                            cat_above, ct_b0, altPerf_model);
   EXPECT_FLOAT_EQ(
@@ -149,7 +150,7 @@ TEST(TestProfileUpdater, TestChooseMaxDesirability) {
   AlternativesPerformance altPerf_data = newTestAltPerf();
   ProfileUpdater profUpdater = ProfileUpdater(conf, altPerf_data);
 
-  std::unordered_map<float, float> desirability;
+  ProfileUpdater::Desirability desirability;
   desirability[0.2] = 5;
   desirability[0.15] = 10;
   desirability[0.34] = 12;
@@ -238,4 +239,21 @@ TEST(TestProfileUpdater, TestOptimize) {
   ProfileUpdater profUpdater = ProfileUpdater(conf, altPerf_data);
   profUpdater.updateProfiles(model);
   // std::cout << model.profiles << std::endl;
-}
\ No newline at end of file
+}
+TEST(TestProfileUpdater, TestUpdateProfilesArena) {
+  Config conf = getProfUpdaterTestConf();
+  Categories categories = newTestCategories();
+  MRSortModel model = newTestModel(categories);
+  AlternativesPerformance altPerf_data = newTestAltPerf();
+
+  // an arena too small for the temporaries, grown by the first update
+  ScratchArena arena = ScratchArena(16);
+  ProfileUpdater profUpdater = ProfileUpdater(conf, altPerf_data);
+  profUpdater.updateProfiles(model, arena);
+  EXPECT_TRUE(model.profiles.isProfileOrdered());
+  EXPECT_GT(arena.getCapacity(), 16);
+  for (int i = 0; i < 5; i++) {
+    profUpdater.updateProfiles(model, arena);
+    EXPECT_TRUE(model.profiles.isProfileOrdered());
+  }
+}
@@ -0,0 +1,49 @@
+#include "../../include/learning/ScratchArena.h"
+#include "gtest/gtest.h"
+#include <memory_resource>
+#include <vector>
+
+TEST(TestScratchArena, TestAllocateInBuffer) {
+  ScratchArena arena = ScratchArena(1024);
+  EXPECT_EQ(arena.getCapacity(), 1024);
+  void *first = nullptr;
+  for (int i = 0; i < 3; i++) {
+    {
+      std::pmr::vector<int> v(arena.resource());
+      v.reserve(100);
+      v.push_back(i);
+      EXPECT_EQ(v[0], i);
+      // the same memory is handed out after each reset
+      if (first == nullptr) {
+        first = v.data();
+      }
+      EXPECT_EQ(v.data(), first);
+      // without reset, the next allocations follow
+      std::pmr::vector<int> w(arena.resource());
+      w.reserve(100);
+      EXPECT_NE(w.data(), v.data());
+    }
+    arena.reset();
+  }
+  EXPECT_EQ(arena.getCapacity(), 1024);
+}
+
+TEST(TestScratchArena, TestGrowOnOverflow) {
+  ScratchArena arena = ScratchArena(64);
+  {
+    std::pmr::vector<double> v(arena.resource());
+    v.resize(1000, 1.);
+    EXPECT_EQ(v[999], 1.);
+  }
+  EXPECT_EQ(arena.getCapacity(), 64);
+  arena.reset();
+  // the next step fits in the buffer
+  EXPECT_GE(arena.getCapacity(), 1000 * sizeof(double));
+  std::size_t capacity = arena.getCapacity();
+  {
+    std::pmr::vector<double> v(arena.resource());
+    v.resize(1000, 2.);
+  }
+  arena.reset();
+  EXPECT_EQ(arena.getCapacity(), capacity);
+}
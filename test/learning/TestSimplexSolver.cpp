@@ -0,0 +1,130 @@
+#include "../../include/config.h"
+#include "../../include/learning/LPSolver.h"
+#include "../../include/learning/LinearSolver.h"
+#include "../../include/learning/SimplexSolver.h"
+#include "../../include/types/AlternativesPerformance.h"
+#include "../../include/types/Criteria.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+
+Config getSimplexTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  spdlog::set_level(spdlog::level::debug);
+  return conf;
+}
+
+std::vector<std::vector<std::vector<bool>>>
+randomSimplexMatrix(std::mt19937 &gen, int n_prof, int n_alt, int n_crit) {
+  std::bernoulli_distribution coin(0.5);
+  std::uniform_int_distribution<int> profile(0, n_prof - 1);
+  std::vector<std::vector<std::vector<bool>>> matrix(
+      n_prof, std::vector<std::vector<bool>>(n_alt));
+  for (int alt = 0; alt < n_alt; alt++) {
+    std::vector<bool> row;
+    for (int crit = 0; crit < n_crit; crit++) {
+      row.push_back(coin(gen));
+    }
+    matrix[profile(gen)][alt] = row;
+  }
+  return matrix;
+}
+
+void expectSimplexFeasible(std::pair<float, std::vector<float>> &res) {
+  EXPECT_GE(res.first, 0.5 - 1e-5);
+  EXPECT_LE(res.first, 1 + 1e-5);
+  float sum = 0;
+  for (float w : res.second) {
+    EXPECT_GE(w, -1e-5);
+    EXPECT_LE(w, 1 + 1e-5);
+    sum += w;
+  }
+  EXPECT_NEAR(sum, 1, 1e-5);
+}
+
+TEST(TestSimplexSolver, TestCreate) {
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  Config conf = getSimplexTestConf();
+
+  std::unique_ptr<LPSolver> glop = LPSolver::create(ap, conf);
+  EXPECT_NE(dynamic_cast<LinearSolver *>(glop.get()), nullptr);
+
+  conf.lp_solver = "SIMPLEX";
+  std::unique_ptr<LPSolver> simplex = LPSolver::create(ap, conf);
+  EXPECT_NE(dynamic_cast<SimplexSolver *>(simplex.get()), nullptr);
+
+  conf.lp_solver = "NOT_A_SOLVER";
+  EXPECT_THROW(LPSolver::create(ap, conf), std::invalid_argument);
+}
+
+TEST(TestSimplexSolver, TestSolveSeparable) {
+  // a0 and a1 are above the profile with w0 + w1 and w0, a2 is below it with
+  // w1 + w2: w0 = 1 and lambda in ]0, 1] classify them all correctly
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{}, {}, {}}, {{true, true, false}, {true, false, false}, {}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{}, {}, {false, true, true}}, {{}, {}, {}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSimplexTestConf();
+  AlternativesPerformance ap = AlternativesPerformance(3, crits);
+  SimplexSolver ss = SimplexSolver(ap, conf);
+
+  auto res = ss.solve(matrix_x, matrix_y);
+  expectSimplexFeasible(res);
+  EXPECT_NEAR(ss.getObjectiveValue(), 0, 1e-9);
+  EXPECT_GE(res.second[0] + res.second[1], res.first - 1e-5);
+  EXPECT_GE(res.second[0], res.first - 1e-5);
+  EXPECT_LT(res.second[1] + res.second[2], res.first);
+}
+
+TEST(TestSimplexSolver, TestSolveSameObjective) {
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{true, true, false}, {true, true, false}, {}, {}},
+      {{}, {}, {true, false, false}, {false, true, true}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{false, false, true}, {false, false, true}, {}, {}},
+      {{}, {}, {true, true, false}, {}}};
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  Config conf = getSimplexTestConf();
+
+  LinearSolver glop = LinearSolver(ap, conf);
+  glop.solve(matrix_x, matrix_y);
+  SimplexSolver simplex = SimplexSolver(ap, conf);
+  auto res = simplex.solve(matrix_x, matrix_y);
+
+  expectSimplexFeasible(res);
+  EXPECT_NEAR(simplex.getObjectiveValue(),
+              glop.getSolver()->Objective().Value(), 1e-5);
+}
+
+TEST(TestSimplexSolver, TestRandomProblemsSameObjective) {
+  std::mt19937 gen(42);
+  for (int n_crit : {2, 4, 7}) {
+    Criteria crits = Criteria(n_crit);
+    AlternativesPerformance ap = AlternativesPerformance(200, crits);
+    Config conf = getSimplexTestConf();
+    for (int k = 0; k < 3; k++) {
+      auto matrix_x = randomSimplexMatrix(gen, 3, 200, n_crit);
+      auto matrix_y = randomSimplexMatrix(gen, 3, 200, n_crit);
+
+      LinearSolver glop = LinearSolver(ap, conf);
+      glop.solve(matrix_x, matrix_y);
+      SimplexSolver simplex = SimplexSolver(ap, conf);
+      auto res = simplex.solve(matrix_x, matrix_y);
+
+      expectSimplexFeasible(res);
+      EXPECT_NEAR(simplex.getObjectiveValue(),
+                  glop.getSolver()->Objective().Value(), 1e-4);
+    }
+  }
+}
@@ -0,0 +1,121 @@
+#include "../../include/config.h"
+#include "../../include/learning/LPSolver.h"
+#include "../../include/learning/SimplexSolver.h"
+#include "../../include/learning/SubgradientSolver.h"
+#include "../../include/types/AlternativesPerformance.h"
+#include "../../include/types/Criteria.h"
+#include "gtest/gtest.h"
+
+#include <random>
+#include <utility>
+
+Config getSubgradientTestConf() {
+  Config conf;
+  conf.data_dir = "../data/tests/";
+  try {
+    conf.logger =
+        spdlog::basic_logger_mt("test_logger", "../logs/test_logger.txt");
+  } catch (const spdlog::spdlog_ex &ex) {
+    conf.logger = spdlog::get("test_logger");
+  }
+  spdlog::set_level(spdlog::level::debug);
+  return conf;
+}
+
+std::vector<std::vector<std::vector<bool>>>
+randomSubgradientMatrix(std::mt19937 &gen, int n_prof, int n_alt,
+                        int n_crit) {
+  std::bernoulli_distribution coin(0.5);
+  std::uniform_int_distribution<int> profile(0, n_prof - 1);
+  std::vector<std::vector<std::vector<bool>>> matrix(
+      n_prof, std::vector<std::vector<bool>>(n_alt));
+  for (int alt = 0; alt < n_alt; alt++) {
+    std::vector<bool> row;
+    for (int crit = 0; crit < n_crit; crit++) {
+      row.push_back(coin(gen));
+    }
+    matrix[profile(gen)][alt] = row;
+  }
+  return matrix;
+}
+
+TEST(TestSubgradientSolver, TestCreate) {
+  Criteria crits = Criteria(3);
+  AlternativesPerformance ap = AlternativesPerformance(4, crits);
+  Config conf = getSubgradientTestConf();
+  conf.lp_solver = "SUBGRADIENT";
+  std::unique_ptr<LPSolver> solver = LPSolver::create(ap, conf);
+  EXPECT_NE(dynamic_cast<SubgradientSolver *>(solver.get()), nullptr);
+
+  conf.subgradient_iterations = 0;
+  EXPECT_THROW(LPSolver::create(ap, conf), std::invalid_argument);
+}
+
+TEST(TestSubgradientSolver, TestProjectOnSimplex) {
+  std::vector<double> equal = {0.5, 0.5, 0.5};
+  SubgradientSolver::projectOnSimplex(equal);
+  for (double w : equal) {
+    EXPECT_NEAR(w, 1. / 3, 1e-9);
+  }
+
+  std::vector<double> outside = {0.6, 0.5, -1};
+  SubgradientSolver::projectOnSimplex(outside);
+  EXPECT_NEAR(outside[0], 0.55, 1e-9);
+  EXPECT_NEAR(outside[1], 0.45, 1e-9);
+  EXPECT_NEAR(outside[2], 0, 1e-9);
+
+  std::vector<double> vertex = {2, 0, 0};
+  SubgradientSolver::projectOnSimplex(vertex);
+  EXPECT_NEAR(vertex[0], 1, 1e-9);
+  EXPECT_NEAR(vertex[1], 0, 1e-9);
+  EXPECT_NEAR(vertex[2], 0, 1e-9);
+}
+
+TEST(TestSubgradientSolver, TestSolveSeparable) {
+  // a0 and a1 are above the profile with w0 + w1 and w0, a2 is below it with
+  // w1 + w2: w0 = 1 and lambda in ]0, 1] classify them all correctly
+  std::vector<std::vector<std::vector<bool>>> matrix_x{
+      {{}, {}, {}}, {{true, true, false}, {true, false, false}, {}}};
+  std::vector<std::vector<std::vector<bool>>> matrix_y{
+      {{}, {}, {false, true, true}}, {{}, {}, {}}};
+  Criteria crits = Criteria(3);
+  Config conf = getSubgradientTestConf();
+  AlternativesPerformance ap = AlternativesPerformance(3, crits);
+  SubgradientSolver solver = SubgradientSolver(ap, conf);
+
+  auto res = solver.solve(matrix_x, matrix_y);
+  EXPECT_NEAR(solver.getObjectiveValue(), 0, 1e-3);
+  EXPECT_GE(res.first, 0.5);
+  EXPECT_LE(res.first, 1);
+  EXPECT_NEAR(res.second[0] + res.second[1] + res.second[2], 1, 1e-5);
+}
+
+TEST(TestSubgradientSolver, TestCloseToOptimum) {
+  std::mt19937 gen(42);
+  for (int n_crit : {4, 7}) {
+    Criteria crits = Criteria(n_crit);
+    AlternativesPerformance ap = AlternativesPerformance(500, crits);
+    Config conf = getSubgradientTestConf();
+    for (int k = 0; k < 3; k++) {
+      auto matrix_x = randomSubgradientMatrix(gen, 2, 500, n_crit);
+      auto matrix_y = randomSubgradientMatrix(gen, 2, 500, n_crit);
+
+      SimplexSolver simplex = SimplexSolver(ap, conf);
+      simplex.solve(matrix_x, matrix_y);
+      SubgradientSolver subgradient = SubgradientSolver(ap, conf);
+      auto res = subgradient.solve(matrix_x, matrix_y);
+
+      float sum = 0;
+      for (float w : res.second) {
+        EXPECT_GE(w, 0);
+        sum += w;
+      }
+      EXPECT_NEAR(sum, 1, 1e-5);
+      // approximate, but within 1% of the optimal objective
+      EXPECT_GE(subgradient.getObjectiveValue(),
+                simplex.getObjectiveValue() - 1e-6);
+      EXPECT_LE(subgradient.getObjectiveValue(),
+                1.01 * simplex.getObjectiveValue() + 1e-6);
+    }
+  }
+}
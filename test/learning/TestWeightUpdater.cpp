@@ -7,6 +7,7 @@
 #include "../../include/types/MRSortModel.h"
 #include "../../include/types/Perf.h"
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -87,6 +88,9 @@ TEST(TestWeightUpdater, TestComputeYMatrix) {
 
 TEST(TestWeightUpdater, TestCompleteSolve) {
   Config conf = getWeightTestConf();
+  // the problem has several optimal solutions, this is the one of the full
+  // problem
+  conf.reduce_lp = false;
   auto ap = getAPTest();
   auto model = getModelTest();
   WeightUpdater wu = WeightUpdater(ap, conf);
@@ -96,4 +100,122 @@ TEST(TestWeightUpdater, TestCompleteSolve) {
   EXPECT_EQ(1, model.lambda);
   EXPECT_EQ(1, model.criteria[0].getWeight());
   EXPECT_EQ(0, model.criteria[1].getWeight());
-}
\ No newline at end of file
+}
+TEST(TestWeightUpdater, TestCompleteReducedSolve) {
+  Config conf = getWeightTestConf();
+  auto ap = getAPTest();
+  auto model = getModelTest();
+  WeightUpdater wu = WeightUpdater(ap, conf);
+  wu.updateWeightsAndLambda(model);
+
+  // any optimal solution assigns the three alternatives correctly
+  EXPECT_GE(model.lambda, 0.5);
+  EXPECT_LE(model.lambda, 1);
+  EXPECT_NEAR(model.criteria[0].getWeight() + model.criteria[1].getWeight(), 1,
+              1e-5);
+  EXPECT_LT(model.criteria[1].getWeight(), model.lambda);
+}
+
+// 15 alternatives of cat1, compared with the first profile (0.3, 0.4) in the x
+// matrix: the 3 first are only above it on crit0, the others on both criteria.
+// 5 alternatives of cat0, compared with the same profile in the y matrix: the
+// first is above it on crit0, the others on no criterion.
+AlternativesPerformance getSampleAPTest() {
+  std::vector<std::vector<Perf>> perf_vect;
+  Criteria crits = Criteria(2, "crit");
+  std::unordered_map<std::string, Category> map;
+  for (int i = 0; i < 20; i++) {
+    std::string name = "a" + std::to_string(i);
+    std::vector<float> vec;
+    if (i < 15) {
+      vec = i < 3 ? std::vector<float>{0.5, 0.2} : std::vector<float>{0.5, 0.6};
+      map[name] = Category("cat1", 1);
+    } else {
+      vec = i == 15 ? std::vector<float>{0.5, 0.2}
+                    : std::vector<float>{0.1, 0.2};
+      map[name] = Category("cat0", 0);
+    }
+    perf_vect.push_back(createVectorPerf(name, crits, vec));
+  }
+  return AlternativesPerformance(perf_vect, map);
+}
+
+int countSampled(std::vector<int> &sample, int first_alt, int last_alt) {
+  return std::count_if(sample.begin(), sample.end(), [&](int alt) {
+    return alt >= first_alt && alt < last_alt;
+  });
+}
+
+TEST(TestWeightUpdater, TestSampleAlternatives) {
+  Config conf = getWeightTestConf();
+  conf.lp_sample_size = 8;
+  auto ap = getSampleAPTest();
+  auto model = getModelTest();
+  WeightUpdater wu = WeightUpdater(ap, conf);
+
+  std::vector<int> sample = wu.sampleAlternatives(model);
+
+  // stratified sample: 8 * 15 / 20 alternatives of cat1, 8 * 5 / 20 of cat0
+  ASSERT_EQ(sample.size(), 8);
+  EXPECT_TRUE(std::is_sorted(sample.begin(), sample.end()));
+  EXPECT_EQ(std::adjacent_find(sample.begin(), sample.end()), sample.end());
+  EXPECT_EQ(countSampled(sample, 0, 15), 6);
+  EXPECT_EQ(countSampled(sample, 15, 20), 2);
+}
+
+TEST(TestWeightUpdater, TestSampleAlternativesFocus) {
+  Config conf = getWeightTestConf();
+  conf.lp_sample_size = 4;
+  conf.lp_sample_focus = 1;
+  auto ap = getSampleAPTest();
+  auto model = getModelTest();
+  model.criteria.setWeights(std::vector<float>{0.5, 0.5});
+  model.lambda = 0.6;
+  WeightUpdater wu = WeightUpdater(ap, conf);
+
+  std::vector<int> sample = wu.sampleAlternatives(model);
+
+  // closest to the threshold: a0, a1, a2 (0.5 - 0.6) in cat1 and a15
+  // (0.6 - 0.5) in cat0
+  EXPECT_EQ(sample, std::vector<int>({0, 1, 2, 15}));
+}
+
+TEST(TestWeightUpdater, TestComputeSampledMatrices) {
+  Config conf = getWeightTestConf();
+  auto ap = getAPTest();
+  auto model = getModelTest();
+  WeightUpdater wu = WeightUpdater(ap, conf);
+
+  // rows of the sampled alternatives only, in the order of the sample
+  std::vector<int> sample = {2, 0};
+  std::vector<std::vector<std::vector<bool>>> x_matrix_expected = {
+      {{}, {true, true}}};
+  std::vector<std::vector<std::vector<bool>>> y_matrix_expected = {
+      {{false, true}, {}}};
+  EXPECT_EQ(wu.computeXMatrix(model, sample), x_matrix_expected);
+  EXPECT_EQ(wu.computeYMatrix(model, sample), y_matrix_expected);
+}
+
+TEST(TestWeightUpdater, TestSampledSolveAndPolish) {
+  Config conf = getWeightTestConf();
+  conf.lp_sample_size = 4;
+  conf.lp_sample_focus = 0.5;
+  auto ap = getSampleAPTest();
+  auto model = getModelTest();
+  WeightUpdater wu = WeightUpdater(ap, conf);
+
+  wu.updateWeightsAndLambda(model);
+  EXPECT_NEAR(model.criteria[0].getWeight() + model.criteria[1].getWeight(), 1,
+              1e-5);
+  // on the whole dataset, the 3 alternatives of cat1 only above the profile on
+  // crit0 outweigh the one of cat0: crit0 alone reaches the threshold
+  wu.polishWeightsAndLambda(model);
+  EXPECT_GE(model.criteria[0].getWeight(), model.lambda - 1e-5);
+}
+
+TEST(TestWeightUpdater, TestWrongSampleFocus) {
+  Config conf = getWeightTestConf();
+  conf.lp_sample_focus = 1.5;
+  auto ap = getAPTest();
+  EXPECT_THROW(WeightUpdater(ap, conf), std::invalid_argument);
+}
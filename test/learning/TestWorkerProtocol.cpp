@@ -0,0 +1,94 @@
+#include "../../include/learning/WorkerProtocol.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+
+TEST(TestWorkerProtocol, TestSendReceiveMessage) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  sendMessage(fds[0], MessageType::Post, "payload");
+  sendMessage(fds[0], MessageType::Collect);
+
+  std::string payload;
+  EXPECT_EQ(receiveMessage(fds[1], payload), MessageType::Post);
+  EXPECT_EQ(payload, "payload");
+  EXPECT_EQ(receiveMessage(fds[1], payload), MessageType::Collect);
+  EXPECT_EQ(payload, "");
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(TestWorkerProtocol, TestReceiveClosedSocket) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  close(fds[0]);
+  std::string payload;
+  EXPECT_THROW(receiveMessage(fds[1], payload), std::runtime_error);
+  close(fds[1]);
+}
+
+TEST(TestWorkerProtocol, TestReceiveOversizedFrame) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  // header announcing a payload of 4 GiB - 1
+  const char header[5] = {static_cast<char>(MessageType::Learn), '\xff', '\xff',
+                          '\xff', '\xff'};
+  ASSERT_EQ(write(fds[0], header, sizeof(header)), sizeof(header));
+  std::string payload;
+  EXPECT_THROW(receiveMessage(fds[1], payload), std::length_error);
+  EXPECT_TRUE(payload.empty());
+  EXPECT_THROW(sendMessage(fds[0], MessageType::Learn,
+                           std::string(max_payload_size + 1, 'a')),
+               std::length_error);
+  close(fds[0]);
+  close(fds[1]);
+}
+
+TEST(TestWorkerProtocol, TestEncodeDecodeModels) {
+  std::vector<MRSortModel> models;
+  models.push_back(MRSortModel(3, 4, "model0"));
+  models.push_back(MRSortModel(2, 3, "model1"));
+  models[0].setScore(0.75);
+  models[1].setScore(0.5);
+
+  std::vector<MRSortModel> decoded = decodeModels(encodeModels(models));
+  ASSERT_EQ(decoded.size(), 2);
+  for (int m = 0; m < 2; m++) {
+    EXPECT_EQ(decoded[m].getId(), models[m].getId());
+    EXPECT_EQ(decoded[m].getScore(), models[m].getScore());
+    EXPECT_EQ(decoded[m].lambda, models[m].lambda);
+    EXPECT_EQ(decoded[m].criteria.getWeights(), models[m].criteria.getWeights());
+    EXPECT_EQ(decoded[m].profiles.getMode(), models[m].profiles.getMode());
+    EXPECT_EQ(decoded[m].profiles.getPerformanceTable(),
+              models[m].profiles.getPerformanceTable());
+    EXPECT_EQ(decoded[m].categories.getIdCategories(),
+              models[m].categories.getIdCategories());
+    EXPECT_EQ(decoded[m].categories.getRankCategories(),
+              models[m].categories.getRankCategories());
+  }
+}
+
+TEST(TestWorkerProtocol, TestDecodeEmpty) {
+  EXPECT_TRUE(decodeModels("").empty());
+  EXPECT_TRUE(decodeModels(encodeModels(std::vector<MRSortModel>())).empty());
+}
+
+TEST(TestWorkerProtocol, TestDecodeMalformed) {
+  EXPECT_THROW(decodeModels("1\nmodel 0.5"), std::invalid_argument);
+  // counts larger than the characters left are rejected before allocating
+  EXPECT_THROW(decodeModels("4000000000\n"), std::invalid_argument);
+  EXPECT_THROW(decodeModels("1\nmodel 0.5 0.6\n0\n4000000000\n"),
+               std::invalid_argument);
+  EXPECT_THROW(decodeModels("1\nmodel 0.5 0.6\n0\n0\nalt 4000000000\n"),
+               std::invalid_argument);
+  EXPECT_THROW(decodeModels("1\nmodel 0.5 0.6\n0\n0\nalt -1\n"),
+               std::invalid_argument);
+}
+
+TEST(TestWorkerProtocol, TestEncodeIdWithSpace) {
+  std::vector<MRSortModel> models;
+  models.push_back(MRSortModel(3, 4, "model 0"));
+  EXPECT_THROW(encodeModels(models), std::invalid_argument);
+}
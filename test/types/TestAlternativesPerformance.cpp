@@ -160,6 +160,47 @@ TEST(TestAlternativesPerformance, TestConstructorWithPerfTableMapErrors) {
   }
 }
 
+TEST(TestAlternativesPerformance, TestConstructorTrusted) {
+  std::vector<std::vector<Perf>> perf_vect;
+  Criteria crit = Criteria(2, "crit");
+  perf_vect.push_back(createVectorPerfWithNoPerf("a0", crit));
+  perf_vect.push_back(createVectorPerfWithNoPerf("a1", crit));
+  PerformanceTable perf_table = PerformanceTable(perf_vect);
+
+  Category cat0 = Category("cat0", 0);
+  Category cat1 = Category("cat1", 1);
+  std::unordered_map<std::string, Category> map =
+      std::unordered_map<std::string, Category>{{"a0", cat0}, {"a1", cat1}};
+  AlternativesPerformance alt_perf = AlternativesPerformance(
+      perf_table, std::move(map), PerformanceTable::Trusted());
+
+  EXPECT_EQ(alt_perf.getPerformanceTable(), perf_table.getPerformanceTable());
+  EXPECT_EQ(alt_perf.getAlternativeAssignment("a0").category_id_, "cat0");
+  EXPECT_EQ(alt_perf.getAlternativeAssignment("a1").category_id_, "cat1");
+}
+
+TEST(TestAlternativesPerformance, TestConstructorLargeDataset) {
+  // the validation is linear in the number of alternatives
+  int n_alt = 50000;
+  Criteria crit = Criteria(2, "crit");
+  Category cat0 = Category("cat0", 0);
+  std::vector<std::vector<Perf>> perf_vect;
+  std::unordered_map<std::string, Category> map;
+  for (int i = 0; i < n_alt; i++) {
+    std::string name = "a" + std::to_string(i);
+    perf_vect.push_back(createVectorPerfWithNoPerf(name, crit));
+    map[name] = cat0;
+  }
+  AlternativesPerformance alt_perf = AlternativesPerformance(perf_vect, map);
+  EXPECT_EQ(alt_perf.getNumberAlt(), n_alt);
+
+  map["a" + std::to_string(n_alt)] = cat0;
+  EXPECT_THROW(alt_perf.setAlternativesAssignments(map),
+               std::invalid_argument);
+  perf_vect.push_back(createVectorPerfWithNoPerf("a0", crit));
+  EXPECT_THROW(AlternativesPerformance(perf_vect, map), std::invalid_argument);
+}
+
 TEST(TestAlternativesPerformance, TestCopyConstructor) {
   std::vector<std::vector<Perf>> perf_vect;
   Criteria crit = Criteria(2, "crit");
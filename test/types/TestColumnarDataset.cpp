@@ -0,0 +1,122 @@
+#include "../../include/learning/AssignmentKernel.h"
+#include "../../include/types/AlternativesPerformance.h"
+#include "../../include/types/ColumnarDataset.h"
+#include "../../include/types/MRSortModel.h"
+#include "gtest/gtest.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// random dataset assigned by a random model, saved as a columnar file
+AlternativesPerformance writeColumnarDataset(const std::string &file_name,
+                                             int n_alt, int n_crit,
+                                             int n_cat) {
+  MRSortModel model = MRSortModel(n_cat, n_crit);
+  model.profiles.changeMode("alt");
+  Criteria crits = Criteria(n_crit, "crit");
+  PerformanceTable pt = PerformanceTable(n_alt, crits);
+  pt.generateRandomPerfValues(n_alt + n_crit);
+  std::unordered_map<std::string, Category> assignments =
+      model.categoryAssignments(pt).getAlternativesAssignments();
+  AlternativesPerformance ap = AlternativesPerformance(pt, assignments);
+  ColumnarDataset::write(ap, file_name);
+  return ap;
+}
+
+TEST(TestColumnarDataset, TestWriteRead) {
+  std::string file_name = "../data/tests/test_columnar_rw.columns";
+  AlternativesPerformance ap = writeColumnarDataset(file_name, 50, 6, 3);
+  ColumnarDataset columns = ColumnarDataset(file_name);
+  EXPECT_EQ(columns.getNumberAlt(), 50);
+  EXPECT_EQ(columns.getNumberCrit(), 6);
+  EXPECT_EQ(columns.getCriteriaIds()[0], "crit0");
+
+  std::vector<std::vector<Perf>> pt = ap.getPerformanceTable();
+  std::unordered_map<std::string, Category> assignments =
+      ap.getAlternativesAssignments();
+  for (int a = 0; a < 50; a++) {
+    EXPECT_EQ(columns.getAltName(a), pt[a][0].name_);
+    EXPECT_EQ(columns.getRanks()[a], assignments[pt[a][0].name_].rank_);
+    for (int j = 0; j < 6; j++) {
+      EXPECT_FLOAT_EQ(columns.getColumn(j)[a], pt[a][j].value_);
+    }
+  }
+  // the columns are aligned on 64 bytes
+  for (int j = 0; j < 6; j++) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(columns.getColumn(j)) % 64, 0);
+  }
+  std::remove(file_name.c_str());
+}
+
+TEST(TestColumnarDataset, TestSampleMaterialize) {
+  std::string file_name = "../data/tests/test_columnar_sample.columns";
+  AlternativesPerformance ap = writeColumnarDataset(file_name, 200, 4, 2);
+  ColumnarDataset columns = ColumnarDataset(file_name);
+
+  std::vector<std::int64_t> alts = columns.sample(30, 7);
+  EXPECT_EQ(alts.size(), 30);
+  EXPECT_TRUE(std::is_sorted(alts.begin(), alts.end()));
+  EXPECT_EQ(std::adjacent_find(alts.begin(), alts.end()), alts.end());
+  EXPECT_EQ(columns.sample(30, 7), alts);
+  EXPECT_EQ(columns.sample(500, 7).size(), 200);
+
+  AlternativesPerformance sample = columns.materialize(alts);
+  std::unordered_map<std::string, Category> assignments =
+      ap.getAlternativesAssignments();
+  std::unordered_map<std::string, Category> sample_assignments =
+      sample.getAlternativesAssignments();
+  EXPECT_EQ(sample.getNumberAlt(), 30);
+  for (std::int64_t alt : alts) {
+    std::string name = columns.getAltName(alt);
+    EXPECT_EQ(sample.getPerf(name, "crit2").value_,
+              columns.getColumn(2)[alt]);
+    EXPECT_EQ(sample_assignments[name].rank_, assignments[name].rank_);
+    EXPECT_EQ(sample_assignments[name].category_id_,
+              assignments[name].category_id_);
+  }
+  EXPECT_THROW(columns.materialize(std::vector<std::int64_t>{200}),
+               std::invalid_argument);
+  std::remove(file_name.c_str());
+}
+
+TEST(TestColumnarDataset, TestComputeAccuracy) {
+  std::string file_name = "../data/tests/test_columnar_accuracy.columns";
+  AlternativesPerformance ap = writeColumnarDataset(file_name, 300, 5, 4);
+  ColumnarDataset columns = ColumnarDataset(file_name);
+
+  MRSortModel model = MRSortModel(4, 5);
+  model.profiles.changeMode("alt");
+  AssignmentKernel kernel = AssignmentKernel(ap);
+  // blocks smaller than the dataset, not dividing it
+  EXPECT_FLOAT_EQ(columns.computeAccuracy(model, 64),
+                  kernel.computeAccuracy(model));
+  EXPECT_FLOAT_EQ(columns.computeAccuracy(model),
+                  kernel.computeAccuracy(model));
+
+  MRSortModel other_model = MRSortModel(4, 6);
+  other_model.profiles.changeMode("alt");
+  EXPECT_THROW(columns.computeAccuracy(other_model), std::invalid_argument);
+  std::remove(file_name.c_str());
+}
+
+TEST(TestColumnarDataset, TestInvalidFile) {
+  EXPECT_THROW(ColumnarDataset("../data/tests/no_such_file.columns"),
+               std::runtime_error);
+
+  std::string file_name = "../data/tests/test_columnar_invalid.columns";
+  std::ofstream(file_name) << "not a columnar dataset";
+  EXPECT_THROW(ColumnarDataset columns(file_name), std::invalid_argument);
+
+  // truncated file
+  writeColumnarDataset(file_name, 20, 4, 2);
+  std::ifstream in(file_name, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+  in.close();
+  std::ofstream(file_name, std::ios::binary)
+      << content.substr(0, content.size() - 10);
+  EXPECT_THROW(ColumnarDataset columns(file_name), std::invalid_argument);
+  std::remove(file_name.c_str());
+}
@@ -194,4 +194,30 @@ TEST(TestCriteria, TestRandomWeights) {
   std::ostringstream os;
   os << w;
   EXPECT_EQ(os.str(), "[0.333333,0.333333,0.333333]");
-}
\ No newline at end of file
+}
+TEST(TestCriteria, TestGetIndexAndWeight) {
+  std::vector<Criterion> crit_vect;
+  crit_vect.push_back(Criterion("a", 1, 0.2));
+  crit_vect.push_back(Criterion("b", 1, 0.8));
+  Criteria criteria1 = Criteria(crit_vect);
+  EXPECT_EQ(criteria1.getIndex("a"), 0);
+  EXPECT_EQ(criteria1.getIndex("b"), 1);
+  EXPECT_FLOAT_EQ(criteria1.getWeight("b"), 0.8);
+  EXPECT_THROW(criteria1.getIndex("c"), std::invalid_argument);
+  EXPECT_THROW(criteria1["c"], std::invalid_argument);
+
+  // the weights stay in sync with the criteria
+  std::vector<float> w{0.6, 0.4};
+  criteria1.setWeights(w);
+  EXPECT_FLOAT_EQ(criteria1.getWeight("a"), 0.6);
+  EXPECT_FLOAT_EQ(criteria1["a"].getWeight(), 0.6);
+  Criteria criteria2 = Criteria(criteria1);
+  EXPECT_FLOAT_EQ(criteria2.getWeight("b"), 0.4);
+
+  std::vector<Criterion> crit_vect2;
+  crit_vect2.push_back(Criterion("c", 1, 1));
+  criteria1.setCriterionVect(crit_vect2);
+  EXPECT_EQ(criteria1.getWeights(), std::vector<float>{1});
+  EXPECT_EQ(criteria1.getIndex("c"), 0);
+  EXPECT_THROW(criteria1.getIndex("a"), std::invalid_argument);
+}
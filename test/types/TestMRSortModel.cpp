@@ -113,6 +113,14 @@ TEST(TestMRSortModel, TestConcordance) {
   EXPECT_FLOAT_EQ(c_alt0_b0, 0.3);
   EXPECT_FLOAT_EQ(c_alt1_b2, 0.3);
 
+  // the weights are read by index when aligned, by id otherwise
+  EXPECT_TRUE(mrsort.isAligned(b0));
+  EXPECT_TRUE(mrsort.isAligned(profile.getPerformanceTable(), pt_));
+  EXPECT_FLOAT_EQ(mrsort.computeConcordance(b0, a0, true), 0.3);
+  std::vector<Perf> a0_reversed(a0.rbegin(), a0.rend());
+  EXPECT_FALSE(mrsort.isAligned(a0_reversed));
+  EXPECT_FLOAT_EQ(mrsort.computeConcordance(b0, a0_reversed), 0.3);
+
   // TEST COMPUTE CONCORDANCE TABLE
   std::unordered_map<std::string, std::unordered_map<std::string, float>> ct =
       mrsort.computeConcordanceTable(pt_);
@@ -92,6 +92,15 @@ TEST(TestPerformanceTable, TestConstructorWithPerfVectErrors) {
   } catch (...) {
     FAIL() << "should have throw invalid argument.";
   }
+
+  std::vector<std::vector<Perf>> crit_vect_err;
+  crit_vect_err.push_back({Perf("a0", "c0", 0), Perf("a1", "c0", 0)});
+  crit_vect_err.push_back({Perf("a0", "c0", 0), Perf("a1", "c0", 0)});
+  EXPECT_THROW(PerformanceTable(crit_vect_err, "crit"), std::invalid_argument);
+  crit_vect_err[1] = {Perf("a1", "c1", 0), Perf("a0", "c1", 0)};
+  EXPECT_THROW(PerformanceTable(crit_vect_err, "crit"), std::invalid_argument);
+  crit_vect_err[1] = {Perf("a0", "c1", 0), Perf("a1", "c1", 0)};
+  EXPECT_EQ(PerformanceTable(crit_vect_err, "crit").getNumberCrit(), 2);
 }
 
 TEST(TestPerformanceTable, TestConstructorByCopy) {
@@ -362,6 +371,15 @@ TEST(TestPerformanceTable, TestisAltInTable) {
 
   EXPECT_TRUE(perf_table.isAltInTable("a0"));
   EXPECT_FALSE(perf_table.isAltInTable("test8"));
+
+  // a0 is the first perf of no row once sorted in crit mode
+  std::vector<float> given_perf2 = {0.1, 0.1};
+  perf_vect.push_back(createVectorPerf("a2", crit, given_perf2));
+  PerformanceTable crit_table = PerformanceTable(perf_vect);
+  crit_table.sort("crit");
+  EXPECT_TRUE(crit_table.isAltInTable("a0"));
+  EXPECT_TRUE(crit_table.isAltInTable("a1"));
+  EXPECT_FALSE(crit_table.isAltInTable("test8"));
 }
 
 TEST(TestPerformanceTable, TestNumbers) {